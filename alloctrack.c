@@ -0,0 +1,199 @@
+// Sem ALLOC_TRACK este arquivo fica vazio (o header tem as versões nulas)
+#ifdef ALLOC_TRACK
+#define _GNU_SOURCE
+#include "alloctrack.h"
+#include "raylib.h"
+#include <dlfcn.h>
+#include <execinfo.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stddef.h>
+
+#define ALLOC_MAX_SITES 64          // Pilhas distintas guardadas depois do aquecimento
+#define ALLOC_SITE_DEPTH 6          // Quadros por pilha (sem o próprio malloc)
+#define ALLOC_REPORT_FRAMES 4       // Quadros mostrados por pilha no relatório
+#define ALLOC_SKIP_FRAMES 3         // RecordSite, Track e o malloc/calloc/realloc
+
+// O alocador de verdade da glibc: malloc e companhia abaixo substituem os
+// dela no executável, então toda biblioteca do processo chama os nossos
+extern void *__libc_malloc(size_t size);
+extern void *__libc_calloc(size_t count, size_t size);
+extern void *__libc_realloc(void *ptr, size_t size);
+extern void __libc_free(void *ptr);
+
+typedef struct {
+    void *stack[ALLOC_SITE_DEPTH];
+    int depth;
+    AllocPhase phase;
+    long count, bytes;
+} AllocSite;
+
+static const char *phaseNames[ALLOC_PHASE_COUNT] = { "fora do frame", "GameUpdate", "GameDraw", "HUDDraw", "GameUpdateAudio" };
+
+static _Thread_local AllocPhase currentPhase;
+static _Thread_local int insideTracker;     // backtrace também aloca na primeira vez
+static atomic_long phaseCount[ALLOC_PHASE_COUNT], phaseBytes[ALLOC_PHASE_COUNT];
+static atomic_int recording;                // 1 depois do aquecimento
+
+// Frames (só a thread principal mexe)
+static int warmup, frames, badFrames, firstBadFrame = -1;
+static long lastFrameTotal;
+
+static pthread_mutex_t siteLock = PTHREAD_MUTEX_INITIALIZER;
+static AllocSite sites[ALLOC_MAX_SITES];
+static int siteCount;
+static long sitesLost;                      // Pilhas novas com a tabela cheia
+
+// Soma a pilha da alocação na tabela (mesma pilha e fase = mesmo lugar).
+// noinline aqui e em Track: os quadros a pular são sempre os mesmos.
+__attribute__((noinline)) static void RecordSite(AllocPhase phase, size_t size) {
+    void *raw[ALLOC_SITE_DEPTH + ALLOC_SKIP_FRAMES];
+    insideTracker = 1;
+    int depth = backtrace(raw, ALLOC_SITE_DEPTH + ALLOC_SKIP_FRAMES) - ALLOC_SKIP_FRAMES;
+    insideTracker = 0;
+    if (depth < 0) depth = 0;
+    void **stack = raw + ALLOC_SKIP_FRAMES;
+
+    pthread_mutex_lock(&siteLock);
+    AllocSite *site = NULL;
+    for (int i = 0; i < siteCount && !site; i++) {
+        AllocSite *s = &sites[i];
+        if (s->phase != phase || s->depth != depth) continue;
+        int same = 1;
+        for (int k = 0; k < depth && same; k++) same = s->stack[k] == stack[k];
+        if (same) site = s;
+    }
+    if (!site && siteCount < ALLOC_MAX_SITES) {
+        site = &sites[siteCount++];
+        site->phase = phase;
+        site->depth = depth;
+        for (int k = 0; k < depth; k++) site->stack[k] = stack[k];
+    }
+    if (site) {
+        site->count++;
+        site->bytes += (long)size;
+    } else {
+        sitesLost++;
+    }
+    pthread_mutex_unlock(&siteLock);
+}
+
+__attribute__((noinline)) static void Track(size_t size) {
+    AllocPhase phase = currentPhase;
+    atomic_fetch_add_explicit(&phaseCount[phase], 1, memory_order_relaxed);
+    atomic_fetch_add_explicit(&phaseBytes[phase], (long)size, memory_order_relaxed);
+    if (phase != ALLOC_PHASE_NONE && !insideTracker && atomic_load_explicit(&recording, memory_order_relaxed)) {
+        RecordSite(phase, size);
+    }
+}
+
+void *malloc(size_t size) {
+    Track(size);
+    return __libc_malloc(size);
+}
+
+void *calloc(size_t count, size_t size) {
+    Track(count * size);
+    return __libc_calloc(count, size);
+}
+
+void *realloc(void *ptr, size_t size) {
+    if (size > 0) Track(size);
+    return __libc_realloc(ptr, size);
+}
+
+void free(void *ptr) {
+    __libc_free(ptr);
+}
+
+AllocPhase AllocTrackEnter(AllocPhase phase) {
+    AllocPhase previous = currentPhase;
+    currentPhase = phase;
+    return previous;
+}
+
+void AllocTrackLeave(AllocPhase previous) {
+    currentPhase = previous;
+}
+
+static long FrameTotal(void) {
+    long total = 0;
+    for (int i = ALLOC_PHASE_NONE + 1; i < ALLOC_PHASE_COUNT; i++) total += atomic_load(&phaseCount[i]);
+    return total;
+}
+
+void AllocTrackArm(int warmupFrames) {
+    // A primeira chamada de backtrace carrega a libgcc: que seja agora
+    void *probe[2];
+    insideTracker = 1;
+    backtrace(probe, 2);
+    insideTracker = 0;
+
+    for (int i = 0; i < ALLOC_PHASE_COUNT; i++) {
+        atomic_store(&phaseCount[i], 0);
+        atomic_store(&phaseBytes[i], 0);
+    }
+    atomic_store(&recording, 0);
+    warmup = warmupFrames;
+    frames = badFrames = 0;
+    firstBadFrame = -1;
+    lastFrameTotal = 0;
+    pthread_mutex_lock(&siteLock);
+    siteCount = 0;
+    sitesLost = 0;
+    pthread_mutex_unlock(&siteLock);
+}
+
+void AllocTrackFrameEnd(void) {
+    long total = FrameTotal();
+    if (frames >= warmup && total != lastFrameTotal) {
+        if (firstBadFrame < 0) firstBadFrame = frames;
+        badFrames++;
+    }
+    lastFrameTotal = total;
+    if (++frames == warmup) atomic_store(&recording, 1);
+}
+
+void AllocTrackGet(AllocCounter out[ALLOC_PHASE_COUNT]) {
+    for (int i = 0; i < ALLOC_PHASE_COUNT; i++) {
+        out[i] = (AllocCounter){ atomic_load(&phaseCount[i]), atomic_load(&phaseBytes[i]) };
+    }
+}
+
+// "função+0xdesvio" (precisa de -rdynamic; funções static saem com o nome
+// do símbolo exportado mais próximo)
+static const char *SymbolName(void *address) {
+    Dl_info info;
+    if (dladdr(address, &info) && info.dli_sname) {
+        return TextFormat("%s+0x%lx", info.dli_sname, (unsigned long)((char *)address - (char *)info.dli_saddr));
+    }
+    return TextFormat("%p", address);
+}
+
+int AllocTrackReport(void) {
+    AllocCounter counters[ALLOC_PHASE_COUNT];
+    AllocTrackGet(counters);
+    for (int i = 0; i < ALLOC_PHASE_COUNT; i++) {
+        TraceLog(LOG_INFO, "ALLOC: %-15s %8ld alocações %10ld bytes", phaseNames[i], counters[i].count, counters[i].bytes);
+    }
+    if (badFrames == 0) {
+        TraceLog(LOG_INFO, "ALLOC: nenhuma alocação nos %d frames depois do aquecimento (%d)",
+                 frames > warmup ? frames - warmup : 0, warmup);
+        return 0;
+    }
+
+    TraceLog(LOG_WARNING, "ALLOC: %d frames alocaram depois do aquecimento (o primeiro foi o %d)", badFrames, firstBadFrame);
+    pthread_mutex_lock(&siteLock);
+    for (int i = 0; i < siteCount; i++) {
+        const AllocSite *s = &sites[i];
+        TraceLog(LOG_WARNING, "ALLOC: %s: %ld alocações, %ld bytes", phaseNames[s->phase], s->count, s->bytes);
+        for (int k = 0; k < s->depth && k < ALLOC_REPORT_FRAMES; k++) {
+            // TextFormat usa buffers rotativos: um nome por linha
+            TraceLog(LOG_WARNING, "ALLOC:     %s %s", k == 0 ? "em" : "<-", SymbolName(s->stack[k]));
+        }
+    }
+    if (sitesLost > 0) TraceLog(LOG_WARNING, "ALLOC: %ld alocações sem lugar na tabela de pilhas", sitesLost);
+    pthread_mutex_unlock(&siteLock);
+    return badFrames;
+}
+#endif
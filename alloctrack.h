@@ -0,0 +1,48 @@
+#ifndef ALLOCTRACK_H
+#define ALLOCTRACK_H
+
+// Rastreio de alocações (make ALLOC_TRACK=1): malloc, calloc, realloc e free
+// do processo inteiro, raylib incluída, passam por alloctrack.c, que conta
+// chamadas e bytes por fase do frame. Cada thread marca a fase em que está;
+// o pipeline simula numa thread e desenha em outra sem se misturar.
+//
+// Depois do aquecimento, toda alocação dentro de uma fase do frame é uma
+// falha: guarda a pilha (a função da raylib que alocou e quem a chamou no
+// nosso código) para o relatório. Sem ALLOC_TRACK tudo aqui é vazio.
+typedef enum {
+    ALLOC_PHASE_NONE,       // Fora do frame (carregamento, outras threads)
+    ALLOC_PHASE_UPDATE,     // GameUpdate e o avanço em rede
+    ALLOC_PHASE_DRAW,       // GameDraw, sem o HUD
+    ALLOC_PHASE_HUD,        // HUDDraw
+    ALLOC_PHASE_AUDIO,      // GameUpdateAudio (bombear a música)
+    ALLOC_PHASE_COUNT
+} AllocPhase;
+
+#define ALLOC_WARMUP_FRAMES 120     // Frames livres antes de contar falhas (2 s)
+
+typedef struct {
+    long count;             // Chamadas de malloc/calloc/realloc
+    long bytes;             // Bytes pedidos
+} AllocCounter;
+
+#ifdef ALLOC_TRACK
+#define ALLOC_TRACK_ENABLED 1
+AllocPhase AllocTrackEnter(AllocPhase phase);  // Retorna a fase anterior da thread
+void AllocTrackLeave(AllocPhase previous);
+void AllocTrackArm(int warmupFrames);          // Zera os contadores e começa a contar frames
+void AllocTrackFrameEnd(void);                 // Uma vez por frame, na thread principal
+void AllocTrackGet(AllocCounter out[ALLOC_PHASE_COUNT]);
+int AllocTrackReport(void);                    // Loga o resumo; retorna os frames que alocaram
+#else
+#define ALLOC_TRACK_ENABLED 0
+static inline AllocPhase AllocTrackEnter(AllocPhase phase) { (void)phase; return ALLOC_PHASE_NONE; }
+static inline void AllocTrackLeave(AllocPhase previous) { (void)previous; }
+static inline void AllocTrackArm(int warmupFrames) { (void)warmupFrames; }
+static inline void AllocTrackFrameEnd(void) {}
+static inline void AllocTrackGet(AllocCounter out[ALLOC_PHASE_COUNT]) {
+    for (int i = 0; i < ALLOC_PHASE_COUNT; i++) out[i] = (AllocCounter){0};
+}
+static inline int AllocTrackReport(void) { return 0; }
+#endif
+
+#endif
@@ -1,193 +1,148 @@
 
 #include "attack.h"
 #include "player.h" // Para a definição completa de Player
+#include "pattern.h"
+#include "utils.h"
+#include "quality.h"
+#include "telemetry.h"
 #include "raylib.h"
 #include <stdlib.h>
+#include <string.h>
 #include <math.h>
 
+// Kernels de desenho de cada fluxo (um por tipo, sem desvios por projétil)
+static void DrawBonesH(const Vector2 *pos, int count);
+static void DrawBonesV(const Vector2 *pos, int count);
+static void DrawMagenta(const Vector2 *pos, int count);
+static void DrawYellow(const Vector2 *pos, int count);
+static void DrawAimed(const Vector2 *pos, int count);
+static void DrawHoming(const Vector2 *pos, int count);
+static void DrawLock(const Vector2 *pos, int count);
+static void DrawOrbs(const Vector2 *pos, int count);
+
+#define AIMED_SPEED SIM(2.4)
+#define HOMING_TICKS 150                // Ticks perseguindo o coração antes de seguir reto
+#define HOMING_TURN_COS SIM(0.99863)    // Giro máximo por tick: 3 graus
+#define HOMING_TURN_SIN SIM(0.05234)
+#define LOCK_DELAY 45                   // Ticks freando antes de travar a mira
+#define LOCK_DRAG SIM(0.93)
+#define LOCK_SPEED SIM(4.5)
+// Fase da onda de esperança: frameCount / 20 radianos, dando a volta a cada
+// 14200 frames (710 rad, a 6e-5 rad de 113 voltas) para caber em Q16.16
+#define HOPE_WAVE_PERIOD 14200
+
+#define ATTACK_TYPE_INFO(name, w, h, dmg, ox, oy, draw) [name] = { w, h, dmg, { ox, oy } },
+const AttackTypeInfo attackTypeInfo[ATK_COUNT] = { ATTACK_TYPE_LIST(ATTACK_TYPE_INFO) };
+#undef ATTACK_TYPE_INFO
+
+#define ATTACK_TYPE_DRAW(name, w, h, dmg, ox, oy, draw) [name] = draw,
+static void (*const drawKernels[ATK_COUNT])(const Vector2 *pos, int count) = { ATTACK_TYPE_LIST(ATTACK_TYPE_DRAW) };
+#undef ATTACK_TYPE_DRAW
+
+// Sorteio em [0, n) com o gerador da própria partida
+static int AttackRand(AttackManager *am, int n) {
+    return (int)(RandNext(&am->rngState) % (unsigned int)n);
+}
 
 void AttackManagerInit(AttackManager *am, Rectangle battleBox) {
-    // Inicializar projéteis
-    for (int i = 0; i < MAX_PROJECTILES; i++) am->projectiles[i].active = 0;
+    // Inicializar projéteis (todos os fluxos vazios)
+    for (int t = 0; t <= ATK_COUNT; t++) am->streamStart[t] = 0;
+    am->projectileCap = LEVEL_PROJECTILE_CAP;
     
-    // Inicializar plataformas
-    for (int i = 0; i < MAX_PLATFORMS; i++) am->platforms[i].active = false;
-    am->platformCount = 0;
-    
-    // Inicializar obstáculos
-    for (int i = 0; i < MAX_OBSTACLES; i++) am->obstacles[i].active = false;
-    am->obstacleCount = 0;
+    // Inicializar plataformas e obstáculos
+    EntityStoreInit(&am->entities);
     
     // Usar o parâmetro battleBox para evitar warning
     (void)battleBox; // Suprimir warning de parâmetro não utilizado
     
     am->spawnRate = 45;
     am->spawnTimer = 0;
+    am->rngState = RAND_DEFAULT_SEED;
     am->currentType = ATK_BONE_H;
     am->phase = 1;
 }
 
-// Função para criar uma plataforma
-void SpawnPlatform(AttackManager *am, Rectangle rect, PlatformType type, Vector2 velocity, int lifetime, float bounceForce) {
-    if (am->platformCount >= MAX_PLATFORMS) return;
-    
-    for (int i = 0; i < MAX_PLATFORMS; i++) {
-        if (!am->platforms[i].active) {
-            am->platforms[i].rect = rect;
-            am->platforms[i].type = type;
-            am->platforms[i].velocity = velocity;
-            am->platforms[i].lifetime = lifetime;
-            am->platforms[i].bounceForce = bounceForce;
-            am->platforms[i].active = true;
-            am->platformCount++;
-            return;
-        }
-    }
+// Função para criar uma plataforma (devolve o id da entidade ou -1)
+int SpawnPlatform(AttackManager *am, Rectangle rect, PlatformType type, Vector2 velocity, int lifetime, float bounceForce) {
+    EntityDesc desc = { COMP_PLATFORM, type, rect, velocity, lifetime, 0, 0, bounceForce };
+    if (type == PLATFORM_MOVING) desc.mask |= COMP_VELOCITY;
+    if (type == PLATFORM_TEMPORARY) desc.mask |= COMP_LIFETIME;
+    return EntitySpawn(&am->entities, &desc);
 }
 
-// Função para criar um obstáculo
-void SpawnObstacle(AttackManager *am, Rectangle rect, ObstacleType type, Vector2 velocity, int damage, int pulseTime) {
-    if (am->obstacleCount >= MAX_OBSTACLES) return;
-    
-    for (int i = 0; i < MAX_OBSTACLES; i++) {
-        if (!am->obstacles[i].active) {
-            am->obstacles[i].rect = rect;
-            am->obstacles[i].type = type;
-            am->obstacles[i].velocity = velocity;
-            am->obstacles[i].damage = damage;
-            am->obstacles[i].pulseTime = pulseTime;
-            am->obstacles[i].active = true;
-            am->obstacleCount++;
-            return;
-        }
-    }
-}
-
-// Função para atualizar plataformas
-void UpdatePlatforms(AttackManager *am, Rectangle battleBox, float dt) {
-    for (int i = 0; i < MAX_PLATFORMS; i++) {
-        if (!am->platforms[i].active) continue;
-        
-        // Atualizar posição de plataformas móveis
-        if (am->platforms[i].type == PLATFORM_MOVING) {
-            am->platforms[i].rect.x += am->platforms[i].velocity.x * dt * 60.0f;
-            am->platforms[i].rect.y += am->platforms[i].velocity.y * dt * 60.0f;
-            
-            // Inverter direção se atingir os limites da caixa de batalha
-            if (am->platforms[i].rect.x < battleBox.x || 
-                am->platforms[i].rect.x + am->platforms[i].rect.width > battleBox.x + battleBox.width) {
-                am->platforms[i].velocity.x *= -1;
-            }
-            
-            if (am->platforms[i].rect.y < battleBox.y || 
-                am->platforms[i].rect.y + am->platforms[i].rect.height > battleBox.y + battleBox.height) {
-                am->platforms[i].velocity.y *= -1;
-            }
-        }
-        
-        // Atualizar tempo de vida de plataformas temporárias
-        if (am->platforms[i].type == PLATFORM_TEMPORARY) {
-            am->platforms[i].lifetime--;
-            if (am->platforms[i].lifetime <= 0) {
-                am->platforms[i].active = false;
-                am->platformCount--;
-            }
-        }
-    }
+// Função para criar um obstáculo (devolve o id da entidade ou -1)
+int SpawnObstacle(AttackManager *am, Rectangle rect, ObstacleType type, Vector2 velocity, int damage, int pulseTime) {
+    EntityDesc desc = { COMP_DAMAGE, type, rect, velocity, 0, pulseTime, damage, 0 };
+    if (type == OBSTACLE_MOVING) desc.mask |= COMP_VELOCITY;
+    if (type == OBSTACLE_PULSE) desc.mask |= COMP_PULSE;
+    return EntitySpawn(&am->entities, &desc);
 }
 
-// Função para atualizar obstáculos
-void UpdateObstacles(AttackManager *am, Rectangle battleBox, float dt) {
-    for (int i = 0; i < MAX_OBSTACLES; i++) {
-        if (!am->obstacles[i].active) continue;
-        
-        // Atualizar posição de obstáculos móveis
-        if (am->obstacles[i].type == OBSTACLE_MOVING) {
-            am->obstacles[i].rect.x += am->obstacles[i].velocity.x * dt * 60.0f;
-            am->obstacles[i].rect.y += am->obstacles[i].velocity.y * dt * 60.0f;
-            
-            // Inverter direção se atingir os limites da caixa de batalha
-            if (am->obstacles[i].rect.x < battleBox.x || 
-                am->obstacles[i].rect.x + am->obstacles[i].rect.width > battleBox.x + battleBox.width) {
-                am->obstacles[i].velocity.x *= -1;
-            }
-            
-            if (am->obstacles[i].rect.y < battleBox.y || 
-                am->obstacles[i].rect.y + am->obstacles[i].rect.height > battleBox.y + battleBox.height) {
-                am->obstacles[i].velocity.y *= -1;
-            }
-        }
-        
-        // Atualizar obstáculos pulsantes
-        if (am->obstacles[i].type == OBSTACLE_PULSE) {
-            am->obstacles[i].pulseTime--;
-            if (am->obstacles[i].pulseTime <= 0) {
-                // Alternar entre ativo e inativo
-                am->obstacles[i].active = !am->obstacles[i].active;
-                am->obstacles[i].pulseTime = 60; // Reset para 1 segundo
-            }
-        }
-    }
+// Função para criar um feixe de laser (devolve o id da entidade ou -1):
+// gira spin radianos por tick em torno do pivô, que anda com sweep, e só
+// fere depois de warmup ticks de aviso
+int SpawnLaser(AttackManager *am, const BeamDesc *beam, Vector2 sweep, int damage, int lifetime) {
+    EntityDesc desc = { COMP_DAMAGE | COMP_BEAM | COMP_LIFETIME, OBSTACLE_LASER, {0, 0, 0, 0}, sweep, lifetime, 0, damage, 0 };
+    return EntitySpawnBeam(&am->entities, &desc, beam);
 }
 
 // Função para verificar colisão do jogador com plataformas
+// player->currentPlatform guarda o id estável da entidade
 int CheckPlatformCollision(const AttackManager *am, Player *player) {
     if (player->moveType != MOVE_PLATFORMS) return -1;
     
-    for (int i = 0; i < MAX_PLATFORMS; i++) {
-        if (!am->platforms[i].active) continue;
-        
-        Rectangle playerRect = {
-            player->pos.x - player->size/2,
-            player->pos.y - player->size/2,
-            player->size,
-            player->size
-        };
+    const EntityStore *es = &am->entities;
+    SimRect playerRect = {
+        player->pos.x - player->size/2,
+        player->pos.y - player->size/2,
+        player->size,
+        player->size
+    };
+    
+    // Verificar se o jogador está caindo (velocidade positiva)
+    if (player->velocityY > 0) {
+        // Verificar se a parte inferior do jogador está tocando a parte superior da plataforma
+        sim_t playerBottom = playerRect.y + playerRect.height;
         
-        // Verificar se o jogador está caindo (velocidade positiva)
-        if (player->velocityY > 0) {
-            // Verificar se a parte inferior do jogador está tocando a parte superior da plataforma
-            float playerBottom = playerRect.y + playerRect.height;
-            float platformTop = am->platforms[i].rect.y;
+        for (int i = 0; i < es->count; i++) {
+            if (!(es->mask[i] & COMP_PLATFORM) || !EntityIsSolid(es, i)) continue;
+            
+            SimRect rect = es->rect[i];
             
             // Se o jogador estiver próximo o suficiente da plataforma
-            if (fabs(playerBottom - platformTop) < 10) {
+            if (SimAbs(playerBottom - rect.y) < SIM(10)) {
                 // Verificar se há sobreposição horizontal
-                if (playerRect.x + playerRect.width > am->platforms[i].rect.x && 
-                    playerRect.x < am->platforms[i].rect.x + am->platforms[i].rect.width) {
+                if (playerRect.x + playerRect.width > rect.x && 
+                    playerRect.x < rect.x + rect.width) {
                     
                     // Colocar o jogador em cima da plataforma
-                    player->pos.y = platformTop - player->size/2;
+                    player->pos.y = rect.y - player->size/2;
                     player->velocityY = 0;
                     player->isGrounded = true;
                     player->isJumping = false;
-                    player->currentPlatform = i;
+                    player->currentPlatform = es->id[i];
                     
                     // Efeito especial para plataforma de salto
-                    if (am->platforms[i].type == PLATFORM_BOUNCE) {
-                        player->velocityY = -am->platforms[i].bounceForce;
+                    if (es->look[i] == PLATFORM_BOUNCE) {
+                        player->velocityY = -es->bounceForce[i];
                         player->isGrounded = false;
                         player->isJumping = true;
                     }
                     
-                    return i; // Retorna o índice da plataforma
+                    return es->id[i]; // Retorna o id da plataforma
                 }
             }
         }
     }
     
     // Se o jogador estiver em uma plataforma, verificar se ainda está nela
-    if (player->currentPlatform >= 0 && player->currentPlatform < MAX_PLATFORMS) {
-        Rectangle playerRect = {
-            player->pos.x - player->size/2,
-            player->pos.y - player->size/2,
-            player->size,
-            player->size
-        };
+    if (player->currentPlatform >= 0 && player->currentPlatform < MAX_ENTITIES) {
+        int i = es->indexOf[player->currentPlatform];
         
-        // Verificar se o jogador ainda está na plataforma horizontalmente
-        if (playerRect.x + playerRect.width <= am->platforms[player->currentPlatform].rect.x || 
-            playerRect.x >= am->platforms[player->currentPlatform].rect.x + am->platforms[player->currentPlatform].rect.width) {
+        // A plataforma pode ter sumido (temporária) ou estar desligada (pulsante)
+        if (i < 0 || !EntityIsSolid(es, i) ||
+            playerRect.x + playerRect.width <= es->rect[i].x || 
+            playerRect.x >= es->rect[i].x + es->rect[i].width) {
             player->isGrounded = false;
             player->currentPlatform = -1;
         }
@@ -196,91 +151,137 @@ int CheckPlatformCollision(const AttackManager *am, Player *player) {
     return -1; // Nenhuma colisão
 }
 
-// Função para verificar colisão do jogador com obstáculos
-int CheckObstacleCollision(const AttackManager *am, const Rectangle *playerHitbox) {
-    for (int i = 0; i < MAX_OBSTACLES; i++) {
-        if (!am->obstacles[i].active) continue;
-        
-        // Verificar colisão com a hitbox do jogador
-        if (CheckCollisionRecs(*playerHitbox, am->obstacles[i].rect)) {
-            // Retornar o dano causado pelo obstáculo
-            return am->obstacles[i].damage;
-        }
+// Insere um lote de projéteis no fim do fluxo do tipo. Cada fluxo seguinte
+// desloca no máximo "count" elementos do seu início para o seu fim, abrindo
+// espaço sem embaralhar os demais; o lote entra com uma única cópia.
+void SpawnProjectiles(AttackManager *am, const Projectile *src, int count, AttackType type) {
+    int room = am->projectileCap - am->streamStart[ATK_COUNT];
+    if (count > room) {
+        TelemetryEmit(TELEMETRY_SPAWN_DROPPED, type, 0, 0, am->projectileCap, count - (room > 0 ? room : 0));
+        count = room;
+    }
+    if (count <= 0) return;
+    
+    for (int t = ATK_COUNT - 1; t > (int)type; t--) {
+        int size = am->streamStart[t + 1] - am->streamStart[t];
+        int moved = size < count ? size : count;
+        memmove(&am->projectiles[am->streamStart[t + 1] + count - moved],
+                &am->projectiles[am->streamStart[t]], moved * sizeof(Projectile));
     }
-    return 0; // Sem colisão
+    memcpy(&am->projectiles[am->streamStart[type + 1]], src, count * sizeof(Projectile));
+    for (int t = type + 1; t <= ATK_COUNT; t++) am->streamStart[t] += count;
+}
+
+// Esvazia todos os fluxos de uma vez (troca de fase do chefe, vitória)
+void AttackManagerClearProjectiles(AttackManager *am) {
+    for (int t = 0; t <= ATK_COUNT; t++) am->streamStart[t] = 0;
 }
 
 // Função auxiliar para criar projéteis
+// (posição e velocidade em float viram escalar da simulação aqui)
 void SpawnProjectile(AttackManager *am, Vector2 pos, Vector2 vel, AttackType type) {
-    for (int i = 0; i < MAX_PROJECTILES; i++) {
-        if (!am->projectiles[i].active) {
-            am->projectiles[i].active = 1;
-            am->projectiles[i].pos = pos;
-            am->projectiles[i].vel = vel;
-            am->projectiles[i].type = type;
-            
-            // Configurar tamanho e dano com base no tipo
-            switch (type) {
-                case ATK_BONE_H:
-                    am->projectiles[i].width = 40;
-                    am->projectiles[i].height = 6;
-                    am->projectiles[i].damage = 10;
-                    break;
-                    
-                case ATK_BONE_V:
-                    am->projectiles[i].width = 6;
-                    am->projectiles[i].height = 40;
-                    am->projectiles[i].damage = 10;
-                    break;
-                    
-                case ATK_MAGENTA:
-                    am->projectiles[i].width = 16;
-                    am->projectiles[i].height = 16;
-                    am->projectiles[i].damage = 12;
-                    break;
-                    
-                case ATK_YELLOW:
-                    am->projectiles[i].width = 20;
-                    am->projectiles[i].height = 6;
-                    am->projectiles[i].damage = 16;
-                    break;
-            }
-            
-            return; // Projétil criado com sucesso
-        }
+    Projectile p = { SimVec2FromVector2(pos), SimVec2FromVector2(vel), 0 };
+    SpawnProjectiles(am, &p, 1, type);
+}
+
+// Velocidade de módulo speed apontada de "from" para "to"
+static SimVec2 AimVelocity(SimVec2 from, SimVec2 to, sim_t speed) {
+    sim_t dx = to.x - from.x, dy = to.y - from.y;
+    sim_t length = SimLength(dx, dy);
+    if (length < SIM(1)) return (SimVec2){ 0, speed };   // Já em cima do alvo: cai reto
+    return (SimVec2){ SimDiv(SimMul(dx, speed), length), SimDiv(SimMul(dy, speed), length) };
+}
+
+// Projétil com comportamento próprio (mirado, teleguiado ou de trava)
+static void SpawnSteered(AttackManager *am, Vector2 pos, SimVec2 vel, AttackType type, int timer) {
+    Projectile p = { SimVec2FromVector2(pos), vel, timer };
+    SpawnProjectiles(am, &p, 1, type);
+}
+
+// Teleguiados: gira a velocidade HOMING_TURN para o lado do coração (sinal
+// do produto vetorial). Um laço só sobre o fluxo, sem desvios: quem já
+// parou de perseguir, ou está alinhado, gira com cos = 1 e sen = 0.
+static void SteerHoming(Projectile *p, int count, SimVec2 target) {
+    for (int i = 0; i < count; i++) {
+        sim_t dx = target.x - p[i].pos.x, dy = target.y - p[i].pos.y;
+        sim_t vx = p[i].vel.x, vy = p[i].vel.y;
+        sim_t cross = SimMul(vx, dy) - SimMul(vy, dx);
+        int active = p[i].timer > 0;
+        int side = ((cross > 0) - (cross < 0)) * active;
+        sim_t c = SIM(1) - side * side * (SIM(1) - HOMING_TURN_COS);
+        sim_t s = side * HOMING_TURN_SIN;
+        p[i].vel.x = SimMul(vx, c) - SimMul(vy, s);
+        p[i].vel.y = SimMul(vx, s) + SimMul(vy, c);
+        p[i].timer -= active;
+    }
+}
+
+// Trava: freia enquanto o timer corre; no tick em que zera, mira no
+// coração (o único desvio, uma vez por projétil)
+static void SteerLock(Projectile *p, int count, SimVec2 target) {
+    for (int i = 0; i < count; i++) {
+        int active = p[i].timer > 0;
+        sim_t drag = SIM(1) - active * (SIM(1) - LOCK_DRAG);
+        p[i].vel.x = SimMul(p[i].vel.x, drag);
+        p[i].vel.y = SimMul(p[i].vel.y, drag);
+        p[i].timer -= active;
+        if (active && p[i].timer == 0) p[i].vel = AimVelocity(p[i].pos, target, LOCK_SPEED);
+    }
+}
+
+// Remove o projétil de índice i do fluxo do tipo (troca com o último do fluxo)
+static void RemoveProjectile(AttackManager *am, int i, AttackType type) {
+    am->projectiles[i] = am->projectiles[am->streamStart[type + 1] - 1];
+    for (int t = type + 1; t < ATK_COUNT; t++) {
+        am->projectiles[am->streamStart[t] - 1] = am->projectiles[am->streamStart[t + 1] - 1];
     }
+    for (int t = type + 1; t <= ATK_COUNT; t++) am->streamStart[t]--;
 }
 
-void AttackManagerUpdate(AttackManager *am, Rectangle battleBox, int frameCount, GameLevel currentLevel, PlayerMoveType playerMoveType) {
+void AttackManagerUpdate(AttackManager *am, Rectangle battleBox, int frameCount, GameLevel currentLevel, PlayerMoveType playerMoveType, SimVec2 target) {
     // Sistema de dificuldade progressiva baseada no nível
-    float difficultyMultiplier = 1.0f + (currentLevel * 0.2f) + (frameCount / 1000.0f);
-    float dt = GetFrameTime();
+    sim_t difficultyMultiplier = SIM(1) + currentLevel * SIM(0.2) + SimFromRatio(frameCount, 1000);
     
-    // Atualizar projéteis existentes
-    for (int i = 0; i < MAX_PROJECTILES; i++) {
-        if (am->projectiles[i].active) {
-            // Mover o projétil
-            am->projectiles[i].pos.x += am->projectiles[i].vel.x;
-            am->projectiles[i].pos.y += am->projectiles[i].vel.y;
-            
-            // Verificar se saiu da tela
-            if (am->projectiles[i].pos.x < -50 || 
-                am->projectiles[i].pos.x > GetScreenWidth() + 50 ||
-                am->projectiles[i].pos.y < -50 ||
-                am->projectiles[i].pos.y > GetScreenHeight() + 50) {
-                am->projectiles[i].active = 0;
+    // Direção dos fluxos que reagem ao coração (só eles, antes do movimento comum)
+    SteerHoming(&am->projectiles[am->streamStart[ATK_HOMING]], am->streamStart[ATK_HOMING + 1] - am->streamStart[ATK_HOMING], target);
+    SteerLock(&am->projectiles[am->streamStart[ATK_LOCK]], am->streamStart[ATK_LOCK + 1] - am->streamStart[ATK_LOCK], target);
+    
+    // Mover os projéteis: o pool é denso, então é um único laço sem desvios
+    int total = am->streamStart[ATK_COUNT];
+    for (int i = 0; i < total; i++) {
+        am->projectiles[i].pos.x += am->projectiles[i].vel.x;
+        am->projectiles[i].pos.y += am->projectiles[i].vel.y;
+    }
+    
+    // Remover os que saíram da tela, fluxo por fluxo
+    sim_t minXY = SIM(-50);
+    sim_t maxX = SIM(GAME_WIDTH + 50);
+    sim_t maxY = SIM(GAME_HEIGHT + 50);
+    for (int t = 0; t < ATK_COUNT; t++) {
+        int i = am->streamStart[t];
+        while (i < am->streamStart[t + 1]) {
+            SimVec2 pos = am->projectiles[i].pos;
+            if (SimOutside(pos.x, minXY, maxX) | SimOutside(pos.y, minXY, maxY)) {
+                RemoveProjectile(am, i, t);
+            } else {
+                i++;
             }
         }
     }
     
     // Atualizar plataformas e obstáculos para os modos de jogo estilo Undertale
     if (playerMoveType == MOVE_PLATFORMER || playerMoveType == MOVE_PLATFORMS) {
-        UpdatePlatforms(am, battleBox, dt);
-        UpdateObstacles(am, battleBox, dt);
+        EntityMoveSystem(&am->entities, SimRectFromRectangle(battleBox));
     }
+    // Tempo de vida, pulso e aviso dos feixes correm em qualquer modo
+    // (os lasers aparecem também no movimento livre)
+    EntityTimerSystem(&am->entities);
+    EntityBeamSystem(&am->entities);
     
     // Determinar intervalo de spawn com base no nível
-    int spawnInterval = (int)(60 / difficultyMultiplier);
+    // (a rampa não para: com frameCount acima de 60000 o intervalo chegaria a 0)
+    int spawnInterval = SimToInt(SimDiv(SIM(60), difficultyMultiplier));
+    if (spawnInterval <= 0) spawnInterval = 1;
     
     // Gerar novos ataques com base no tempo e nível atual
     if (frameCount % spawnInterval == 0) {
@@ -300,8 +301,8 @@ void AttackManagerUpdate(AttackManager *am, Rectangle battleBox, int frameCount,
                     // Projéteis aleatórios
                     for (int i = 0; i < 2; i++) {
                         SpawnProjectile(am, 
-                                       (Vector2){rand() % (int)battleBox.width + battleBox.x, battleBox.y},
-                                       (Vector2){(rand() % 5 - 2) * 0.3f, 1.0f},
+                                       (Vector2){AttackRand(am, (int)battleBox.width) + battleBox.x, battleBox.y},
+                                       (Vector2){(AttackRand(am, 5) - 2) * 0.3f, 1.0f},
                                        ATK_MAGENTA);
                     }
                 }
@@ -311,19 +312,15 @@ void AttackManagerUpdate(AttackManager *am, Rectangle battleBox, int frameCount,
                 // Padrões de Memórias - fragmentos que se movem em padrões quebrados
                 if (frameCount % (spawnInterval * 2) == 0) {
                     // Padrão em zigzag
-                    for (int i = 0; i < 8; i++) {
-                        float xOffset = sinf(i * 0.5f) * 100;
-                        SpawnProjectile(am, 
-                                       (Vector2){battleBox.x + battleBox.width/2 + xOffset, battleBox.y},
-                                       (Vector2){sinf(i * 0.8f) * 1.5f, 1.5f},
-                                       ATK_MAGENTA);
-                    }
+                    PatternBurst(am, PATTERN_MEMORY_ZIGZAG,
+                                 (Vector2){battleBox.x + battleBox.width/2, battleBox.y},
+                                 (Vector2){1, 1}, 1.5f, 0);
                 } else {
                     // Fragmentos de memória (ossos)
                     for (int i = 0; i < 3; i++) {
                         SpawnProjectile(am, 
-                                       (Vector2){battleBox.x + (rand() % (int)battleBox.width), battleBox.y},
-                                       (Vector2){(rand() % 5 - 2) * 0.4f, 1.2f},
+                                       (Vector2){battleBox.x + AttackRand(am, (int)battleBox.width), battleBox.y},
+                                       (Vector2){(AttackRand(am, 5) - 2) * 0.4f, 1.2f},
                                        ATK_BONE_V);
                     }
                 }
@@ -333,12 +330,14 @@ void AttackManagerUpdate(AttackManager *am, Rectangle battleBox, int frameCount,
                 // Padrões de Arrependimento - ataques mais intensos e direcionados
                 if (frameCount % (spawnInterval * 4) == 0) {
                     // Espiral de arrependimentos
-                    for (int i = 0; i < 12; i++) {
-                        float angle = i * (2 * PI / 12);
-                        SpawnProjectile(am, 
-                                       (Vector2){battleBox.x + battleBox.width/2, battleBox.y + battleBox.height/2},
-                                       (Vector2){cosf(angle) * 2.0f, sinf(angle) * 2.0f},
-                                       ATK_BONE_H);
+                    PatternBurst(am, PATTERN_REGRET_SPIRAL,
+                                 (Vector2){battleBox.x + battleBox.width/2, battleBox.y + battleBox.height/2},
+                                 (Vector2){1, 1}, 2.0f, 0);
+                } else if (frameCount % (spawnInterval * 3) == 0) {
+                    // Olhares de reprovação: três disparos mirados no coração
+                    for (int i = 0; i < 3; i++) {
+                        Vector2 pos = {battleBox.x + AttackRand(am, (int)battleBox.width), battleBox.y};
+                        SpawnSteered(am, pos, AimVelocity(SimVec2FromVector2(pos), target, AIMED_SPEED), ATK_AIMED, 0);
                     }
                 } else if (frameCount % (spawnInterval * 2) == 0) {
                     // Palavras de culpa
@@ -352,8 +351,8 @@ void AttackManagerUpdate(AttackManager *am, Rectangle battleBox, int frameCount,
                     // Ossos aleatórios
                     for (int i = 0; i < 3; i++) {
                         SpawnProjectile(am, 
-                                       (Vector2){battleBox.x + (rand() % (int)battleBox.width), battleBox.y},
-                                       (Vector2){(rand() % 5 - 2) * 0.3f, 1.5f},
+                                       (Vector2){battleBox.x + AttackRand(am, (int)battleBox.width), battleBox.y},
+                                       (Vector2){(AttackRand(am, 5) - 2) * 0.3f, 1.5f},
                                        ATK_BONE_H);
                     }
                 }
@@ -365,9 +364,29 @@ void AttackManagerUpdate(AttackManager *am, Rectangle battleBox, int frameCount,
                     // Chuva de medos
                     for (int i = 0; i < 15; i++) {
                         SpawnProjectile(am, 
-                                       (Vector2){battleBox.x + (rand() % (int)battleBox.width), battleBox.y},
-                                       (Vector2){(rand() % 7 - 3) * 0.4f, 2.0f + (rand() % 3) * 0.5f},
-                                       rand() % 2 == 0 ? ATK_BONE_H : ATK_YELLOW);
+                                       (Vector2){battleBox.x + AttackRand(am, (int)battleBox.width), battleBox.y},
+                                       (Vector2){(AttackRand(am, 7) - 3) * 0.4f, 2.0f + AttackRand(am, 3) * 0.5f},
+                                       AttackRand(am, 2) == 0 ? ATK_BONE_H : ATK_YELLOW);
+                    }
+                } else if (frameCount % (spawnInterval * 5) == 0) {
+                    // Lasers: uma barra girando no centro da caixa ou um feixe
+                    // vertical varrendo de um lado ao outro
+                    if (AttackRand(am, 2) == 0) {
+                        BeamDesc beam = { {battleBox.x + battleBox.width/2, battleBox.y + battleBox.height/2},
+                                          AttackRand(am, 4) * PI / 4, AttackRand(am, 2) ? 0.012f : -0.012f,
+                                          -battleBox.width * 0.35f, battleBox.width * 0.7f, 3, 60 };
+                        SpawnLaser(am, &beam, (Vector2){0, 0}, 12, 300);
+                    } else {
+                        int fromLeft = AttackRand(am, 2);
+                        BeamDesc beam = { {fromLeft ? battleBox.x + 10 : battleBox.x + battleBox.width - 10, battleBox.y},
+                                          PI / 2, 0, 0, battleBox.height, 4, 45 };
+                        SpawnLaser(am, &beam, (Vector2){fromLeft ? 1.5f : -1.5f, 0}, 12, 45 + (int)((battleBox.width - 20) / 1.5f));
+                    }
+                } else if (frameCount % (spawnInterval * 4) == 0) {
+                    // Medos que perseguem: dois teleguiados saindo dos cantos de cima
+                    for (int i = 0; i < 2; i++) {
+                        Vector2 pos = {battleBox.x + i * battleBox.width, battleBox.y};
+                        SpawnSteered(am, pos, (SimVec2){ SIM(0), SIM(1.6) }, ATK_HOMING, HOMING_TICKS);
                     }
                 } else {
                     // Padrão de ataque em X
@@ -389,30 +408,37 @@ void AttackManagerUpdate(AttackManager *am, Rectangle battleBox, int frameCount,
                 // Padrões de Esperança - ataques intensos mas com padrões mais claros
                 if (frameCount % (spawnInterval * 5) == 0) {
                     // Grande espiral de esperança e medo
-                    for (int i = 0; i < 16; i++) {
-                        float angle = i * (2 * PI / 16);
-                        SpawnProjectile(am, 
-                                       (Vector2){battleBox.x + battleBox.width/2, battleBox.y + battleBox.height/2},
-                                       (Vector2){cosf(angle) * 2.5f, sinf(angle) * 2.5f},
-                                       i % 2 == 0 ? ATK_BONE_H : ATK_YELLOW);
-                    }
+                    PatternBurst(am, PATTERN_HOPE_SPIRAL,
+                                 (Vector2){battleBox.x + battleBox.width/2, battleBox.y + battleBox.height/2},
+                                 (Vector2){1, 1}, 2.5f, 0);
                 } else if (frameCount % (spawnInterval * 2) == 0) {
                     // Padrão de onda
-                    for (int i = 0; i < 10; i++) {
-                        float xPos = battleBox.x + (i * battleBox.width / 10);
-                        float yOffset = sinf(frameCount * 0.05f + i * 0.5f) * 30;
-                        SpawnProjectile(am, 
-                                       (Vector2){xPos, battleBox.y + yOffset},
-                                       (Vector2){0, 2.0f},
-                                       i % 3 == 0 ? ATK_YELLOW : ATK_BONE_V);
+                    PatternBurst(am, PATTERN_HOPE_WAVE,
+                                 (Vector2){battleBox.x, battleBox.y},
+                                 (Vector2){battleBox.width, 1}, 2.0f, SimFromRatio(frameCount % HOPE_WAVE_PERIOD, 20));
+                } else if (frameCount % (spawnInterval * 7) == 0) {
+                    // Mira: um feixe de um canto de cima até além do coração,
+                    // avisado antes de disparar (o coração tem tempo de sair)
+                    Vector2 corner = {AttackRand(am, 2) ? battleBox.x : battleBox.x + battleBox.width, battleBox.y};
+                    SimVec2 from = SimVec2FromVector2(corner);
+                    BeamDesc beam = { corner, SimToFloat(SimAtan2(target.y - from.y, target.x - from.x)), 0,
+                                      0, battleBox.width + battleBox.height, 5, 50 };
+                    SpawnLaser(am, &beam, (Vector2){0, 0}, 16, 50 + 25);
+                } else if (frameCount % (spawnInterval * 3) == 0) {
+                    // Anel que se abre, para e trava a mira no coração
+                    Vector2 center = {battleBox.x + battleBox.width/2, battleBox.y + 20};
+                    for (int i = 0; i < 8; i++) {
+                        sim_t angle = SimMul(SimFromInt(i), SIM(2 * PI / 8));
+                        SimVec2 vel = { SimMul(SimCos(angle), SIM(3)), SimMul(SimSin(angle), SIM(3)) };
+                        SpawnSteered(am, center, vel, ATK_LOCK, LOCK_DELAY);
                     }
                 } else {
                     // Ataques rápidos aleatórios
                     for (int i = 0; i < 4; i++) {
                         SpawnProjectile(am, 
-                                       (Vector2){battleBox.x + (rand() % (int)battleBox.width), battleBox.y},
-                                       (Vector2){(rand() % 5 - 2) * 0.5f, 2.2f},
-                                       rand() % 3 == 0 ? ATK_MAGENTA : ATK_BONE_H);
+                                       (Vector2){battleBox.x + AttackRand(am, (int)battleBox.width), battleBox.y},
+                                       (Vector2){(AttackRand(am, 5) - 2) * 0.5f, 2.2f},
+                                       AttackRand(am, 3) == 0 ? ATK_MAGENTA : ATK_BONE_H);
                     }
                 }
                 break;
@@ -423,241 +449,146 @@ void AttackManagerUpdate(AttackManager *am, Rectangle battleBox, int frameCount,
     }
 }
 
-// Função para desenhar plataformas
-void DrawPlatforms(const AttackManager *am) {
-    for (int i = 0; i < MAX_PLATFORMS; i++) {
-        if (!am->platforms[i].active) continue;
+// Ossos horizontais com detalhes realistas
+static void DrawBonesH(const Vector2 *pos, int count) {
+    const AttackTypeInfo *info = &attackTypeInfo[ATK_BONE_H];
+    int joints = QualityCurrent() < QUALITY_LOW;    // Articulações somem em qualidade baixa
+    int words = QualityCurrent() < QUALITY_MEDIUM;  // Palavras somem já na média
+    Color boneColor = (Color){220, 220, 220, 255}; // Cor de osso mais realista
+    int seconds = (int)GetTime();
+    
+    for (int i = 0; i < count; i++) {
+        // Base do osso
+        DrawRectangleV((Vector2){pos[i].x + info->offset.x, pos[i].y + info->offset.y}, (Vector2){info->width, info->height}, boneColor);
         
-        Color platformColor;
+        // Adicionar articulações nos ossos
+        for (int j = 0; joints && j < info->width; j += 30) {
+            DrawCircle(pos[i].x + j, pos[i].y, info->height * 0.8f, (Color){200, 200, 200, 255});
+        }
         
-        // Cores diferentes para cada tipo de plataforma
-        switch (am->platforms[i].type) {
-            case PLATFORM_NORMAL:
-                platformColor = (Color){100, 200, 100, 255}; // Verde para plataformas normais
-                break;
-                
-            case PLATFORM_MOVING:
-                platformColor = (Color){100, 100, 200, 255}; // Azul para plataformas móveis
-                break;
-                
-            case PLATFORM_TEMPORARY:
-                // Piscar quando estiver prestes a desaparecer
-                if (am->platforms[i].lifetime < 60) {
-                    platformColor = (Color){200, 100, 100, 128 + (int)(sinf(GetTime() * 10.0f) * 127.0f)};
-                } else {
-                    platformColor = (Color){200, 100, 100, 200}; // Vermelho para plataformas temporárias
-                }
-                break;
-                
-            case PLATFORM_BOUNCE:
-                // Efeito pulsante para plataformas de salto
-                float pulse = sinf(GetTime() * 5.0f) * 0.3f + 0.7f;
-                platformColor = (Color){200, 200, 0, (unsigned char)(200 * pulse)}; // Amarelo para plataformas de salto
-                break;
+        // Palavras de culpa que aparecem nos ossos
+        if (words && (i + seconds) % 5 < 1) {
+            const char* culpaTexts[] = {"CULPA", "FALHA", "ERRO", "MEDO", "PERDA"};
+            DrawText(culpaTexts[i % 5], pos[i].x + 50, pos[i].y - 15, 16, (Color){180, 0, 20, 200});
         }
+    }
+}
+
+// Ossos verticais com detalhes realistas
+static void DrawBonesV(const Vector2 *pos, int count) {
+    const AttackTypeInfo *info = &attackTypeInfo[ATK_BONE_V];
+    int joints = QualityCurrent() < QUALITY_LOW;
+    int words = QualityCurrent() < QUALITY_MEDIUM;
+    Color boneColor = (Color){220, 220, 220, 255};
+    int seconds = (int)GetTime();
+    
+    for (int i = 0; i < count; i++) {
+        // Base do osso
+        DrawRectangleV((Vector2){pos[i].x + info->offset.x, pos[i].y + info->offset.y}, (Vector2){info->width, info->height}, boneColor);
         
-        // Desenhar plataforma com bordas arredondadas
-        DrawRectangleRounded(am->platforms[i].rect, 0.3f, 8, platformColor);
+        // Adicionar articulações nos ossos
+        for (int j = 0; joints && j < info->height; j += 30) {
+            DrawCircle(pos[i].x, pos[i].y + j, info->width * 0.8f, (Color){200, 200, 200, 255});
+        }
         
-        // Adicionar detalhes visuais
-        if (am->platforms[i].type == PLATFORM_BOUNCE) {
-            // Setas para cima indicando plataforma de salto
-            float centerX = am->platforms[i].rect.x + am->platforms[i].rect.width / 2;
-            float topY = am->platforms[i].rect.y - 5;
-            DrawTriangle(
-                (Vector2){centerX - 10, topY},
-                (Vector2){centerX + 10, topY},
-                (Vector2){centerX, topY - 15},
-                YELLOW
-            );
+        // Palavras de arrependimento
+        if (words && (i + seconds) % 4 < 1) {
+            const char* arrependimentoTexts[] = {"ABANDONO", "TRAIÇÃO", "COVARDIA", "FRAQUEZA"};
+            DrawText(arrependimentoTexts[i % 4], pos[i].x - 40, pos[i].y + 50, 16, (Color){180, 0, 20, 200});
         }
     }
 }
 
-// Função para desenhar obstáculos
-void DrawObstacles(const AttackManager *am) {
-    for (int i = 0; i < MAX_OBSTACLES; i++) {
-        if (!am->obstacles[i].active) continue;
+// Projéteis magenta - fragmentos de memórias dolorosas
+static void DrawMagenta(const Vector2 *pos, int count) {
+    const AttackTypeInfo *info = &attackTypeInfo[ATK_MAGENTA];
+    int words = QualityCurrent() < QUALITY_MEDIUM;
+    Color magenta = (Color){255, 0, 255, 255};
+    float time = GetTime();
+    
+    for (int i = 0; i < count; i++) {
+        // Desenhar fragmento pulsante
+        float pulse = sinf(time * 5.0f + i) * 0.2f + 1.0f;
+        DrawRectangleV(pos[i], (Vector2){info->width * pulse, info->height * pulse}, magenta);
         
-        switch (am->obstacles[i].type) {
-            case OBSTACLE_SPIKE:
-                // Desenhar espinhos
-                {
-                    float baseX = am->obstacles[i].rect.x;
-                    float baseY = am->obstacles[i].rect.y + am->obstacles[i].rect.height;
-                    float width = am->obstacles[i].rect.width;
-                    float height = am->obstacles[i].rect.height;
-                    int spikes = (int)(width / 10);
-                    float spikeWidth = width / spikes;
-                    
-                    for (int j = 0; j < spikes; j++) {
-                        DrawTriangle(
-                            (Vector2){baseX + j * spikeWidth, baseY},
-                            (Vector2){baseX + (j + 1) * spikeWidth, baseY},
-                            (Vector2){baseX + (j + 0.5f) * spikeWidth, baseY - height},
-                            RED
-                        );
-                    }
-                }
-                break;
-                
-            case OBSTACLE_LASER:
-                // Desenhar laser com efeito de brilho
-                {
-                    float pulse = sinf(GetTime() * 10.0f) * 0.3f + 0.7f;
-                    Color laserColor = (Color){255, 50, 50, (unsigned char)(200 * pulse)};
-                    DrawRectangleRec(am->obstacles[i].rect, laserColor);
-                    
-                    // Adicionar efeito de brilho no centro
-                    Rectangle innerRect = {
-                        am->obstacles[i].rect.x + am->obstacles[i].rect.width * 0.25f,
-                        am->obstacles[i].rect.y + am->obstacles[i].rect.height * 0.25f,
-                        am->obstacles[i].rect.width * 0.5f,
-                        am->obstacles[i].rect.height * 0.5f
-                    };
-                    DrawRectangleRec(innerRect, (Color){255, 200, 200, (unsigned char)(180 * pulse)});
-                }
-                break;
-                
-            case OBSTACLE_MOVING:
-                // Desenhar obstáculo móvel com efeito de movimento
-                DrawRectangleRec(am->obstacles[i].rect, (Color){200, 50, 200, 200});
-                
-                // Adicionar setas indicando direção do movimento
-                if (fabs(am->obstacles[i].velocity.x) > fabs(am->obstacles[i].velocity.y)) {
-                    // Movimento horizontal
-                    float arrowDir = am->obstacles[i].velocity.x > 0 ? 1.0f : -1.0f;
-                    float centerX = am->obstacles[i].rect.x + am->obstacles[i].rect.width / 2;
-                    float centerY = am->obstacles[i].rect.y + am->obstacles[i].rect.height / 2;
-                    
-                    DrawTriangle(
-                        (Vector2){centerX, centerY - 5},
-                        (Vector2){centerX, centerY + 5},
-                        (Vector2){centerX + arrowDir * 10, centerY},
-                        WHITE
-                    );
-                } else {
-                    // Movimento vertical
-                    float arrowDir = am->obstacles[i].velocity.y > 0 ? 1.0f : -1.0f;
-                    float centerX = am->obstacles[i].rect.x + am->obstacles[i].rect.width / 2;
-                    float centerY = am->obstacles[i].rect.y + am->obstacles[i].rect.height / 2;
-                    
-                    DrawTriangle(
-                        (Vector2){centerX - 5, centerY},
-                        (Vector2){centerX + 5, centerY},
-                        (Vector2){centerX, centerY + arrowDir * 10},
-                        WHITE
-                    );
-                }
-                break;
-                
-            case OBSTACLE_PULSE:
-                // Desenhar obstáculo pulsante com efeito de fade
-                {
-                    float alpha = (float)am->obstacles[i].pulseTime / 60.0f;
-                    DrawRectangleRec(am->obstacles[i].rect, (Color){255, 100, 0, (unsigned char)(200 * alpha)});
-                }
-                break;
+        // Texto de memória fragmentada
+        if (words && i % 3 == 0) {
+            const char* memoriaTexts[] = {"LEMBRANÇA", "TRAUMA", "PESADELO"};
+            DrawText(memoriaTexts[i % 3], pos[i].x - 20, pos[i].y - 20, 12, (Color){255, 100, 255, 200});
         }
     }
 }
 
-void AttackManagerDraw(const AttackManager *am) {
-    // Desenhar plataformas e obstáculos primeiro (para que fiquem atrás dos projéteis)
-    DrawPlatforms(am);
-    DrawObstacles(am);
+// Projéteis amarelos - medos profundos
+static void DrawYellow(const Vector2 *pos, int count) {
+    const AttackTypeInfo *info = &attackTypeInfo[ATK_YELLOW];
+    int words = QualityCurrent() < QUALITY_MEDIUM;
+    int seconds = (int)GetTime();
     
-    // Desenhar projéteis
-    Color magenta = (Color){255, 0, 255, 255};
-    Color yellow = YELLOW;
-    Color boneColor = (Color){220, 220, 220, 255}; // Cor de osso mais realista
-
-    for (int i = 0; i < MAX_PROJECTILES; i++) {
-        const Projectile *p = &am->projectiles[i];
-        if (!p->active) continue;
+    for (int i = 0; i < count; i++) {
+        // Desenhar com efeito de distorção
+        DrawRectangleV((Vector2){pos[i].x + info->offset.x, pos[i].y + info->offset.y}, (Vector2){info->width, info->height}, YELLOW);
         
-        // Ossos horizontais com detalhes realistas
-        if (p->type == ATK_BONE_H) {
-            // Base do osso
-            DrawRectangleV((Vector2){p->pos.x, p->pos.y-3}, (Vector2){p->width, p->height}, boneColor);
-            
-            // Adicionar articulações nos ossos
-            for (int j = 0; j < p->width; j += 30) {
-                DrawCircle(p->pos.x + j, p->pos.y, p->height * 0.8f, (Color){200, 200, 200, 255});
-            }
-            
-            // Palavras de culpa que aparecem nos ossos
-            if ((i + (int)GetTime()) % 5 < 1) {
-                const char* culpaTexts[] = {"CULPA", "FALHA", "ERRO", "MEDO", "PERDA"};
-                int textIdx = i % 5;
-                DrawText(culpaTexts[textIdx], p->pos.x + 50, p->pos.y - 15, 16, (Color){180, 0, 20, 200});
-            }
-        }
-        // Ossos verticais com detalhes realistas
-        else if (p->type == ATK_BONE_V) {
-            // Base do osso
-            DrawRectangleV((Vector2){p->pos.x-3, p->pos.y}, (Vector2){p->width, p->height}, boneColor);
-            
-            // Adicionar articulações nos ossos
-            for (int j = 0; j < p->height; j += 30) {
-                DrawCircle(p->pos.x, p->pos.y + j, p->width * 0.8f, (Color){200, 200, 200, 255});
-            }
-            
-            // Palavras de arrependimento
-            if ((i + (int)GetTime()) % 4 < 1) {
-                const char* arrependimentoTexts[] = {"ABANDONO", "TRAIÇÃO", "COVARDIA", "FRAQUEZA"};
-                int textIdx = i % 4;
-                DrawText(arrependimentoTexts[textIdx], p->pos.x - 40, p->pos.y + 50, 16, (Color){180, 0, 20, 200});
-            }
-        }
-        // Projetos magenta - fragmentos de memórias dolorosas
-        else if (p->type == ATK_MAGENTA) {
-            // Desenhar fragmento pulsante
-            float pulse = sinf(GetTime() * 5.0f + i) * 0.2f + 1.0f;
-            DrawRectangleV((Vector2){p->pos.x, p->pos.y}, (Vector2){p->width * pulse, p->height * pulse}, magenta);
-            
-            // Texto de memória fragmentada
-            if (i % 3 == 0) {
-                const char* memoriaTexts[] = {"LEMBRANÇA", "TRAUMA", "PESADELO"};
-                DrawText(memoriaTexts[i % 3], p->pos.x - 20, p->pos.y - 20, 12, (Color){255, 100, 255, 200});
-            }
-        }
-        // Projetos amarelos - medos profundos
-        else if (p->type == ATK_YELLOW) {
-            // Desenhar com efeito de distorção
-            DrawRectangleV((Vector2){p->pos.x, p->pos.y-3}, (Vector2){p->width, p->height}, yellow);
-            
-            // Palavras de medo
-            if ((i + (int)GetTime()) % 3 < 1) {
-                const char* medoTexts[] = {"SOLIDÃO", "VAZIO", "FIM"};
-                int textIdx = i % 3;
-                DrawText(medoTexts[textIdx], p->pos.x + 100, p->pos.y - 10, 18, (Color){255, 255, 0, 200});
-            }
+        // Palavras de medo
+        if (words && (i + seconds) % 3 < 1) {
+            const char* medoTexts[] = {"SOLIDÃO", "VAZIO", "FIM"};
+            DrawText(medoTexts[i % 3], pos[i].x + 100, pos[i].y - 10, 18, (Color){255, 255, 0, 200});
         }
     }
 }
 
+// Disparos mirados - olhares que encontram o coração
+static void DrawAimed(const Vector2 *pos, int count) {
+    for (int i = 0; i < count; i++) {
+        DrawCircleV(pos[i], 5, (Color){255, 140, 40, 255});
+        DrawCircleV(pos[i], 2, (Color){255, 240, 200, 255});
+    }
+}
+
+// Teleguiados - losangos que giram enquanto perseguem
+static void DrawHoming(const Vector2 *pos, int count) {
+    float spin = GetTime() * 360.0f;
+    for (int i = 0; i < count; i++) {
+        DrawPoly(pos[i], 4, 7, spin + i * 20, (Color){120, 200, 255, 255});
+        DrawPoly(pos[i], 4, 3, -spin, (Color){230, 250, 255, 255});
+    }
+}
 
-int AttackManagerCheckHit(const AttackManager *am, const Rectangle *playerHitbox) {
-    // Verificar colisão com projéteis
-    for (int i = 0; i < MAX_PROJECTILES; i++) {
-        const Projectile *p = &am->projectiles[i];
-        if (!p->active) continue;
-        Rectangle r;
-        if (p->type == ATK_BONE_H || p->type == ATK_YELLOW)
-            r = (Rectangle){p->pos.x, p->pos.y-3, p->width, p->height};
-        else if (p->type == ATK_BONE_V)
-            r = (Rectangle){p->pos.x-3, p->pos.y, p->width, p->height};
-        else
-            r = (Rectangle){p->pos.x, p->pos.y, p->width, p->height};
-        if (CheckCollisionRecs(*playerHitbox, r)) return 1;
+// Trava - anéis vermelhos que param antes de disparar
+static void DrawLock(const Vector2 *pos, int count) {
+    int rings = QualityCurrent() < QUALITY_MEDIUM;
+    for (int i = 0; i < count; i++) {
+        DrawCircleV(pos[i], 4, (Color){220, 30, 60, 255});
+        if (rings) DrawCircleLines(pos[i].x, pos[i].y, 7, (Color){255, 80, 100, 200});
     }
+}
+
+// Orbes do chefe - aos milhares na tela, então só um hexágono cada
+static void DrawOrbs(const Vector2 *pos, int count) {
+    Color orb = (Color){255, 70, 120, 255};
+    for (int i = 0; i < count; i++) {
+        DrawPoly(pos[i], 6, 4, 0, orb);
+    }
+}
+
+void AttackManagerExtract(const AttackManager *am, AttackDrawState *out) {
+    memcpy(out->streamStart, am->streamStart, sizeof(out->streamStart));
+    for (int i = 0; i < am->streamStart[ATK_COUNT]; i++) {
+        out->positions[i] = SimVec2ToVector2(am->projectiles[i].pos);
+    }
+    out->entityCount = EntityExtract(&am->entities, out->entities);
+}
+
+void AttackManagerDraw(const AttackDrawState *ds) {
+    // Desenhar plataformas e obstáculos primeiro (para que fiquem atrás dos projéteis)
+    EntityDrawSystem(ds->entities, ds->entityCount);
     
-    // Verificar colisão com obstáculos
-    int damage = CheckObstacleCollision(am, playerHitbox);
-    if (damage > 0) return 1;
-    
-    return 0;
+    // Desenhar projéteis, um kernel por fluxo
+    for (int t = 0; t < ATK_COUNT; t++) {
+        int first = ds->streamStart[t];
+        int count = ds->streamStart[t + 1] - first;
+        if (count > 0) drawKernels[t](&ds->positions[first], count);
+    }
 }
 
 
@@ -2,85 +2,92 @@
 #define ATTACK_H
 #include "raylib.h"
 #include "common.h" // Definições compartilhadas
+#include "entity.h" // Plataformas e obstáculos
 
 // Forward declaration para evitar dependências circulares
 struct Player;
 typedef struct Player Player;
 
-#define MAX_PROJECTILES 64
-#define MAX_PLATFORMS 16
-#define MAX_OBSTACLES 32
-
-typedef enum { ATK_BONE_H, ATK_BONE_V, ATK_MAGENTA, ATK_YELLOW } AttackType;
-
-// Tipos de plataformas para o modo estilo Undertale
-typedef enum {
-    PLATFORM_NORMAL,    // Plataforma normal para ficar em pé
-    PLATFORM_MOVING,    // Plataforma que se move
-    PLATFORM_TEMPORARY, // Plataforma que desaparece após um tempo
-    PLATFORM_BOUNCE     // Plataforma que faz o jogador pular mais alto
-} PlatformType;
+#ifndef MAX_PROJECTILES   // Benchmarks compilam com mais (-DMAX_PROJECTILES=...)
+#define MAX_PROJECTILES 3072
+#endif
+#define LEVEL_PROJECTILE_CAP 64  // Teto dos níveis comuns (o chefe usa o pool inteiro)
 
-// Tipos de obstáculos para o modo estilo Undertale
-typedef enum {
-    OBSTACLE_SPIKE,     // Espinhos que causam dano ao tocar
-    OBSTACLE_LASER,     // Laser que causa dano ao tocar
-    OBSTACLE_MOVING,    // Obstáculo que se move em um padrão
-    OBSTACLE_PULSE      // Obstáculo que pulsa (aparece e desaparece)
-} ObstacleType;
+// Descritores dos tipos de ataque (X-macro): nome, largura, altura, dano,
+// deslocamento (x, y) do retângulo de colisão/desenho e kernel de desenho.
+// Para criar um tipo novo basta uma linha aqui e o kernel em attack.c.
+#define ATTACK_TYPE_LIST(X) \
+    X(ATK_BONE_H,  40,  6, 10,  0, -3, DrawBonesH) \
+    X(ATK_BONE_V,   6, 40, 10, -3,  0, DrawBonesV) \
+    X(ATK_MAGENTA, 16, 16, 12,  0,  0, DrawMagenta) \
+    X(ATK_YELLOW,  20,  6, 16,  0, -3, DrawYellow) \
+    X(ATK_AIMED,   10, 10, 10, -5, -5, DrawAimed) \
+    X(ATK_HOMING,  12, 12, 12, -6, -6, DrawHoming) \
+    X(ATK_LOCK,    12, 12, 14, -6, -6, DrawLock) \
+    X(ATK_ORB,      8,  8,  8, -4, -4, DrawOrbs)
 
-// Estrutura para plataformas
-typedef struct {
-    Rectangle rect;
-    PlatformType type;
-    Vector2 velocity;    // Para plataformas móveis
-    int lifetime;        // Para plataformas temporárias
-    float bounceForce;   // Para plataformas de salto
-    bool active;
-} Platform;
+#define ATTACK_TYPE_ENUM(name, w, h, dmg, ox, oy, draw) name,
+typedef enum { ATTACK_TYPE_LIST(ATTACK_TYPE_ENUM) ATK_COUNT } AttackType;
+#undef ATTACK_TYPE_ENUM
 
-// Estrutura para obstáculos
+// Propriedades fixas de cada tipo (iguais para todo o fluxo)
 typedef struct {
-    Rectangle rect;
-    ObstacleType type;
-    Vector2 velocity;    // Para obstáculos móveis
+    float width, height;
     int damage;
-    int pulseTime;       // Para obstáculos pulsantes
-    bool active;
-} Obstacle;
+    Vector2 offset;      // Deslocamento do retângulo em relação a pos
+} AttackTypeInfo;
+
+extern const AttackTypeInfo attackTypeInfo[ATK_COUNT];
 
+// Tamanho, dano e tipo vêm do fluxo em que o projétil está. Os tipos que
+// reagem ao coração têm um passo próprio sobre o seu fluxo, antes do
+// movimento comum:
+//   ATK_AIMED   mirado no disparo, depois segue reto
+//   ATK_HOMING  vira no máximo HOMING_TURN por tick na direção do coração
+//               enquanto timer > 0, depois segue reto
+//   ATK_LOCK    freia enquanto timer > 0 e, quando zera, trava a mira no
+//               coração e dispara
 typedef struct {
-    Vector2 pos, vel;
-    float width, height;
-    int type;
-    int damage;
-    int active;
+    SimVec2 pos, vel;   // vel em pixels por tick
+    int timer;          // Ticks do comportamento acima (0 nos demais tipos)
 } Projectile;
 
 struct AttackManager {
-    Projectile projectiles[MAX_PROJECTILES];
-    Platform platforms[MAX_PLATFORMS];
-    int platformCount;
-    Obstacle obstacles[MAX_OBSTACLES];
-    int obstacleCount;
+    int streamStart[ATK_COUNT + 1];
+    int projectileCap;      // Teto de projéteis vivos (LEVEL_PROJECTILE_CAP ou MAX_PROJECTILES)
+    EntityStore entities;   // Plataformas e obstáculos
     int spawnRate;
     int spawnTimer;
     AttackType currentType;
     int phase;
+    unsigned int rngState;  // Sorteio dos padrões (faz parte do snapshot)
+    // Projéteis agrupados por tipo em fluxos contíguos: o fluxo do tipo t
+    // ocupa projectiles[streamStart[t] .. streamStart[t+1]). Fica por último
+    // para o snapshot copiar só até o fim dos vivos (ver GameSnapshot).
+    Projectile projectiles[MAX_PROJECTILES];
 };
 typedef struct AttackManager AttackManager;
 
 void AttackManagerInit(AttackManager *am, Rectangle battleBox);
-void AttackManagerUpdate(AttackManager *am, Rectangle battleBox, int frameCount, GameLevel currentLevel, PlayerMoveType playerMoveType);
-void AttackManagerDraw(const AttackManager *am);
-int AttackManagerCheckHit(const AttackManager *am, const Rectangle *playerHitbox);
+void AttackManagerUpdate(AttackManager *am, Rectangle battleBox, int frameCount, GameLevel currentLevel, PlayerMoveType playerMoveType, SimVec2 target);
+// O que o desenho precisa dos ataques, copiado após cada tick
+typedef struct {
+    Vector2 positions[MAX_PROJECTILES];    // Mesma ordem dos fluxos
+    int streamStart[ATK_COUNT + 1];
+    EntityDrawItem entities[MAX_ENTITIES];
+    int entityCount;
+} AttackDrawState;
+
+void AttackManagerExtract(const AttackManager *am, AttackDrawState *out);
+void AttackManagerDraw(const AttackDrawState *ds);
+void SpawnProjectile(AttackManager *am, Vector2 pos, Vector2 vel, AttackType type);
+void SpawnProjectiles(AttackManager *am, const Projectile *src, int count, AttackType type);
+void AttackManagerClearProjectiles(AttackManager *am);
 
 // Funções para plataformas e obstáculos no estilo Undertale
-void SpawnPlatform(AttackManager *am, Rectangle rect, PlatformType type, Vector2 velocity, int lifetime, float bounceForce);
-void SpawnObstacle(AttackManager *am, Rectangle rect, ObstacleType type, Vector2 velocity, int damage, int pulseTime);
-void UpdatePlatforms(AttackManager *am, Rectangle battleBox, float dt);
-void UpdateObstacles(AttackManager *am, Rectangle battleBox, float dt);
+int SpawnPlatform(AttackManager *am, Rectangle rect, PlatformType type, Vector2 velocity, int lifetime, float bounceForce);
+int SpawnObstacle(AttackManager *am, Rectangle rect, ObstacleType type, Vector2 velocity, int damage, int pulseTime);
+int SpawnLaser(AttackManager *am, const BeamDesc *beam, Vector2 sweep, int damage, int lifetime);
 int CheckPlatformCollision(const AttackManager *am, Player *player);
-int CheckObstacleCollision(const AttackManager *am, const Rectangle *playerHitbox);
 
 #endif
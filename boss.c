@@ -0,0 +1,207 @@
+#include "boss.h"
+#include "hud.h"
+#include "quality.h"
+#include <math.h>
+
+#define BOSS_SWAY_STEP SIM(0.008)   // Passeio do corpo: uma volta do oito a cada ~13 s
+#define BOSS_HURT_FRAMES 8
+
+// Um nó da árvore de emissores. O ângulo de cada emissor é o do pai mais a
+// sua órbita, então os filhos giram junto com o pai (anéis dentro de anéis).
+typedef struct {
+    int parent;         // Emissor pai (-1 = o corpo); vem sempre antes dos filhos
+    sim_t radius;       // Distância ao pai
+    sim_t orbit;        // Ângulo inicial em volta do pai
+    sim_t spin;         // Giro por tick em volta do pai
+    int ring;           // Projéteis por disparo (0 = só carrega filhos)
+    int interval;       // Ticks entre disparos
+    int start;          // Ticks da fase antes do primeiro disparo
+    int aimed;          // 1 = o anel sai alinhado com o coração
+    sim_t speed;
+    AttackType type;
+} EmitterDesc;
+
+typedef struct {
+    const char *name;   // Mensagem do HUD ao entrar na fase
+    int count;
+    EmitterDesc emitters[BOSS_MAX_EMITTERS];
+} BossPhaseDesc;
+
+// Fases em ordem de vida perdida. Vazão aproximada (projéteis por tick):
+// 2,6 na primeira, 7,7 na segunda e 14 na última, o que com ~200 ticks de
+// vida na tela passa de 2.000 projéteis vivos.
+static const BossPhaseDesc bossPhases[BOSS_PHASES] = {
+    { "Os anéis se fecham", 4, {
+        { -1, SIM(0),  SIM(0),          SIM(0.013),  20, 24,   0, 0, SIM(1.5), ATK_ORB },
+        {  0, SIM(70), SIM(0),          SIM(0.025),  10, 14,  90, 0, SIM(1.9), ATK_ORB },
+        {  0, SIM(70), SIM(PI),         SIM(0.025),  10, 14,  90, 0, SIM(1.9), ATK_ORB },
+        { -1, SIM(0),  SIM(0),          SIM(0),      12, 60, 150, 1, SIM(2.4), ATK_AIMED },
+    } },
+    { "A espiral se parte", 8, {
+        { -1, SIM(0),  SIM(0),          SIM(-0.02),  24, 16,   0, 0, SIM(1.7), ATK_ORB },
+        {  0, SIM(80), SIM(0),          SIM(0.02),   12, 10,  60, 0, SIM(2.0), ATK_ORB },
+        {  0, SIM(80), SIM(2 * PI / 3), SIM(0.02),   12, 10,  60, 0, SIM(2.0), ATK_ORB },
+        {  0, SIM(80), SIM(4 * PI / 3), SIM(0.02),   12, 10,  60, 0, SIM(2.0), ATK_ORB },
+        {  1, SIM(28), SIM(0),          SIM(-0.09),   6,  8, 180, 0, SIM(1.4), ATK_ORB },
+        {  2, SIM(28), SIM(0),          SIM(-0.09),   6,  8, 180, 0, SIM(1.4), ATK_ORB },
+        {  3, SIM(28), SIM(0),          SIM(-0.09),   6,  8, 180, 0, SIM(1.4), ATK_ORB },
+        { -1, SIM(0),  SIM(0),          SIM(0),      16, 45, 240, 1, SIM(2.6), ATK_AIMED },
+    } },
+    { "O coração floresce", 10, {
+        { -1, SIM(0),  SIM(0),          SIM(0.017),  28, 14,   0, 0, SIM(1.6), ATK_ORB },
+        {  0, SIM(90), SIM(0),          SIM(-0.015), 12, 12,  30, 0, SIM(1.9), ATK_ORB },
+        {  0, SIM(90), SIM(PI / 2),     SIM(-0.015), 12, 12,  30, 0, SIM(1.9), ATK_ORB },
+        {  0, SIM(90), SIM(PI),         SIM(-0.015), 12, 12,  30, 0, SIM(1.9), ATK_ORB },
+        {  0, SIM(90), SIM(3 * PI / 2), SIM(-0.015), 12, 12,  30, 0, SIM(1.9), ATK_ORB },
+        {  1, SIM(32), SIM(0),          SIM(0.11),    8, 10, 120, 0, SIM(1.4), ATK_ORB },
+        {  2, SIM(32), SIM(0),          SIM(0.11),    8, 10, 120, 0, SIM(1.4), ATK_ORB },
+        {  3, SIM(32), SIM(0),          SIM(0.11),    8, 10, 120, 0, SIM(1.4), ATK_ORB },
+        {  4, SIM(32), SIM(0),          SIM(0.11),    8, 10, 120, 0, SIM(1.4), ATK_ORB },
+        { -1, SIM(0),  SIM(0),          SIM(0),      20, 40, 200, 1, SIM(2.8), ATK_AIMED },
+    } },
+};
+
+// Mantém o ângulo em [0, 2pi) para não perder precisão com o tempo
+static sim_t WrapAngle(sim_t a) {
+    if (a >= SIM(2 * PI)) a -= SIM(2 * PI);
+    if (a < 0) a += SIM(2 * PI);
+    return a;
+}
+
+// Um anel de "ring" projéteis igualmente espaçados a partir de "angle":
+// seno e cosseno uma vez por anel, o resto por rotação, e um lote só
+static void FireRing(AttackManager *am, SimVec2 origin, sim_t angle, const EmitterDesc *e) {
+    Projectile batch[BOSS_MAX_RING];
+    sim_t step = SimDiv(SIM(2 * PI), SimFromInt(e->ring));
+    sim_t stepCos = SimCos(step), stepSin = SimSin(step);
+    sim_t c = SimCos(angle), s = SimSin(angle);
+    for (int i = 0; i < e->ring; i++) {
+        batch[i] = (Projectile){ origin, { SimMul(c, e->speed), SimMul(s, e->speed) }, 0 };
+        sim_t next = SimMul(c, stepCos) - SimMul(s, stepSin);
+        s = SimMul(s, stepCos) + SimMul(c, stepSin);
+        c = next;
+    }
+    SpawnProjectiles(am, batch, e->ring, e->type);
+}
+
+// Troca os emissores e limpa a tela (o chefe recolhe os projéteis da fase)
+static void BossEnterPhase(Boss *b, AttackManager *am, int phase) {
+    const BossPhaseDesc *pd = &bossPhases[phase];
+    b->phase = phase;
+    b->phaseTicks = 0;
+    b->emitterCount = pd->count;
+    for (int i = 0; i < pd->count; i++) {
+        b->orbit[i] = pd->emitters[i].orbit;
+        b->emitterPos[i] = b->pos;
+    }
+    AttackManagerClearProjectiles(am);
+}
+
+void BossStart(Boss *b, AttackManager *am, Rectangle battleBox) {
+    b->hp = BOSS_HP;
+    b->hurtFlash = 0;
+    b->sway = 0;
+    b->home = (SimVec2){ SimFromFloat(battleBox.x + battleBox.width / 2), SimFromFloat(battleBox.y + 70) };
+    b->reach = (SimVec2){ SimFromFloat(battleBox.width * 0.3f), SIM(20) };
+    b->pos = b->home;
+
+    // Só o chefe usa o pool inteiro
+    am->projectileCap = MAX_PROJECTILES;
+    BossEnterPhase(b, am, 0);
+}
+
+int BossUpdate(Boss *b, AttackManager *am, SimVec2 target) {
+    if (b->hurtFlash > 0) b->hurtFlash--;
+    if (--b->hp <= 0) {
+        b->hp = 0;
+        return 1;
+    }
+
+    // A fase segue a vida perdida (um terço por fase)
+    int phase = (BOSS_HP - b->hp) * BOSS_PHASES / BOSS_HP;
+    if (phase != b->phase) {
+        BossEnterPhase(b, am, phase);
+        HUDShowMessage(bossPhases[phase].name, 150);
+    }
+
+    // Passeio em oito pela parte de cima da caixa
+    b->sway = WrapAngle(b->sway + BOSS_SWAY_STEP);
+    b->pos.x = b->home.x + SimMul(b->reach.x, SimSin(b->sway));
+    b->pos.y = b->home.y + SimMul(b->reach.y, SimSin(2 * b->sway));
+
+    // Uma passada pela árvore (pais antes dos filhos): posição no mundo e disparo
+    const BossPhaseDesc *pd = &bossPhases[b->phase];
+    sim_t angle[BOSS_MAX_EMITTERS];
+    for (int i = 0; i < pd->count; i++) {
+        const EmitterDesc *e = &pd->emitters[i];
+        SimVec2 origin = e->parent < 0 ? b->pos : b->emitterPos[e->parent];
+        sim_t base = e->parent < 0 ? 0 : angle[e->parent];
+        b->orbit[i] = WrapAngle(b->orbit[i] + e->spin);
+        angle[i] = base + b->orbit[i];
+        b->emitterPos[i] = origin;
+        if (e->radius != 0) {
+            b->emitterPos[i].x += SimMul(e->radius, SimCos(angle[i]));
+            b->emitterPos[i].y += SimMul(e->radius, SimSin(angle[i]));
+        }
+
+        int t = b->phaseTicks - e->start;
+        if (e->ring == 0 || t < 0 || t % e->interval != 0) continue;
+        SimVec2 from = b->emitterPos[i];
+        sim_t aim = e->aimed ? SimAtan2(target.y - from.y, target.x - from.x) : angle[i];
+        FireRing(am, from, aim, e);
+    }
+    b->phaseTicks++;
+    return 0;
+}
+
+void BossDamage(Boss *b, int damage) {
+    b->hp -= damage;
+    if (b->hp < 1) b->hp = 1;   // O golpe final fica para BossUpdate
+    b->hurtFlash = BOSS_HURT_FRAMES;
+}
+
+void BossExtract(const Boss *b, int active, BossDrawState *out) {
+    out->active = active;
+    out->pos = SimVec2ToVector2(b->pos);
+    out->hp = b->hp;
+    out->phase = b->phase;
+    out->hurtFlash = b->hurtFlash;
+    out->emitterCount = b->emitterCount;
+    for (int i = 0; i < b->emitterCount; i++) out->emitters[i] = SimVec2ToVector2(b->emitterPos[i]);
+}
+
+// Coração rachado com os emissores presos por fios ao pai
+void BossDraw(const BossDrawState *ds) {
+    if (!ds->active) return;
+    const BossPhaseDesc *pd = &bossPhases[ds->phase];
+    float time = GetTime();
+
+    // Fios da árvore (somem em qualidade baixa)
+    if (QualityCurrent() < QUALITY_LOW) {
+        for (int i = 0; i < ds->emitterCount; i++) {
+            int parent = pd->emitters[i].parent;
+            Vector2 from = parent < 0 ? ds->pos : ds->emitters[parent];
+            DrawLineEx(from, ds->emitters[i], 1.5f, (Color){120, 0, 40, 160});
+        }
+    }
+
+    // Corpo pulsante, branco por um instante quando sofre um raspão
+    float beat = 1.0f + 0.08f * sinf(time * 6.0f);
+    Color body = ds->hurtFlash > 0 ? (Color){255, 230, 230, 255} : (Color){150, 0, 30, 255};
+    DrawCircleV((Vector2){ds->pos.x - 12 * beat, ds->pos.y - 6}, 16 * beat, body);
+    DrawCircleV((Vector2){ds->pos.x + 12 * beat, ds->pos.y - 6}, 16 * beat, body);
+    DrawTriangle((Vector2){ds->pos.x - 27 * beat, ds->pos.y}, (Vector2){ds->pos.x, ds->pos.y + 30 * beat},
+                 (Vector2){ds->pos.x + 27 * beat, ds->pos.y}, body);
+    DrawLineEx((Vector2){ds->pos.x, ds->pos.y - 14}, (Vector2){ds->pos.x - 5, ds->pos.y + 4}, 2, BLACK);
+    DrawLineEx((Vector2){ds->pos.x - 5, ds->pos.y + 4}, (Vector2){ds->pos.x + 4, ds->pos.y + 22}, 2, BLACK);
+
+    // Emissores girando
+    for (int i = 0; i < ds->emitterCount; i++) {
+        DrawPoly(ds->emitters[i], 4, 7, time * 180.0f + i * 30, (Color){255, 120, 160, 255});
+    }
+
+    // Vida do chefe logo acima do corpo
+    float width = 120.0f * ds->hp / BOSS_HP;
+    DrawRectangle(ds->pos.x - 60, ds->pos.y - 42, 120, 6, (Color){40, 0, 10, 200});
+    DrawRectangle(ds->pos.x - 60, ds->pos.y - 42, width, 6, (Color){230, 40, 80, 255});
+}
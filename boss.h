@@ -0,0 +1,45 @@
+#ifndef BOSS_H
+#define BOSS_H
+#include "raylib.h"
+#include "common.h"
+#include "attack.h"
+
+// Chefe final (LEVEL_BOSS, PHASE_BOSS): um corpo que anda pela caixa
+// carregando uma árvore de emissores. Cada emissor orbita o pai (o corpo ou
+// outro emissor) e, no seu intervalo, dispara um anel de projéteis em lote
+// no fluxo do tipo. A fase muda quando a vida cruza cada terço; dentro da
+// fase os emissores entram em cena pelo tempo.
+#define BOSS_HP 2400                // Perde 1 por tick (40 s) e mais a cada raspão
+#define BOSS_PHASES 3
+#define BOSS_MAX_EMITTERS 12
+#define BOSS_MAX_RING 32            // Projéteis por anel
+
+typedef struct {
+    int hp;
+    int phase;                      // 0 .. BOSS_PHASES - 1
+    int phaseTicks;                 // Ticks desde o início da fase
+    int hurtFlash;                  // Frames do brilho de dano
+    sim_t sway;                     // Ângulo do passeio do corpo (volta a cada 2pi)
+    SimVec2 home, reach;            // Centro e amplitude do passeio
+    SimVec2 pos;
+    int emitterCount;
+    sim_t orbit[BOSS_MAX_EMITTERS];         // Ângulo de cada emissor em volta do pai
+    SimVec2 emitterPos[BOSS_MAX_EMITTERS];  // Posição no mundo neste tick
+} Boss;
+
+// O que o desenho precisa do chefe, copiado após cada tick
+typedef struct {
+    int active;
+    Vector2 pos;
+    int hp, phase, hurtFlash;
+    int emitterCount;
+    Vector2 emitters[BOSS_MAX_EMITTERS];
+} BossDrawState;
+
+void BossStart(Boss *b, AttackManager *am, Rectangle battleBox);
+int BossUpdate(Boss *b, AttackManager *am, SimVec2 target);    // 1 no tick em que é derrotado
+void BossDamage(Boss *b, int damage);
+void BossExtract(const Boss *b, int active, BossDrawState *out);
+void BossDraw(const BossDrawState *ds);
+
+#endif
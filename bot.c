@@ -0,0 +1,230 @@
+#include "bot.h"
+#include "hud.h"
+#include "telemetry.h"
+#include "utils.h"
+#include <math.h>
+
+// Pesos do custo de uma candidata
+#define BOT_HIT_COST 1000.0f        // Por ponto de vida perdido no horizonte (dobra no primeiro tick)
+#define BOT_DEATH_COST 1e6f
+#define BOT_FIELD_WEIGHT 400.0f     // Perigo logo depois do horizonte (cai até zero no fim)
+#define BOT_BEAM_MARGIN 12.0f       // Folga desejada dos feixes no ponto de chegada
+#define BOT_BEAM_COST 300.0f
+#define BOT_CENTER_WEIGHT 30.0f     // Na borda da caixa; zero no ponto de descanso
+#define BOT_OUTSIDE_COST 5000.0f    // Abaixo da caixa (só o movimento livre não tem chão)
+#define BOT_FALL_COST 200.0f        // Plataformas: terminar no ar sem nada embaixo
+#define BOT_SWITCH_COST 2.0f        // Preferir manter a entrada (sem tremer)
+#define BOT_NOISE 4.0f
+#define BOT_MARGIN 4.0f             // Folga em volta de cada ameaça no campo
+#define BOT_FIELD_STEP 3            // Ticks entre amostras do caminho projetado
+
+// Candidatas por tipo de movimento (o pulo só vale no primeiro tick)
+static const unsigned char freeMoves[] = {
+    0, INPUT_LEFT, INPUT_RIGHT, INPUT_UP, INPUT_DOWN,
+    INPUT_LEFT | INPUT_UP, INPUT_LEFT | INPUT_DOWN, INPUT_RIGHT | INPUT_UP, INPUT_RIGHT | INPUT_DOWN,
+    INPUT_DASH | INPUT_LEFT, INPUT_DASH | INPUT_RIGHT,
+    INPUT_DASH | INPUT_LEFT | INPUT_UP, INPUT_DASH | INPUT_LEFT | INPUT_DOWN,
+    INPUT_DASH | INPUT_RIGHT | INPUT_UP, INPUT_DASH | INPUT_RIGHT | INPUT_DOWN,
+};
+static const unsigned char jumpMoves[] = {
+    0, INPUT_LEFT, INPUT_RIGHT, INPUT_DASH | INPUT_LEFT, INPUT_DASH | INPUT_RIGHT,
+    INPUT_JUMP, INPUT_JUMP | INPUT_LEFT, INPUT_JUMP | INPUT_RIGHT,
+    INPUT_JUMP | INPUT_DASH | INPUT_LEFT, INPUT_JUMP | INPUT_DASH | INPUT_RIGHT,
+};
+
+// Cópia da partida para a simulação adiante (e os checkpoints que ela capturar)
+static Game scratch;
+static GameCheckpoints lookaheadCheckpoints;
+
+void BotInit(Bot *b) {
+    b->rng = RAND_DEFAULT_SEED;
+    b->last = 0;
+    b->decisions = b->cutoffs = 0;
+    b->totalUs = b->maxUs = b->maxCpuUs = 0.0;
+    b->cols = b->rows = 0;
+}
+
+double BotAvgUs(const Bot *b) {
+    return b->decisions > 0 ? b->totalUs / b->decisions : 0.0;
+}
+
+// Marca com "weight" as células cujo centro cai no retângulo aumentado pela
+// metade da hitbox do coração e pela folga (fica o maior perigo da célula)
+static void MarkRect(Bot *b, Rectangle box, float x, float y, float w, float h, float grow, float weight) {
+    int c0 = (int)floorf((x - grow - box.x) / BOT_CELL), c1 = (int)floorf((x + w + grow - box.x) / BOT_CELL);
+    int r0 = (int)floorf((y - grow - box.y) / BOT_CELL), r1 = (int)floorf((y + h + grow - box.y) / BOT_CELL);
+    if (c0 < 0) c0 = 0;
+    if (r0 < 0) r0 = 0;
+    if (c1 >= b->cols) c1 = b->cols - 1;
+    if (r1 >= b->rows) r1 = b->rows - 1;
+    for (int r = r0; r <= r1; r++) {
+        float *row = &b->field[r * b->cols];
+        for (int c = c0; c <= c1; c++) {
+            if (row[c] < weight) row[c] = weight;
+        }
+    }
+}
+
+// Campo de perigo: onde cada ameaça vai estar entre o fim do horizonte e
+// BOT_FIELD_TICKS depois, supondo que siga reto
+static void BuildField(Bot *b, const Game *g) {
+    Rectangle box = g->battleBox;
+    b->cols = (int)ceilf(box.width / BOT_CELL);
+    b->rows = (int)ceilf(box.height / BOT_CELL);
+    if (b->cols > BOT_FIELD_COLS) b->cols = BOT_FIELD_COLS;
+    if (b->rows > BOT_FIELD_ROWS) b->rows = BOT_FIELD_ROWS;
+    for (int i = 0; i < b->cols * b->rows; i++) b->field[i] = 0.0f;
+
+    float grow = SimToFloat(SimMul(g->player.size, SIM(0.3))) + BOT_MARGIN;
+    const AttackManager *am = &g->attacks;
+    for (int t = 0; t < ATK_COUNT; t++) {
+        const AttackTypeInfo *info = &attackTypeInfo[t];
+        for (int i = am->streamStart[t]; i < am->streamStart[t + 1]; i++) {
+            Vector2 pos = SimVec2ToVector2(am->projectiles[i].pos);
+            Vector2 vel = SimVec2ToVector2(am->projectiles[i].vel);
+            for (int k = 0; k <= BOT_FIELD_TICKS; k += BOT_FIELD_STEP) {
+                float ahead = BOT_HORIZON + k;
+                float weight = BOT_FIELD_WEIGHT * (1.0f - (float)k / (BOT_FIELD_TICKS + BOT_FIELD_STEP));
+                MarkRect(b, box, pos.x + vel.x * ahead + info->offset.x, pos.y + vel.y * ahead + info->offset.y,
+                         info->width, info->height, grow, weight);
+            }
+        }
+    }
+
+    // Obstáculos (os feixes entram no custo direto, girando não dá para projetar reto)
+    const EntityStore *es = &am->entities;
+    for (int i = 0; i < es->count; i++) {
+        if (!(es->mask[i] & COMP_DAMAGE) || (es->mask[i] & COMP_BEAM) || es->damage[i] <= 0) continue;
+        Rectangle r = SimRectToRectangle(es->rect[i]);
+        Vector2 vel = (es->mask[i] & COMP_VELOCITY) ? SimVec2ToVector2(es->velocity[i]) : (Vector2){0, 0};
+        for (int k = 0; k <= BOT_FIELD_TICKS; k += BOT_FIELD_STEP) {
+            float ahead = BOT_HORIZON + k;
+            MarkRect(b, box, r.x + vel.x * ahead, r.y + vel.y * ahead, r.width, r.height, grow, BOT_FIELD_WEIGHT);
+        }
+    }
+}
+
+static float FieldAt(const Bot *b, Rectangle box, Vector2 p) {
+    int c = (int)floorf((p.x - box.x) / BOT_CELL), r = (int)floorf((p.y - box.y) / BOT_CELL);
+    if (c < 0 || r < 0 || c >= b->cols || r >= b->rows) return 0.0f;
+    return b->field[r * b->cols + c];
+}
+
+// Há plataforma sólida embaixo do coração (dentro da caixa)?
+static int PlatformBelow(const Game *g, const Player *p) {
+    const EntityStore *es = &g->attacks.entities;
+    for (int i = 0; i < es->count; i++) {
+        if (!(es->mask[i] & COMP_PLATFORM) || !EntityIsSolid(es, i)) continue;
+        const SimRect *r = &es->rect[i];
+        if (p->pos.x + p->size / 2 > r->x && p->pos.x - p->size / 2 < r->x + r->width && r->y >= p->pos.y) return 1;
+    }
+    return 0;
+}
+
+// Custo do ponto onde a candidata termina
+static float RestCost(const Bot *b, const Game *sim) {
+    const Player *p = &sim->player;
+    Rectangle box = sim->battleBox;
+    Vector2 pos = SimVec2ToVector2(p->pos);
+    float half = SimToFloat(p->size) / 2;
+    float cost = FieldAt(b, box, pos);
+
+    // Ponto de descanso: centro na horizontal, um pouco abaixo do meio
+    // (o chefe e as chuvas vêm de cima)
+    float dx = (pos.x - (box.x + box.width / 2)) / (box.width / 2);
+    float dy = p->moveType == MOVE_FREE ? (pos.y - (box.y + box.height * 0.65f)) / (box.height / 2) : 0.0f;
+    cost += BOT_CENTER_WEIGHT * (dx * dx + dy * dy);
+    if (pos.y - half > box.y + box.height) cost += BOT_OUTSIDE_COST;
+    if (p->moveType == MOVE_PLATFORMS && !p->isGrounded && !PlatformBelow(sim, p)) cost += BOT_FALL_COST;
+
+    // Feixes perto do ponto de chegada
+    sim_t hitbox = SimMul(p->size, SIM(0.6));
+    SimRect r = { p->pos.x - hitbox / 2, p->pos.y - hitbox / 2, hitbox, hitbox };
+    const EntityStore *es = &sim->attacks.entities;
+    for (int i = 0; i < es->count; i++) {
+        if (!(es->mask[i] & COMP_BEAM)) continue;
+        float gap = SimToFloat(SimBeamGap(&es->beam[i], &r));
+        if (gap < BOT_BEAM_MARGIN) cost += BOT_BEAM_COST * (1.0f - fmaxf(gap, 0.0f) / BOT_BEAM_MARGIN);
+    }
+    return cost;
+}
+
+// Simula BOT_HORIZON ticks segurando "buttons" numa cópia da partida
+static float Evaluate(const Bot *b, const Game *g, unsigned char buttons) {
+    GameCopy(&scratch, g);
+    PlayerInput inputs[2] = { { buttons }, { 0 } };
+    int hp = scratch.player.hp;
+    float cost = 0.0f;
+    for (int t = 0; t < BOT_HORIZON; t++) {
+        inputs[0].buttons = t == 0 ? buttons : (unsigned char)(buttons & ~INPUT_JUMP);
+        GameTick(&scratch, inputs);
+        if (scratch.player.isDead) return cost + BOT_DEATH_COST * (2 * BOT_HORIZON - t) / BOT_HORIZON;
+        if (scratch.player.hp < hp) {
+            cost += BOT_HIT_COST * (hp - scratch.player.hp) * (2 * BOT_HORIZON - t) / BOT_HORIZON;
+            hp = scratch.player.hp;
+        }
+        if (scratch.phase != PHASE_BATTLE && scratch.phase != PHASE_BOSS) return cost;  // Nível acabou
+    }
+    return cost + RestCost(b, &scratch);
+}
+
+PlayerInput BotDecide(Bot *b, const Game *g) {
+    PlayerInput in = { 0 };
+    if (!g->running || g->player.isDead || (g->phase != PHASE_BATTLE && g->phase != PHASE_BOSS)) return in;
+    double start = TimeNow(), cpuStart = ThreadCpuNow();
+
+    BuildField(b, g);
+    const unsigned char *moves = g->player.moveType == MOVE_FREE ? freeMoves : jumpMoves;
+    int count = g->player.moveType == MOVE_FREE ? (int)sizeof(freeMoves) : (int)sizeof(jumpMoves);
+
+    // A simulação adiante não pode mexer no HUD, na telemetria nem nos
+    // checkpoints da partida de verdade
+    GameCheckpoints *own = GameUseCheckpoints(&lookaheadCheckpoints);
+    HUDMute(1);
+    TelemetryMute(1);
+    // Começa pela entrada do tick anterior: se o prazo acabar, é ela que fica
+    int first = 0;
+    for (int i = 0; i < count; i++) {
+        if (moves[i] == (b->last & ~INPUT_JUMP)) first = i;
+    }
+    float best = 0.0f;
+    double slowest = 0.0;
+    for (int k = 0; k < count; k++) {
+        int i = (first + k) % count;
+        double before = TimeNow();
+        // Não começa uma candidata que passaria do prazo (a mais lenta até aqui como estimativa)
+        if (k > 0 && (before - start) * 1e6 + slowest > BOT_BUDGET_US) {
+            b->cutoffs++;
+            break;
+        }
+        float cost = Evaluate(b, g, moves[i]);
+        double took = (TimeNow() - before) * 1e6;
+        if (took > slowest) slowest = took;
+        cost += (RandNext(&b->rng) & 0xFFFF) * (BOT_NOISE / 65535.0f);
+        if ((moves[i] & ~INPUT_JUMP) != (b->last & ~INPUT_JUMP)) cost += BOT_SWITCH_COST;
+        if (k == 0 || cost < best) {
+            best = cost;
+            in.buttons = moves[i];
+        }
+    }
+    TelemetryMute(0);
+    HUDMute(0);
+    GameUseCheckpoints(own);
+    b->last = in.buttons;
+
+    double us = (TimeNow() - start) * 1e6, cpuUs = (ThreadCpuNow() - cpuStart) * 1e6;
+    b->decisions++;
+    b->totalUs += us;
+    if (us > b->maxUs) b->maxUs = us;
+    if (cpuUs > b->maxCpuUs) b->maxCpuUs = cpuUs;
+    return in;
+}
+
+GameInput BotReadInput(Bot *b, const Game *g) {
+    GameInput in = { 0 };
+    in.practiceLevel = -1;
+    in.start = g->phase == PHASE_MENU || g->phase == PHASE_WIN;
+    in.confirm = g->player.isDead && !g->running;   // No cooperativo, só quando os dois caem
+    in.player = BotDecide(b, g);
+    return in;
+}
@@ -0,0 +1,46 @@
+#ifndef BOT_H
+#define BOT_H
+#include "game.h"
+
+// Jogador automático (--bot e ./simbench --bot) para testes longos e para
+// conferir a dificuldade. A cada tick:
+//   1. monta um campo de perigo grosso sobre a caixa de batalha projetando
+//      em linha reta o caminho dos projéteis e obstáculos além do horizonte;
+//   2. para cada entrada candidata, copia o Game e simula BOT_HORIZON ticks
+//      segurando essa entrada (pulo só no primeiro), com o HUD, a telemetria
+//      e os checkpoints de lado;
+//   3. fica com a de menor custo: dano e morte no horizonte, perigo no ponto
+//      de chegada, distância do centro e, nas plataformas, ficar sem apoio.
+// O resultado é um PlayerInput, o mesmo que o teclado e a rede entregam.
+// A decisão tem prazo (BOT_BUDGET_US): com muitos projéteis, as candidatas
+// que não couberem ficam de fora e vale a melhor avaliada, começando pela
+// entrada do tick anterior. O prazo é em tempo real (o bot roda na thread
+// principal, entre um frame e outro); o tempo de CPU da decisão sai junto
+// para separar o custo dela da preempção. Sob carga, duas execuções podem
+// escolher diferente.
+#define BOT_HORIZON 12              // Ticks simulados por candidata
+#define BOT_FIELD_TICKS 36          // Ticks projetados no campo depois do horizonte
+#define BOT_BUDGET_US 3000.0        // Prazo por decisão (um quarto do frame a 60 FPS menos folga)
+#define BOT_CELL 8                  // Pixels por célula do campo
+#define BOT_FIELD_COLS (GAME_WIDTH / BOT_CELL)
+#define BOT_FIELD_ROWS (GAME_HEIGHT / BOT_CELL)
+
+typedef struct {
+    unsigned int rng;               // Ruído de desempate: tentar de novo não repete a morte
+    unsigned char last;             // Botões escolhidos no tick anterior
+    long decisions;
+    long cutoffs;                   // Decisões que pararam no prazo
+    double totalUs, maxUs;          // Tempo real da decisão
+    double maxCpuUs;                // Pior tempo de CPU da decisão
+    int cols, rows;                 // Células usadas (a caixa da partida)
+    float field[BOT_FIELD_ROWS * BOT_FIELD_COLS];
+} Bot;
+
+void BotInit(Bot *b);
+PlayerInput BotDecide(Bot *b, const Game *g);
+// Entrada do frame inteiro: começa do menu, tenta de novo ao se despedaçar
+// e volta ao menu depois da vitória
+GameInput BotReadInput(Bot *b, const Game *g);
+double BotAvgUs(const Bot *b);
+
+#endif
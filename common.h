@@ -20,6 +20,7 @@ typedef enum {
     LEVEL_REGRET,    // Nível 3 - Arrependimentos
     LEVEL_FEAR,      // Nível 4 - Medos Profundos
     LEVEL_HOPE,      // Nível 5 - Centelha de Esperança
+    LEVEL_BOSS,      // Chefe final - O Coração Partido (PHASE_BOSS)
     LEVEL_COUNT      // Total de níveis
 } GameLevel;
 
@@ -30,6 +31,12 @@ typedef enum {
     MOVE_PLATFORMS   // Movimento em plataformas flutuantes
 } PlayerMoveType;
 
+// Área lógica do jogo e passo fixo da simulação: a lógica não consulta a
+// janela nem o relógio, então reexecutar um tick sempre dá o mesmo resultado
+#define GAME_WIDTH 800
+#define GAME_HEIGHT 600
+#define SIM_DT (1.0f / 60.0f)
+
 // Sem forward declarations - as estruturas são definidas nos seus respectivos arquivos
 
 #endif // COMMON_H
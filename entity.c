@@ -0,0 +1,437 @@
+#include "entity.h"
+#include "quality.h"
+#include "raylib.h"
+#include <math.h>
+#include <stddef.h>
+
+// O dado de cada timer é (id << 2) | tipo
+#define TIMER_LIFETIME 0
+#define TIMER_PULSE 1
+#define TIMER_ARM 2     // Fim do aviso de um feixe
+
+#define BEAM_GLOW 4.0f  // Largura do brilho em relação à do feixe
+
+void EntityStoreInit(EntityStore *es) {
+    TimerWheelInit(&es->timers);
+    es->count = 0;
+    es->freeCount = MAX_ENTITIES;
+    for (int i = 0; i < MAX_ENTITIES; i++) {
+        es->indexOf[i] = -1;
+        es->freeIds[i] = MAX_ENTITIES - 1 - i; // Ids menores saem primeiro
+    }
+}
+
+// Cria uma entidade e devolve o seu id (-1 se o armazenamento estiver cheio)
+int EntitySpawn(EntityStore *es, const EntityDesc *desc) {
+    if (es->freeCount == 0) return -1;
+    
+    int i = es->count++;
+    int id = es->freeIds[--es->freeCount];
+    es->indexOf[id] = i;
+    es->id[i] = id;
+    es->mask[i] = desc->mask;
+    es->look[i] = desc->look;
+    es->rect[i] = SimRectFromRectangle(desc->rect);
+    es->velocity[i] = SimVec2FromVector2(desc->velocity);
+    es->lifetimeTimer[i] = (desc->mask & COMP_LIFETIME) ? TimerWheelSchedule(&es->timers, desc->lifetime, id << 2 | TIMER_LIFETIME) : -1;
+    es->pulseTimer[i] = (desc->mask & COMP_PULSE) ? TimerWheelSchedule(&es->timers, desc->pulseTime, id << 2 | TIMER_PULSE) : -1;
+    es->armTimer[i] = -1;
+    es->pulseOn[i] = true;
+    es->damage[i] = desc->damage;
+    es->bounceForce[i] = SimFromFloat(desc->bounceForce);
+    es->beamPivot[i] = (SimVec2){0, 0};
+    es->beamAngle[i] = es->beamSpin[i] = es->beamReach[i] = es->beamLength[i] = es->beamHalfWidth[i] = 0;
+    es->beam[i] = (SimBeam){ {0, 0}, {0, 0}, 0, 0 };
+    return id;
+}
+
+// Cria um feixe (desc->mask precisa de COMP_BEAM); desligado até o fim do aviso
+int EntitySpawnBeam(EntityStore *es, const EntityDesc *desc, const BeamDesc *beam) {
+    int id = EntitySpawn(es, desc);
+    if (id < 0) return -1;
+    
+    int i = es->indexOf[id];
+    es->beamPivot[i] = SimVec2FromVector2(beam->pivot);
+    es->beamAngle[i] = SimFromFloat(beam->angle);
+    es->beamSpin[i] = SimFromFloat(beam->spin);
+    es->beamReach[i] = SimFromFloat(beam->reach);
+    es->beamLength[i] = SimFromFloat(beam->length);
+    es->beamHalfWidth[i] = SimFromFloat(beam->halfWidth);
+    if (beam->warmup > 0) es->armTimer[i] = TimerWheelSchedule(&es->timers, beam->warmup, id << 2 | TIMER_ARM);
+    return id;
+}
+
+// Remove a entidade do índice denso (a última ocupa o lugar dela)
+void EntityDestroy(EntityStore *es, int index) {
+    int last = --es->count;
+    TimerWheelCancel(&es->timers, es->lifetimeTimer[index]);
+    TimerWheelCancel(&es->timers, es->pulseTimer[index]);
+    TimerWheelCancel(&es->timers, es->armTimer[index]);
+    es->indexOf[es->id[index]] = -1;
+    es->freeIds[es->freeCount++] = es->id[index];
+    
+    if (index != last) {
+        es->mask[index] = es->mask[last];
+        es->id[index] = es->id[last];
+        es->look[index] = es->look[last];
+        es->rect[index] = es->rect[last];
+        es->velocity[index] = es->velocity[last];
+        es->lifetimeTimer[index] = es->lifetimeTimer[last];
+        es->pulseTimer[index] = es->pulseTimer[last];
+        es->armTimer[index] = es->armTimer[last];
+        es->pulseOn[index] = es->pulseOn[last];
+        es->damage[index] = es->damage[last];
+        es->bounceForce[index] = es->bounceForce[last];
+        es->beamPivot[index] = es->beamPivot[last];
+        es->beamAngle[index] = es->beamAngle[last];
+        es->beamSpin[index] = es->beamSpin[last];
+        es->beamReach[index] = es->beamReach[last];
+        es->beamLength[index] = es->beamLength[last];
+        es->beamHalfWidth[index] = es->beamHalfWidth[last];
+        es->beam[index] = es->beam[last];
+        es->indexOf[es->id[index]] = index;
+    }
+}
+
+// Entidades pulsantes só existem fisicamente na metade "ligada" do ciclo,
+// e feixes só depois do aviso (um feixe pulsante precisa das duas coisas)
+int EntityIsSolid(const EntityStore *es, int index) {
+    return es->pulseOn[index] && es->armTimer[index] < 0;
+}
+
+// Move as entidades com velocidade e inverte a direção nas bordas da caixa
+void EntityMoveSystem(EntityStore *es, SimRect battleBox) {
+    for (int i = 0; i < es->count; i++) {
+        if (!(es->mask[i] & COMP_VELOCITY)) continue;
+        
+        SimRect *r = &es->rect[i];
+        r->x += es->velocity[i].x;
+        r->y += es->velocity[i].y;
+        
+        // Inverter direção se atingir os limites da caixa de batalha
+        if (r->x < battleBox.x || r->x + r->width > battleBox.x + battleBox.width) {
+            es->velocity[i].x = -es->velocity[i].x;
+        }
+        if (r->y < battleBox.y || r->y + r->height > battleBox.y + battleBox.height) {
+            es->velocity[i].y = -es->velocity[i].y;
+        }
+    }
+}
+
+// Trata um timer vencido: fim da vida remove a entidade, pulso alterna o
+// estado e o fim do aviso liga o feixe
+static void EntityTimerFired(void *ctx, int data) {
+    EntityStore *es = ctx;
+    int i = es->indexOf[data >> 2];
+    if (i < 0) return;
+    
+    if ((data & 3) == TIMER_LIFETIME) {
+        es->lifetimeTimer[i] = -1;
+        EntityDestroy(es, i);
+    } else if ((data & 3) == TIMER_ARM) {
+        es->armTimer[i] = -1;
+    } else {
+        es->pulseOn[i] = !es->pulseOn[i];
+        es->pulseTimer[i] = TimerWheelSchedule(&es->timers, PULSE_PERIOD, data);
+    }
+}
+
+// Avança a roda de timers: só custa algo quando algum prazo vence
+void EntityTimerSystem(EntityStore *es) {
+    TimerWheelAdvance(&es->timers, EntityTimerFired, es);
+}
+
+// Gira e arrasta os feixes e refaz a geometria do tick: direção, centro e a
+// caixa envolvente em rect (o seno/cosseno sai uma vez por feixe aqui, e o
+// teste de colisão só usa produtos)
+void EntityBeamSystem(EntityStore *es) {
+    for (int i = 0; i < es->count; i++) {
+        if (!(es->mask[i] & COMP_BEAM)) continue;
+        
+        es->beamPivot[i].x += es->velocity[i].x;
+        es->beamPivot[i].y += es->velocity[i].y;
+        es->beamAngle[i] += es->beamSpin[i];
+        if (es->beamAngle[i] > SIM(PI)) es->beamAngle[i] -= SIM(2 * PI);
+        if (es->beamAngle[i] < SIM(-PI)) es->beamAngle[i] += SIM(2 * PI);
+        
+        SimBeam *b = &es->beam[i];
+        b->dir = (SimVec2){ SimCos(es->beamAngle[i]), SimSin(es->beamAngle[i]) };
+        b->halfLength = es->beamLength[i] / 2;
+        b->halfWidth = es->beamHalfWidth[i];
+        sim_t along = es->beamReach[i] + b->halfLength;
+        b->center = (SimVec2){ es->beamPivot[i].x + SimMul(b->dir.x, along), es->beamPivot[i].y + SimMul(b->dir.y, along) };
+        
+        sim_t ex = SimMul(b->halfLength, SimAbs(b->dir.x)) + SimMul(b->halfWidth, SimAbs(b->dir.y));
+        sim_t ey = SimMul(b->halfLength, SimAbs(b->dir.y)) + SimMul(b->halfWidth, SimAbs(b->dir.x));
+        es->rect[i] = (SimRect){ b->center.x - ex, b->center.y - ey, 2 * ex, 2 * ey };
+    }
+}
+
+// Dano da primeira entidade perigosa que toca a hitbox (0 se nenhuma)
+int EntityDamageSystem(const EntityStore *es, const SimRect *playerHitbox) {
+    for (int i = 0; i < es->count; i++) {
+        if (!(es->mask[i] & COMP_DAMAGE) || !EntityIsSolid(es, i)) continue;
+        
+        int touching = (es->mask[i] & COMP_BEAM) ? SimBeamGap(&es->beam[i], playerHitbox) < 0
+                                                 : SimRectOverlap(playerHitbox, &es->rect[i]);
+        if (touching) return es->damage[i];
+    }
+    return 0;
+}
+
+// Copia o que o desenho precisa das entidades sólidas (e dos feixes ainda
+// no aviso); retorna quantas
+int EntityExtract(const EntityStore *es, EntityDrawItem *out) {
+    int n = 0;
+    for (int i = 0; i < es->count; i++) {
+        int beam = (es->mask[i] & COMP_BEAM) != 0;
+        if (!beam && !EntityIsSolid(es, i)) continue;
+        
+        EntityDrawItem *e = &out[n++];
+        e->rect = SimRectToRectangle(es->rect[i]);
+        e->velocity = SimVec2ToVector2(es->velocity[i]);
+        e->look = es->look[i];
+        e->platform = (es->mask[i] & COMP_PLATFORM) != 0;
+        e->moving = (es->mask[i] & COMP_VELOCITY) != 0;
+        e->expiring = (es->mask[i] & COMP_LIFETIME) && TimerWheelRemaining(&es->timers, es->lifetimeTimer[i]) < 60;
+        e->fade = (es->mask[i] & COMP_PULSE) ? (float)TimerWheelRemaining(&es->timers, es->pulseTimer[i]) / PULSE_PERIOD : 1.0f;
+        e->beam = beam;
+        e->warning = beam && !EntityIsSolid(es, i);
+        e->beamFrom = e->beamTo = (Vector2){0, 0};
+        e->beamHalfWidth = 0;
+        if (beam) {
+            const SimBeam *b = &es->beam[i];
+            Vector2 center = SimVec2ToVector2(b->center), dir = SimVec2ToVector2(b->dir);
+            float half = SimToFloat(b->halfLength);
+            e->beamFrom = (Vector2){ center.x - dir.x * half, center.y - dir.y * half };
+            e->beamTo = (Vector2){ center.x + dir.x * half, center.y + dir.y * half };
+            e->beamHalfWidth = SimToFloat(b->halfWidth);
+            e->fade = 1.0f;
+        }
+    }
+    return n;
+}
+
+// Aplica a transparência de entidades pulsantes à cor base
+static Color EntityTint(const EntityDrawItem *e, Color color) {
+    color.a = (unsigned char)(color.a * e->fade);
+    return color;
+}
+
+static void DrawPlatformLook(const EntityDrawItem *e) {
+    Rectangle rect = e->rect;
+    Color platformColor = WHITE;
+    
+    // Cores diferentes para cada tipo de plataforma
+    switch ((PlatformType)e->look) {
+        case PLATFORM_NORMAL:
+            platformColor = (Color){100, 200, 100, 255}; // Verde para plataformas normais
+            break;
+            
+        case PLATFORM_MOVING:
+            platformColor = (Color){100, 100, 200, 255}; // Azul para plataformas móveis
+            break;
+            
+        case PLATFORM_TEMPORARY:
+            platformColor = (Color){200, 100, 100, 200}; // Vermelho para plataformas temporárias
+            break;
+            
+        case PLATFORM_BOUNCE: {
+            // Efeito pulsante para plataformas de salto
+            float pulse = sinf(GetTime() * 5.0f) * 0.3f + 0.7f;
+            platformColor = (Color){200, 200, 0, (unsigned char)(200 * pulse)}; // Amarelo para plataformas de salto
+            break;
+        }
+    }
+    
+    // Piscar quando estiver prestes a desaparecer
+    if (e->expiring) {
+        platformColor.a = 128 + (int)(sinf(GetTime() * 10.0f) * 127.0f);
+    }
+    
+    // Desenhar plataforma com bordas arredondadas
+    DrawRectangleRounded(rect, 0.3f, 8, EntityTint(e, platformColor));
+    
+    // Adicionar detalhes visuais
+    if (e->look == PLATFORM_BOUNCE) {
+        // Setas para cima indicando plataforma de salto
+        float centerX = rect.x + rect.width / 2;
+        float topY = rect.y - 5;
+        DrawTriangle(
+            (Vector2){centerX - 10, topY},
+            (Vector2){centerX + 10, topY},
+            (Vector2){centerX, topY - 15},
+            YELLOW
+        );
+    }
+}
+
+static void DrawObstacleLook(const EntityDrawItem *e) {
+    Rectangle rect = e->rect;
+    
+    switch ((ObstacleType)e->look) {
+        case OBSTACLE_SPIKE: {
+            // Desenhar espinhos
+            float baseY = rect.y + rect.height;
+            int spikes = (int)(rect.width / 10);
+            float spikeWidth = rect.width / spikes;
+            Color spikeColor = EntityTint(e, RED);
+            
+            for (int j = 0; j < spikes; j++) {
+                DrawTriangle(
+                    (Vector2){rect.x + j * spikeWidth, baseY},
+                    (Vector2){rect.x + (j + 1) * spikeWidth, baseY},
+                    (Vector2){rect.x + (j + 0.5f) * spikeWidth, baseY - rect.height},
+                    spikeColor
+                );
+            }
+            break;
+        }
+            
+        case OBSTACLE_LASER: {
+            // Desenhar laser com efeito de brilho
+            float pulse = sinf(GetTime() * 10.0f) * 0.3f + 0.7f;
+            DrawRectangleRec(rect, EntityTint(e, (Color){255, 50, 50, (unsigned char)(200 * pulse)}));
+            
+            // Adicionar efeito de brilho no centro
+            Rectangle innerRect = {
+                rect.x + rect.width * 0.25f,
+                rect.y + rect.height * 0.25f,
+                rect.width * 0.5f,
+                rect.height * 0.5f
+            };
+            DrawRectangleRec(innerRect, EntityTint(e, (Color){255, 200, 200, (unsigned char)(180 * pulse)}));
+            break;
+        }
+            
+        case OBSTACLE_MOVING:
+            // Desenhar obstáculo móvel
+            DrawRectangleRec(rect, EntityTint(e, (Color){200, 50, 200, 200}));
+            break;
+            
+        case OBSTACLE_PULSE:
+            // Desenhar obstáculo pulsante com efeito de fade
+            DrawRectangleRec(rect, EntityTint(e, (Color){255, 100, 0, 200}));
+            break;
+    }
+    
+    // Adicionar setas indicando direção do movimento
+    if (e->moving) {
+        Vector2 vel = e->velocity;
+        float centerX = rect.x + rect.width / 2;
+        float centerY = rect.y + rect.height / 2;
+        
+        if (fabsf(vel.x) > fabsf(vel.y)) {
+            // Movimento horizontal
+            float arrowDir = vel.x > 0 ? 1.0f : -1.0f;
+            DrawTriangle(
+                (Vector2){centerX, centerY - 5},
+                (Vector2){centerX, centerY + 5},
+                (Vector2){centerX + arrowDir * 10, centerY},
+                WHITE
+            );
+        } else {
+            // Movimento vertical
+            float arrowDir = vel.y > 0 ? 1.0f : -1.0f;
+            DrawTriangle(
+                (Vector2){centerX - 5, centerY},
+                (Vector2){centerX + 5, centerY},
+                (Vector2){centerX, centerY + arrowDir * 10},
+                WHITE
+            );
+        }
+    }
+}
+
+// Brilho do feixe: 1 no eixo, caindo até a borda do quad (fragTexCoord.y
+// atravessa o feixe); as pontas esmaecem um pouco
+static const char *beamGlowShader =
+    "#version 330\n"
+    "in vec2 fragTexCoord;\n"
+    "in vec4 fragColor;\n"
+    "out vec4 finalColor;\n"
+    "void main() {\n"
+    "    float across = abs(fragTexCoord.y - 0.5) * 2.0;\n"
+    "    float core = 1.0 - smoothstep(0.18, 0.28, across);\n"
+    "    float glow = exp(-5.0 * across * across) * 0.7;\n"
+    "    float ends = smoothstep(0.0, 0.03, fragTexCoord.x) * smoothstep(1.0, 0.97, fragTexCoord.x);\n"
+    "    vec3 color = mix(fragColor.rgb, vec3(1.0), core * 0.8);\n"
+    "    finalColor = vec4(color, (core + glow) * fragColor.a * ends);\n"
+    "}\n";
+
+// Shader e textura 1x1 criados no primeiro feixe desenhado (precisam do
+// contexto de GL, que só existe na thread de desenho). Se o shader não
+// compilar, a raylib devolve o padrão e o feixe sai como um quad liso.
+static Shader beamShader;
+static Texture2D beamTexture;
+static bool beamResourcesReady = false;
+
+static void LoadBeamResources(void) {
+    Image white = GenImageColor(1, 1, WHITE);
+    beamTexture = LoadTextureFromImage(white);
+    UnloadImage(white);
+    beamShader = LoadShaderFromMemory(NULL, beamGlowShader);
+    beamResourcesReady = true;
+}
+
+void EntityUnloadResources(void) {
+    if (!beamResourcesReady) return;
+    UnloadShader(beamShader);
+    UnloadTexture(beamTexture);
+    beamResourcesReady = false;
+}
+
+// Um quad por feixe: o retângulo de beamFrom a beamTo com BEAM_GLOW vezes a
+// largura, girado, e o brilho todo no shader
+static void DrawBeamGlow(const EntityDrawItem *e) {
+    float dx = e->beamTo.x - e->beamFrom.x, dy = e->beamTo.y - e->beamFrom.y;
+    float length = sqrtf(dx * dx + dy * dy);
+    float width = e->beamHalfWidth * 2.0f * BEAM_GLOW;
+    Vector2 center = { (e->beamFrom.x + e->beamTo.x) / 2, (e->beamFrom.y + e->beamTo.y) / 2 };
+    float pulse = sinf(GetTime() * 20.0f) * 0.1f + 0.9f;
+    DrawTexturePro(beamTexture, (Rectangle){0, 0, 1, 1}, (Rectangle){center.x, center.y, length, width},
+                   (Vector2){length / 2, width / 2}, atan2f(dy, dx) * RAD2DEG,
+                   (Color){255, 40, 60, (unsigned char)(255 * pulse)});
+}
+
+// Aviso: linha fina piscando onde o feixe vai ligar
+static void DrawBeamWarning(const EntityDrawItem *e) {
+    unsigned char alpha = (unsigned char)(90 + sinf(GetTime() * 30.0f) * 60.0f);
+    DrawLineEx(e->beamFrom, e->beamTo, 1.5f, (Color){255, 80, 80, alpha});
+}
+
+// Desenha todas as entidades visíveis; os feixes ligados vão juntos num
+// bloco só de shader e mistura aditiva
+void EntityDrawSystem(const EntityDrawItem *items, int count) {
+    int beams = 0;
+    for (int i = 0; i < count; i++) {
+        if (items[i].beam) {
+            if (items[i].warning) DrawBeamWarning(&items[i]);
+            else beams++;
+        } else if (items[i].platform) {
+            DrawPlatformLook(&items[i]);
+        } else {
+            DrawObstacleLook(&items[i]);
+        }
+    }
+    if (beams == 0) return;
+    
+    // Qualidade baixa: só o núcleo, sem brilho
+    if (QualityCurrent() >= QUALITY_LOW) {
+        for (int i = 0; i < count; i++) {
+            if (items[i].beam && !items[i].warning) {
+                DrawLineEx(items[i].beamFrom, items[i].beamTo, items[i].beamHalfWidth * 2, (Color){255, 120, 130, 255});
+            }
+        }
+        return;
+    }
+    
+    if (!beamResourcesReady) LoadBeamResources();
+    BeginBlendMode(BLEND_ADDITIVE);
+    BeginShaderMode(beamShader);
+    for (int i = 0; i < count; i++) {
+        if (items[i].beam && !items[i].warning) DrawBeamGlow(&items[i]);
+    }
+    EndShaderMode();
+    EndBlendMode();
+}
@@ -0,0 +1,125 @@
+#ifndef ENTITY_H
+#define ENTITY_H
+#include "raylib.h"
+#include "utils.h"
+#include "fixed.h"
+
+// Armazenamento em componentes para plataformas e obstáculos: cada entidade
+// tem um retângulo (transform) e uma máscara dizendo quais componentes usa.
+// Os arrays são densos (entidades vivas em [0, count)) e os sistemas só
+// olham as entidades que têm os componentes de que precisam.
+
+#define MAX_ENTITIES 48
+
+// Componentes opcionais de uma entidade
+typedef enum {
+    COMP_VELOCITY = 1 << 0,  // Move e rebate nas bordas da caixa de batalha
+    COMP_LIFETIME = 1 << 1,  // Desaparece após um tempo
+    COMP_PULSE    = 1 << 2,  // Liga e desliga periodicamente
+    COMP_DAMAGE   = 1 << 3,  // Causa dano ao tocar
+    COMP_PLATFORM = 1 << 4,  // O jogador pode ficar em pé em cima
+    COMP_BEAM     = 1 << 5   // Feixe orientado que gira e varre (o retângulo é só a caixa envolvente)
+} EntityComponent;
+
+// Tipos de plataformas para o modo estilo Undertale
+typedef enum {
+    PLATFORM_NORMAL,    // Plataforma normal para ficar em pé
+    PLATFORM_MOVING,    // Plataforma que se move
+    PLATFORM_TEMPORARY, // Plataforma que desaparece após um tempo
+    PLATFORM_BOUNCE     // Plataforma que faz o jogador pular mais alto
+} PlatformType;
+
+// Tipos de obstáculos para o modo estilo Undertale
+typedef enum {
+    OBSTACLE_SPIKE,     // Espinhos que causam dano ao tocar
+    OBSTACLE_LASER,     // Laser que causa dano ao tocar
+    OBSTACLE_MOVING,    // Obstáculo que se move em um padrão
+    OBSTACLE_PULSE      // Obstáculo que pulsa (aparece e desaparece)
+} ObstacleType;
+
+#define PULSE_PERIOD 60  // Frames em cada estado de um obstáculo pulsante
+
+// Descrição usada para criar uma entidade (campos sem componente são ignorados).
+// Vem em float e é convertida para o escalar da simulação ao criar.
+typedef struct {
+    unsigned int mask;
+    int look;            // PlatformType se COMP_PLATFORM, senão ObstacleType
+    Rectangle rect;
+    Vector2 velocity;
+    int lifetime;
+    int pulseTime;
+    int damage;
+    float bounceForce;
+} EntityDesc;
+
+// Feixe de laser (COMP_BEAM). Vai de pivot + reach até pivot + reach +
+// length na direção do ângulo; o pivô anda com a velocidade da entidade.
+// Durante o aviso o feixe aparece mas não é sólido.
+typedef struct {
+    Vector2 pivot;
+    float angle, spin;      // Radianos e radianos por tick
+    float reach, length;    // reach negativo centraliza o feixe no pivô
+    float halfWidth;
+    int warmup;             // Ticks de aviso antes de ligar
+} BeamDesc;
+
+typedef struct {
+    int count;
+    unsigned int mask[MAX_ENTITIES];
+    int id[MAX_ENTITIES];          // Identificador estável (sobrevive à compactação)
+    int look[MAX_ENTITIES];
+    SimRect rect[MAX_ENTITIES];
+    SimVec2 velocity[MAX_ENTITIES];     // Pixels por tick
+    int lifetimeTimer[MAX_ENTITIES];  // Handle na roda de timers (fim da vida)
+    int pulseTimer[MAX_ENTITIES];     // Handle na roda de timers (próxima troca)
+    int armTimer[MAX_ENTITIES];       // Handle na roda de timers (fim do aviso do feixe)
+    bool pulseOn[MAX_ENTITIES];
+    int damage[MAX_ENTITIES];
+    sim_t bounceForce[MAX_ENTITIES];
+    
+    // Feixes: parâmetros e a geometria do tick (refeita por EntityBeamSystem)
+    SimVec2 beamPivot[MAX_ENTITIES];
+    sim_t beamAngle[MAX_ENTITIES], beamSpin[MAX_ENTITIES];
+    sim_t beamReach[MAX_ENTITIES], beamLength[MAX_ENTITIES], beamHalfWidth[MAX_ENTITIES];
+    SimBeam beam[MAX_ENTITIES];
+    
+    int indexOf[MAX_ENTITIES];     // id -> índice denso (-1 se livre)
+    int freeIds[MAX_ENTITIES];
+    int freeCount;
+    
+    // Fim de vida, trocas de pulso e fim do aviso são eventos agendados, não contadores
+    TimerWheel timers;
+} EntityStore;
+
+void EntityStoreInit(EntityStore *es);
+int EntitySpawn(EntityStore *es, const EntityDesc *desc);
+int EntitySpawnBeam(EntityStore *es, const EntityDesc *desc, const BeamDesc *beam);
+void EntityDestroy(EntityStore *es, int index);
+int EntityIsSolid(const EntityStore *es, int index);
+
+// Sistemas
+void EntityMoveSystem(EntityStore *es, SimRect battleBox);
+void EntityTimerSystem(EntityStore *es);
+void EntityBeamSystem(EntityStore *es);
+int EntityDamageSystem(const EntityStore *es, const SimRect *playerHitbox);
+// Visão de desenho de uma entidade sólida, copiada do store a cada frame:
+// o desenho roda em outra thread e não pode ler o store vivo
+typedef struct {
+    Rectangle rect;
+    Vector2 velocity;
+    int look;
+    bool platform;
+    bool moving;        // Tem velocidade (desenha a seta de direção)
+    bool expiring;      // Menos de 60 frames de vida restantes
+    float fade;         // Opacidade do pulso (1 = sem pulso)
+    bool beam;          // Feixe: desenhado de beamFrom a beamTo, sem o retângulo
+    bool warning;       // Feixe ainda no aviso (sem dano)
+    Vector2 beamFrom, beamTo;
+    float beamHalfWidth;
+} EntityDrawItem;
+
+int EntityExtract(const EntityStore *es, EntityDrawItem *out);
+void EntityDrawSystem(const EntityDrawItem *items, int count);
+void EntityUnloadResources(void);   // Shader e textura dos feixes (antes do CloseWindow)
+
+#endif
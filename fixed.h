@@ -0,0 +1,116 @@
+#ifndef FIXED_H
+#define FIXED_H
+#include "raylib.h"
+#include <stdint.h>
+#include <math.h>
+
+// Ponto fixo Q16.16 (16 bits de parte inteira, 16 de fração). Só usa
+// aritmética inteira, então o resultado é o mesmo em qualquer compilador,
+// flag de otimização (-O0, -O2, -ffast-math) ou CPU.
+typedef int32_t fixed;
+#define FIXED_SHIFT 16
+#define FIXED_ONE (1 << FIXED_SHIFT)
+#define FIXED_CONST(x) ((fixed)((x) * 65536.0 + ((x) >= 0 ? 0.5 : -0.5)))   // Só para constantes
+
+static inline fixed FixedMul(fixed a, fixed b) { return (fixed)(((int64_t)a * b) >> FIXED_SHIFT); }
+static inline fixed FixedDiv(fixed a, fixed b) { return (fixed)(((int64_t)a * FIXED_ONE) / b); }
+static inline fixed FixedFromFloat(float f) { return (fixed)(f * 65536.0f + (f >= 0 ? 0.5f : -0.5f)); }
+static inline float FixedToFloat(fixed f) { return f / 65536.0f; }
+
+// Seno e cosseno por tabela (ângulo em radianos Q16.16)
+fixed FixedSin(fixed radians);
+fixed FixedCos(fixed radians);
+fixed FixedLength(fixed x, fixed y);    // Módulo do vetor (x, y)
+
+// Escalar do estado de jogo (jogador, projéteis, plataformas, obstáculos).
+// Com SIM_FIXED (make FIXED=1) é Q16.16 e replays/sessões em rede batem
+// entre builds diferentes; sem ele é float, como sempre foi. O desenho
+// continua em float e converte na hora de extrair o frame.
+#ifdef SIM_FIXED
+typedef fixed sim_t;
+#define SIM(x) FIXED_CONST(x)
+#define SimMul FixedMul
+#define SimDiv FixedDiv
+#define SimFromFloat FixedFromFloat
+#define SimToFloat FixedToFloat
+#define SimSin FixedSin
+#define SimCos FixedCos
+#define SimLength FixedLength
+static inline sim_t SimFromInt(int i) { return (sim_t)(i * FIXED_ONE); }
+static inline int SimToInt(sim_t s) { return s / FIXED_ONE; }
+// v fora de [lo, hi]: em inteiro, uma comparação sem sinal cobre os dois lados
+static inline int SimOutside(sim_t v, sim_t lo, sim_t hi) { return (uint32_t)(v - lo) > (uint32_t)(hi - lo); }
+// num / den sem passar por SimFromInt(num), que estoura com num >= 32768
+static inline sim_t SimFromRatio(int num, int den) { return SimFromInt(num / den) + FixedDiv(SimFromInt(num % den), SimFromInt(den)); }
+#else
+typedef float sim_t;
+#define SIM(x) ((float)(x))
+#define SimSin sinf
+#define SimCos cosf
+static inline sim_t SimLength(sim_t x, sim_t y) { return sqrtf(x * x + y * y); }
+static inline sim_t SimMul(sim_t a, sim_t b) { return a * b; }
+static inline sim_t SimDiv(sim_t a, sim_t b) { return a / b; }
+static inline sim_t SimFromFloat(float f) { return f; }
+static inline float SimToFloat(sim_t s) { return s; }
+static inline sim_t SimFromInt(int i) { return (sim_t)i; }
+static inline int SimToInt(sim_t s) { return (int)s; }
+static inline int SimOutside(sim_t v, sim_t lo, sim_t hi) { return v < lo || v > hi; }
+static inline sim_t SimFromRatio(int num, int den) { return (sim_t)num / den; }
+#endif
+
+static inline sim_t SimAbs(sim_t s) { return s < 0 ? -s : s; }
+
+// atan2 aproximado só com produtos e uma divisão (erro < 0,005 rad), para
+// que mirar dê o mesmo ângulo em qualquer build
+static inline sim_t SimAtan2(sim_t y, sim_t x) {
+    sim_t ax = SimAbs(x), ay = SimAbs(y);
+    if (ax == 0 && ay == 0) return 0;
+    int steep = ay > ax;
+    sim_t z = steep ? SimDiv(ax, ay) : SimDiv(ay, ax);     // Em [0, 1]
+    sim_t a = SimMul(z, SIM(PI / 4)) + SimMul(SimMul(z, SIM(1) - z), SIM(0.273));
+    if (steep) a = SIM(PI / 2) - a;
+    if (x < 0) a = SIM(PI) - a;
+    return y < 0 ? -a : a;
+}
+
+typedef struct { sim_t x, y; } SimVec2;
+typedef struct { sim_t x, y, width, height; } SimRect;
+
+// Feixe (retângulo orientado): centro, direção unitária ao longo do feixe,
+// meio comprimento e meia largura
+typedef struct { SimVec2 center, dir; sim_t halfLength, halfWidth; } SimBeam;
+
+static inline SimVec2 SimVec2FromVector2(Vector2 v) { return (SimVec2){ SimFromFloat(v.x), SimFromFloat(v.y) }; }
+static inline Vector2 SimVec2ToVector2(SimVec2 v) { return (Vector2){ SimToFloat(v.x), SimToFloat(v.y) }; }
+static inline SimRect SimRectFromRectangle(Rectangle r) {
+    return (SimRect){ SimFromFloat(r.x), SimFromFloat(r.y), SimFromFloat(r.width), SimFromFloat(r.height) };
+}
+static inline Rectangle SimRectToRectangle(SimRect r) {
+    return (Rectangle){ SimToFloat(r.x), SimToFloat(r.y), SimToFloat(r.width), SimToFloat(r.height) };
+}
+
+// Mesmo teste de CheckCollisionRecs
+static inline int SimRectOverlap(const SimRect *a, const SimRect *b) {
+    return a->x < b->x + b->width && a->x + a->width > b->x &&
+           a->y < b->y + b->height && a->y + a->height > b->y;
+}
+
+// Maior separação entre o feixe e o retângulo nos eixos do teorema do eixo
+// separador (x, y, direção e normal do feixe). Negativa só quando se
+// sobrepõem, zero quando encostam: a mesma convenção da folga entre
+// retângulos, com uns poucos produtos por feixe.
+static inline sim_t SimBeamGap(const SimBeam *b, const SimRect *r) {
+    sim_t ex = r->width / 2, ey = r->height / 2;
+    sim_t dx = r->x + ex - b->center.x, dy = r->y + ey - b->center.y;
+    sim_t ux = SimAbs(b->dir.x), uy = SimAbs(b->dir.y);
+    sim_t gap = SimAbs(dx) - (SimMul(b->halfLength, ux) + SimMul(b->halfWidth, uy) + ex);
+    sim_t g = SimAbs(dy) - (SimMul(b->halfLength, uy) + SimMul(b->halfWidth, ux) + ey);
+    if (g > gap) gap = g;
+    g = SimAbs(SimMul(dx, b->dir.x) + SimMul(dy, b->dir.y)) - (b->halfLength + SimMul(ex, ux) + SimMul(ey, uy));
+    if (g > gap) gap = g;
+    g = SimAbs(SimMul(dy, b->dir.x) - SimMul(dx, b->dir.y)) - (b->halfWidth + SimMul(ex, uy) + SimMul(ey, ux));
+    if (g > gap) gap = g;
+    return gap;
+}
+
+#endif
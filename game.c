@@ -2,15 +2,119 @@
 #include "player.h" // Incluir para definição completa de Player
 #include "attack.h" // Incluir para definição completa de AttackManager
 #include "hud.h"
+#include "pattern.h"
 #include "utils.h"
+#include "loader.h"
+#include "pack.h"
+#include "quality.h"
+#include "spatial.h"
+#include "alloctrack.h"
+#include "telemetry.h"
 #include <math.h>
+#include <stddef.h>
 #include <stdio.h>
+#include <string.h>
+
+#define TRANSITION_FRAMES 120   // Duração da transição entre níveis (2 segundos)
+#define TAUNT_INTERVAL 500      // Frames entre mensagens perturbadoras
+#define WIN_FRAME 3001          // Vitória ao sobreviver mais de 3000 frames
+#define MOVE_CHANGE_INTERVAL 200 // Duração de cada tipo de movimento em LEVEL_HOPE
+#define MUSIC_FILE "Condemned Tower - Castlevania Dawn of Sorrow OST.mp3"
+#define MUSIC_VOLUME 0.5f       // Volume final da música
+#define MUSIC_FADE_STEP 0.005f  // Aumento de volume por frame no fade-in (~1,7 s)
+#define GRAZE_RADIUS SIM(12)    // Folga máxima da hitbox até a ameaça para contar raspão
+#define GRAZE_INTERVAL 6        // Ticks seguidos de raspão entre dois bônus
+#define GRAZE_POINTS 5          // Bônus de pontuação por raspão
+#define GRAZE_FLASH_FRAMES 12   // Duração das faíscas em volta do coração
+#define GRAZE_BOSS_DAMAGE 20    // Vida que cada raspão tira do chefe
+
+// Checkpoints capturados no início de cada nível (reinício e treino)
+static GameCheckpoints gameCheckpoints;
+static GameCheckpoints *checkpoints = &gameCheckpoints;
+static unsigned int checkpointCaptures = 0;
+
+// Grade das ameaças do tick atual, refeita depois que os ataques se movem.
+// Não faz parte do estado: cada tick a reconstrói antes de consultar.
+static ThreatGrid threatGrid;
+
+// Tipo de movimento do jogador em cada nível
+static PlayerMoveType LevelMoveType(GameLevel level, int frame) {
+    switch (level) {
+        case LEVEL_MEMORY:
+            // Movimento estilo Undertale - fixo ao chão com pulo
+            return MOVE_PLATFORMER;
+            
+        case LEVEL_FEAR:
+            // Movimento em plataformas flutuantes
+            return MOVE_PLATFORMS;
+            
+        case LEVEL_HOPE:
+            // Alterna entre todos os tipos para o desafio final
+            if (frame % 600 < 200) return MOVE_FREE;
+            if (frame % 600 < 400) return MOVE_PLATFORMER;
+            return MOVE_PLATFORMS;
+            
+        default:
+            // LEVEL_VOID e LEVEL_REGRET usam movimento livre tradicional
+            return MOVE_FREE;
+    }
+}
+
+// Agenda o próximo ponto em que a porcentagem de progresso muda.
+// A pontuação cresce 1 por frame de batalha, então o frame é calculável
+// (os bônus de raspão reagendam, ver RescheduleScoreEvents).
+static void ScheduleProgress(Game *g) {
+    int span = g->levelEndScore - g->levelStartScore;
+    if (g->levelProgress >= 100 || span <= 0) return;
+    
+    int needed = ((g->levelProgress + 1) * span + 99) / 100; // Menor avanço com a próxima porcentagem
+    int gained = g->score - g->levelStartScore;
+    EventQueuePush(&g->events, g->frameCount + needed - gained, EVENT_PROGRESS);
+}
+
+// A pontuação pulou (bônus de raspão): refaz só os eventos que dependem dela
+static void RescheduleScoreEvents(Game *g) {
+    EventQueue kept;
+    EventQueueClear(&kept);
+    for (int i = 0; i < g->events.count; i++) {
+        ScheduledEvent ev = g->events.heap[i];
+        if (ev.type != EVENT_PROGRESS && ev.type != EVENT_LEVEL_COMPLETE) EventQueuePush(&kept, ev.frame, ev.type);
+    }
+    g->events = kept;
+    
+    ScheduleProgress(g);
+    EventQueuePush(&g->events, g->frameCount + g->levelEndScore - g->score, EVENT_LEVEL_COMPLETE);
+}
+
+// Agenda todos os eventos do nível a partir do frame atual
+static void ScheduleLevelEvents(Game *g) {
+    EventQueueClear(&g->events);
+    
+    // O chefe só termina quando a vida dele acaba (ver BossUpdate)
+    int boss = g->currentLevel == LEVEL_BOSS;
+    if (!boss) {
+        ScheduleProgress(g);
+        EventQueuePush(&g->events, g->frameCount + g->levelEndScore - g->score, EVENT_LEVEL_COMPLETE);
+    }
+    
+    if (g->currentLevel == LEVEL_HOPE) {
+        EventQueuePush(&g->events, (g->frameCount / MOVE_CHANGE_INTERVAL + 1) * MOVE_CHANGE_INTERVAL, EVENT_MOVE_CHANGE);
+    }
+    
+    int nextTaunt = (g->frameCount + TAUNT_INTERVAL - 1) / TAUNT_INTERVAL * TAUNT_INTERVAL;
+    EventQueuePush(&g->events, nextTaunt > 0 ? nextTaunt : TAUNT_INTERVAL, EVENT_TAUNT);
+    if (!boss) EventQueuePush(&g->events, g->frameCount < WIN_FRAME ? WIN_FRAME : g->frameCount, EVENT_WIN);
+}
 
 // Configuração de um nível específico
 void SetupLevel(Game *g, GameLevel level) {
     g->currentLevel = level;
     g->levelProgress = 0;
     g->levelStartScore = g->score;
+    TelemetryEmit(TELEMETRY_LEVEL_START, level, 0, 0, 0, g->score);
+    
+    // Pré-calcular os padrões de disparo usados neste nível
+    PatternCachePrepare(level);
     
     // Configurações específicas para cada nível
     switch (level) {
@@ -59,51 +163,264 @@ void SetupLevel(Game *g, GameLevel level) {
             HUDShowMessage("Nível Final: Centelha de Esperança", 180);
             break;
             
+        case LEVEL_BOSS:
+            // Chefe final - sem pontuação alvo, a caixa vira arena de milhares de projéteis
+            g->levelEndScore = g->levelStartScore;
+            g->bgColorTop = (Color){35, 0, 8, 255};
+            g->bgColorBottom = (Color){5, 0, 5, 255};
+            g->effectIntensity = 1.0f;
+            g->phase = PHASE_BOSS;
+            BossStart(&g->boss, &g->attacks, g->battleBox);
+            HUDShowMessage("Chefe: O Coração Partido", 180);
+            break;
+            
         default:
             break;
     }
+    
+    g->player.moveType = LevelMoveType(level, g->frameCount);
+    ScheduleLevelEvents(g);
+    
+    // Guardar o início do nível para "tentar de novo"
+    GameSnapshotCapture(g, &checkpoints->level[level]);
+    checkpoints->valid[level] = 1;
+    checkpoints->serial[level] = ++checkpointCaptures;
+}
+
+const GameSnapshot *GameCheckpointGet(GameLevel level, unsigned int *serial) {
+    *serial = checkpoints->valid[level] ? checkpoints->serial[level] : 0;
+    return checkpoints->valid[level] ? &checkpoints->level[level] : NULL;
+}
+
+void GameCheckpointSet(GameLevel level, const GameSnapshot *s) {
+    checkpoints->valid[level] = s != NULL;
+    if (s) {
+        GameSnapshotCopy(&checkpoints->level[level], s);
+        checkpoints->serial[level] = ++checkpointCaptures;
+    }
+}
+
+GameCheckpoints *GameUseCheckpoints(GameCheckpoints *set) {
+    GameCheckpoints *previous = checkpoints;
+    checkpoints = set ? set : &gameCheckpoints;
+    return previous;
+}
+
+// Bytes do Game até o último projétil vivo (o pool é o fim da estrutura)
+static size_t GameLiveBytes(const Game *g) {
+    return offsetof(Game, attacks.projectiles) + (size_t)g->attacks.streamStart[ATK_COUNT] * sizeof(Projectile);
+}
+
+void GameCopy(Game *dst, const Game *src) {
+    memcpy(dst, src, GameLiveBytes(src));
+}
+
+int GameSnapshotBytes(const GameSnapshot *s) {
+    int live = s->game.attacks.streamStart[ATK_COUNT];
+    if (live < 0 || live > MAX_PROJECTILES) return 0;
+    return (int)(offsetof(GameSnapshot, game) + GameLiveBytes(&s->game));
+}
+
+void GameSnapshotCopy(GameSnapshot *dst, const GameSnapshot *src) {
+    memcpy(dst, src, GameSnapshotBytes(src));
+}
+
+void GameSnapshotCapture(const Game *g, GameSnapshot *s) {
+    s->version = GAME_SNAPSHOT_VERSION;
+    s->size = sizeof(Game);
+    GameCopy(&s->game, g);
+    
+    // Áudio fica de fora: pertence ao processo, não à partida
+    memset(&s->game.bgMusic, 0, sizeof(s->game.bgMusic));
+    s->game.musicLoaded = 0;
+    s->game.musicVolume = 0.0f;
+    s->game.musicPlaying = 0;
+    s->game.audioResetCounter = 0;
+}
+
+// Restaura a partida mantendo o áudio atual (0 se a cópia for incompatível)
+int GameSnapshotRestore(Game *g, const GameSnapshot *s) {
+    if (s->version != GAME_SNAPSHOT_VERSION || s->size != sizeof(Game) || GameSnapshotBytes(s) == 0) return 0;
+    
+    Music bgMusic = g->bgMusic;
+    int musicLoaded = g->musicLoaded;
+    float musicVolume = g->musicVolume;
+    int musicPlaying = g->musicPlaying;
+    int audioResetCounter = g->audioResetCounter;
+    
+    GameCopy(g, &s->game);
+    
+    g->bgMusic = bgMusic;
+    g->musicLoaded = musicLoaded;
+    g->musicVolume = musicVolume;
+    g->musicPlaying = musicPlaying;
+    g->audioResetCounter = audioResetCounter;
+    return 1;
+}
+
+// Posiciona os corações: no centro, ou lado a lado no modo cooperativo
+static void GameInitHearts(Game *g) {
+    Vector2 center = {g->battleBox.x + g->battleBox.width/2, g->battleBox.y + g->battleBox.height/2};
+    float spread = g->coop ? 40.0f : 0.0f;
+    
+    PlayerInit(&g->player, (Vector2){center.x - spread, center.y});
+    PlayerInit(&g->partner, (Vector2){center.x + spread, center.y});
+    g->partner.slot = 1;
+}
+
+// Reinicia a partida no início do nível: usa o checkpoint se houver,
+// senão monta o nível do zero (pontuação zerada, para treino)
+void GameRestart(Game *g, GameLevel level) {
+    if (checkpoints->valid[level] && GameSnapshotRestore(g, &checkpoints->level[level])) {
+        char msg[64];
+        snprintf(msg, sizeof(msg), "Tentando de novo: Nível %d", level + 1);
+        HUDShowMessage(msg, 120);
+        return;
+    }
+    
+    g->phase = PHASE_BATTLE;
+    g->running = 1;
+    g->frameCount = 0;
+    g->score = 0;
+    GameInitHearts(g);
+    AttackManagerInit(&g->attacks, g->battleBox);
+    SetupLevel(g, level);
+}
+
+// Executa os eventos vencidos no frame atual
+static void GameProcessEvents(Game *g) {
+    ScheduledEvent ev;
+    while ((g->phase == PHASE_BATTLE || g->phase == PHASE_BOSS) && EventQueuePop(&g->events, g->frameCount, &ev)) {
+        switch (ev.type) {
+            case EVENT_PROGRESS:
+                g->levelProgress = 100 * (g->score - g->levelStartScore) / (g->levelEndScore - g->levelStartScore);
+                if (g->levelProgress > 100) g->levelProgress = 100;
+                ScheduleProgress(g);
+                break;
+                
+            case EVENT_LEVEL_COMPLETE:
+                // Passar para o próximo nível
+                if (g->currentLevel + 1 < LEVEL_COUNT) {
+                    g->phase = PHASE_TRANSITION;
+                    g->frameCount = 0; // Reiniciar contador para a transição
+                    TimerStart(&g->transitionTimer, TRANSITION_FRAMES);
+                    
+                    // Mostrar mensagem de transição
+                    HUDShowMessage("Nível Completo!", 120);
+                } else {
+                    // Completou todos os níveis
+                    g->phase = PHASE_WIN;
+                }
+                EventQueueClear(&g->events);
+                break;
+                
+            case EVENT_MOVE_CHANGE:
+                g->player.moveType = LevelMoveType(g->currentLevel, g->frameCount);
+                EventQueuePush(&g->events, g->frameCount + MOVE_CHANGE_INTERVAL, EVENT_MOVE_CHANGE);
+                break;
+                
+            case EVENT_TAUNT: {
+                // Mensagem perturbadora escolhida pelo frame: o RNG da raylib é
+                // do desenho (outra thread), e a escolha tem que ser a mesma
+                // na rede, no rollback e no replay
+                int msgIndex = (g->frameCount / TAUNT_INTERVAL) % 5;
+                const char* messages[] = {
+                    "Suas memórias estão desaparecendo...",
+                    "Você sente o vazio se aproximando...",
+                    "Não há esperança no fim do caminho...",
+                    "Seus arrependimentos o perseguem...",
+                    "O coração está se fragmentando..."
+                };
+                HUDShowMessage(messages[msgIndex], 180);
+                EventQueuePush(&g->events, g->frameCount + TAUNT_INTERVAL, EVENT_TAUNT);
+                break;
+            }
+                
+            case EVENT_WIN:
+                // Verificação de vitória (mais difícil: sobreviver 3000 frames)
+                g->phase = PHASE_WIN;
+                EventQueueClear(&g->events);
+                break;
+        }
+    }
+}
+
+// Resultado do job de áudio (escrito pela thread de trabalho, lido no `done`)
+static Music loadedMusic;
+
+// Thread de trabalho: abrir o dispositivo e decodificar o cabeçalho do MP3
+static void LoadAudioJob(void *ctx) {
+    (void)ctx;
+    
+    // Inicializar sistema de áudio com alta qualidade
+    InitAudioDevice();
+    
+    // Configurar qualidade de áudio para melhor desempenho
+    SetAudioStreamBufferSizeDefault(16384); // Buffer maior para música contínua
+    
+    // Carregar música de fundo (do pacote mapeado, sem cópia, ou de resources/)
+    loadedMusic = PackLoadMusic(MUSIC_FILE);
+}
+
+// Thread principal: publicar a música e começar o fade-in
+static void AudioReadyJob(void *ctx) {
+    Game *g = ctx;
+    g->bgMusic = loadedMusic;
+    g->musicLoaded = 1;
+    g->musicVolume = 0.0f;
+    g->musicPlaying = 1;
+    
+    // Configurar a música para melhor desempenho
+    SetMusicVolume(g->bgMusic, g->musicVolume);
+    SetMusicPitch(g->bgMusic, 1.0f); // Pitch normal
+    
+    // Iniciar reprodução da música
+    PlayMusicStream(g->bgMusic);
 }
 
 void GameInit(Game *g) {
     g->battleBox = (Rectangle){120, 100, 520, 300};
-    PlayerInit(&g->player, (Vector2){g->battleBox.x + g->battleBox.width/2, g->battleBox.y + g->battleBox.height/2});
+    g->coop = 0;
+    GameInitHearts(g);
     AttackManagerInit(&g->attacks, g->battleBox);
     g->phase = PHASE_MENU;  // Começar no menu
     g->frameCount = 0;
     g->score = 0;
     g->running = 1;
+    memset(&g->boss, 0, sizeof(g->boss));
     
     // Inicializar nível
     g->currentLevel = LEVEL_VOID;
     g->levelProgress = 0;
     g->levelStartScore = 0;
     g->levelEndScore = 300;
+    EventQueueClear(&g->events);
+    g->transitionTimer = (Timer){0, 0};
     
     // Cores de fundo iniciais
     g->bgColorTop = (Color){5, 0, 10, 255};
     g->bgColorBottom = (Color){15, 0, 30, 255};
     g->effectIntensity = 0.3f;
     
-    // Inicializar sistema de áudio com alta qualidade
-    InitAudioDevice();
-    
-    // Configurar qualidade de áudio para melhor desempenho
-    SetAudioStreamBufferSizeDefault(16384); // Buffer maior para música contínua
-    
-    // Carregar música de fundo
-    g->bgMusic = LoadMusicStream("resources/Condemned Tower - Castlevania Dawn of Sorrow OST.mp3");
-    g->musicPlaying = 1;
-    
-    // Configurar a música para melhor desempenho
-    SetMusicVolume(g->bgMusic, 0.5f); // Volume mais alto para melhor experiência
-    SetMusicPitch(g->bgMusic, 1.0f); // Pitch normal
-    
-    // Iniciar reprodução da música
-    PlayMusicStream(g->bgMusic);
+    g->musicLoaded = 0;
+    g->musicVolume = 0.0f;
+    g->musicPlaying = 0;
+    g->audioResetCounter = 0;
 }
 
-void GameUpdate(Game *g) {
-    if (!g->running) return;
+// O áudio abre em segundo plano: o menu aparece já no primeiro frame
+void GameLoadAudio(Game *g) {
+    LoaderSubmit(LoadAudioJob, AudioReadyJob, g);
+}
+
+static void GamePumpAudio(Game *g) {
+    if (!g->musicLoaded) return;
+    
+    // Fade-in depois que a música fica pronta
+    if (g->musicVolume < MUSIC_VOLUME) {
+        g->musicVolume = fminf(g->musicVolume + MUSIC_FADE_STEP, MUSIC_VOLUME);
+        SetMusicVolume(g->bgMusic, g->musicVolume);
+    }
     
     // Gerenciamento de áudio para tocar a música completa sem interrupções
     if (g->musicPlaying) {
@@ -115,73 +432,130 @@ void GameUpdate(Game *g) {
             PlayMusicStream(g->bgMusic);
         }
     }
+}
+
+void GameUpdateAudio(Game *g) {
+    AllocPhase previous = AllocTrackEnter(ALLOC_PHASE_AUDIO);
+    GamePumpAudio(g);
+    AllocTrackLeave(previous);
+}
+
+GameInput GameReadInput(void) {
+    GameInput in = {0};
+    in.player = PlayerReadInput();
+    in.confirm = IsKeyPressed(KEY_ENTER);
+    in.start = IsKeyPressed(KEY_ENTER) || IsKeyPressed(KEY_SPACE);
+    in.restart = IsKeyPressed(KEY_R);
+    in.practiceLevel = -1;
+    for (int level = LEVEL_VOID; level < LEVEL_COUNT; level++) {
+        if (IsKeyPressed(KEY_ONE + level)) in.practiceLevel = level;
+    }
+    return in;
+}
+
+// Comandos de menu em "in" e um PlayerInput por coração
+static void GameUpdateFrame(Game *g, const GameInput *in, const PlayerInput inputs[2]) {
+    // R reinicia o jogo completamente (a partir do checkpoint do primeiro nível)
+    if (in->restart) {
+        GameRestart(g, LEVEL_VOID);
+        return;
+    }
+    
+    // Despedaçado: ENTER tenta o nível atual de novo a partir do checkpoint
+    // (no cooperativo, só depois que os dois corações se despedaçaram)
+    if (g->player.isDead && (!g->coop || !g->running) && in->confirm) {
+        GameRestart(g, g->currentLevel);
+        return;
+    }
+    
+    if (!g->running) return;
     
     // Lógica do menu
     if (g->phase == PHASE_MENU) {
-        if (IsKeyPressed(KEY_ENTER) || IsKeyPressed(KEY_SPACE)) {
-            g->phase = PHASE_BATTLE;
-            // Reiniciar o jogo
-            PlayerInit(&g->player, (Vector2){g->battleBox.x + g->battleBox.width/2, g->battleBox.y + g->battleBox.height/2});
-            AttackManagerInit(&g->attacks, g->battleBox);
-            g->frameCount = 0;
-            g->score = 0;
+        if (in->start) {
+            GameRestart(g, LEVEL_VOID);
+            return;
+        }
+        
+        // Treino: 1-6 começa direto no nível escolhido (6 = chefe)
+        if (in->practiceLevel >= 0) {
+            GameRestart(g, in->practiceLevel);
+            return;
         }
+        
         // Animação no menu
         g->frameCount++;
         return;
     }
     
-    // A verificação para reiniciar com R foi movida para o loop principal em main.c
-    // para garantir que funcione em todas as situações
+    GameTick(g, inputs);
     
-    // Verificação para reiniciar quando morto com ENTER
-    if (g->player.isDead && IsKeyPressed(KEY_ENTER)) {
-        // Reiniciar o jogo completamente
-        g->phase = PHASE_BATTLE;
-        g->running = 1;
-        g->player.isDead = 0;
-        g->frameCount = 0;
-        g->score = 0;
-        
-        // Reinicializar o jogador e ataques
-        PlayerInit(&g->player, (Vector2){g->battleBox.x + g->battleBox.width/2, g->battleBox.y + g->battleBox.height/2});
-        AttackManagerInit(&g->attacks, g->battleBox);
-        
-        // Configurar o primeiro nível
-        SetupLevel(g, LEVEL_VOID);
-        
-        // Manter a música tocando sem reiniciar
-        g->musicPlaying = 1;
+    // Verificação para reiniciar quando na tela de vitória
+    if (g->phase == PHASE_WIN && in->start) {
+        g->phase = PHASE_MENU;
+    }
+}
+
+void GameUpdate(Game *g, const GameInput *in) {
+    AllocPhase previous = AllocTrackEnter(ALLOC_PHASE_UPDATE);
+    PlayerInput inputs[2] = { in->player, {0} };
+    GameUpdateFrame(g, in, inputs);
+    AllocTrackLeave(previous);
+}
+
+void GameUpdateCoop(Game *g, const GameInput *commands, const PlayerInput inputs[2]) {
+    GameUpdateFrame(g, commands, inputs);
+}
+
+// Plataformas e colisão com ataques de um coração já movido neste tick
+static void GameResolveHeart(Game *g, Player *p) {
+    // Verificar colisão com plataformas se estiver no modo de plataformas
+    if (p->moveType == MOVE_PLATFORMS) {
+        CheckPlatformCollision(&g->attacks, p);
+    }
+    
+    // Verificação de colisão com hitbox menor (apenas 60% do tamanho visual).
+    // A mesma consulta à grade diz se alguma ameaça passou raspando.
+    sim_t hitboxSize = SimMul(p->size, SIM(0.6));
+    SimRect hitbox = { p->pos.x-hitboxSize/2, p->pos.y-hitboxSize/2, hitboxSize, hitboxSize };
+    ThreatQuery q = ThreatGridQuery(&threatGrid, &hitbox, GRAZE_RADIUS);
+    if (p->grazeFlash > 0) p->grazeFlash--;
+    if (q.hit) {
+        PlayerTakeDamage(p, 10, q.source);
+        HUDShowMessage("Ouch!", 30);
+    }
+    
+    // Raspão: bônus no primeiro tick perto de uma ameaça e a cada
+    // GRAZE_INTERVAL enquanto continuar perto (nada durante a invencibilidade)
+    if (q.hit || !q.near || p->invulnerable) {
+        p->grazeTicks = 0;
         return;
     }
+    if (p->grazeTicks++ % GRAZE_INTERVAL == 0) {
+        p->grazeCount++;
+        p->grazeFlash = GRAZE_FLASH_FRAMES;
+        g->score += GRAZE_POINTS;
+        if (g->phase == PHASE_BOSS) BossDamage(&g->boss, GRAZE_BOSS_DAMAGE);
+        else RescheduleScoreEvents(g);
+    }
+}
+
+// Um tick da simulação. Só depende do estado e das entradas (uma por
+// coração), então pode ser reexecutado a partir de um snapshot.
+void GameTick(Game *g, const PlayerInput inputs[2]) {
+    if (!g->running || g->phase == PHASE_MENU) return;
     
-    // Gerenciar transição entre níveis
-    if (g->phase == PHASE_BATTLE) {
-        // Calcular progresso no nível atual
-        g->levelProgress = (int)(100.0f * (float)(g->score - g->levelStartScore) / (float)(g->levelEndScore - g->levelStartScore));
-        
-        // Verificar se completou o nível atual
-        if (g->score >= g->levelEndScore) {
-            // Passar para o próximo nível
-            if (g->currentLevel < LEVEL_HOPE) {
-                g->phase = PHASE_TRANSITION;
-                g->frameCount = 0; // Reiniciar contador para a transição
-                
-                // Mostrar mensagem de transição
-                HUDShowMessage("Nível Completo!", 120);
-            } else {
-                // Completou todos os níveis
-                g->phase = PHASE_WIN;
-            }
-        }
+    // Eventos agendados: progresso, fim de nível, troca de movimento, mensagens e vitória
+    if (g->phase == PHASE_BATTLE || g->phase == PHASE_BOSS) {
+        GameProcessEvents(g);
     }
     
     // Gerenciar a fase de transição
     if (g->phase == PHASE_TRANSITION) {
         g->frameCount++;
         
-        // Após 2 segundos (120 frames), passar para o próximo nível
-        if (g->frameCount >= 120) {
+        // Após 2 segundos, passar para o próximo nível
+        if (TimerTick(&g->transitionTimer)) {
             g->phase = PHASE_BATTLE;
             
             // Configurar o próximo nível
@@ -190,65 +564,47 @@ void GameUpdate(Game *g) {
         return;
     }
     
-    // Lógica normal do jogo
-    PlayerUpdate(&g->player, g->battleBox);
+    // Corações em jogo (o parceiro segue o modo de movimento do nível)
+    Player *hearts[2] = { &g->player, &g->partner };
+    int heartCount = g->coop ? 2 : 1;
+    g->partner.moveType = g->player.moveType;
     
-    // Definir o tipo de movimento do jogador com base no nível atual
-    switch (g->currentLevel) {
-        case LEVEL_VOID:
-            // Movimento livre tradicional
-            g->player.moveType = MOVE_FREE;
-            break;
-            
-        case LEVEL_MEMORY:
-            // Movimento estilo Undertale - fixo ao chão com pulo
-            g->player.moveType = MOVE_PLATFORMER;
-            break;
-            
-        case LEVEL_REGRET:
-            // Movimento livre novamente
-            g->player.moveType = MOVE_FREE;
-            break;
-            
-        case LEVEL_FEAR:
-            // Movimento em plataformas flutuantes
-            g->player.moveType = MOVE_PLATFORMS;
-            break;
-            
-        case LEVEL_HOPE:
-            // Alterna entre todos os tipos para o desafio final
-            if (g->frameCount % 600 < 200) {
-                g->player.moveType = MOVE_FREE;
-            } else if (g->frameCount % 600 < 400) {
-                g->player.moveType = MOVE_PLATFORMER;
-            } else {
-                g->player.moveType = MOVE_PLATFORMS;
-            }
-            break;
-            
-        case LEVEL_COUNT:
-            // Caso especial para evitar warning
-            g->player.moveType = MOVE_FREE;
-            break;
+    // Lógica normal do jogo
+    for (int i = 0; i < heartCount; i++) {
+        if (!hearts[i]->isDead) PlayerUpdate(hearts[i], SimRectFromRectangle(g->battleBox), inputs[i]);
     }
     
-    // Passar o nível atual e tipo de movimento para o gerenciador de ataques
-    AttackManagerUpdate(&g->attacks, g->battleBox, g->frameCount, g->currentLevel, g->player.moveType);
+    // Passar o nível atual, o tipo de movimento e o coração que os ataques
+    // mirados perseguem (o parceiro, se o primeiro já se despedaçou)
+    SimVec2 target = g->player.isDead && g->coop ? g->partner.pos : g->player.pos;
+    AttackManagerUpdate(&g->attacks, g->battleBox, g->frameCount, g->currentLevel, g->player.moveType, target);
     
-    // Verificar colisão com plataformas se estiver no modo de plataformas
-    if (g->player.moveType == MOVE_PLATFORMS) {
-        CheckPlatformCollision(&g->attacks, &g->player);
+    // O chefe dispara depois do movimento, como os padrões dos níveis
+    if (g->phase == PHASE_BOSS) {
+        if (BossUpdate(&g->boss, &g->attacks, target)) {
+            g->phase = PHASE_WIN;
+            AttackManagerClearProjectiles(&g->attacks);
+            EventQueueClear(&g->events);
+            HUDShowMessage("O coração partido silencia", 180);
+        }
+        g->levelProgress = 100 - 100 * g->boss.hp / BOSS_HP;
     }
+    ThreatGridBuild(&threatGrid, &g->attacks);
     
-    // Verificação de colisão com hitbox menor (apenas 60% do tamanho visual)
-    float hitboxSize = g->player.size * 0.6f;
-    if (AttackManagerCheckHit(&g->attacks, &(Rectangle){g->player.pos.x-hitboxSize/2, g->player.pos.y-hitboxSize/2, hitboxSize, hitboxSize})) {
-        PlayerTakeDamage(&g->player, 10);
-        HUDShowMessage("Ouch!", 30);
+    int alive = 0;
+    for (int i = 0; i < heartCount; i++) {
+        if (hearts[i]->isDead) continue;
+        GameResolveHeart(g, hearts[i]);
+        if (hearts[i]->hp > 0) {
+            alive++;
+            continue;
+        }
+        hearts[i]->isDead = 1;
+        TelemetryEmit(TELEMETRY_DEATH, g->currentLevel, SimToInt(hearts[i]->pos.x), SimToInt(hearts[i]->pos.y), 0, g->score);
     }
     
     // Incrementar pontuação a cada frame (sobreviver = pontuar)
-    if (g->phase == PHASE_BATTLE && !g->player.isDead) {
+    if ((g->phase == PHASE_BATTLE || g->phase == PHASE_BOSS) && alive) {
         g->score++;
         
         // Otimizar o processamento de áudio em pontos críticos para evitar travamentos
@@ -267,93 +623,123 @@ void GameUpdate(Game *g) {
         }
     }
     
-    // Verificação de morte
-    if (g->player.hp <= 0 && !g->player.isDead) {
-        g->player.isDead = 1;
+    // Verificação de morte (no cooperativo, só quando os dois se despedaçam)
+    if (!alive) {
         g->running = 0;
-        HUDShowMessage("Press R to restart", 180);
+        HUDShowMessage(g->coop ? "Os dois corações se despedaçaram" : "Press R to restart", 180);
     }
     
-    // Verificação de vitória (mais difícil: sobreviver 3000 frames)
-    if (g->frameCount > 3000 && g->phase == PHASE_BATTLE) {
-        g->phase = PHASE_WIN;
-    }
+    g->frameCount++;
+}
+
+// Hash do que a simulação decide (sem desenho, HUD nem áudio). Dois builds
+// com o mesmo hash a cada tick estão em lockstep.
+unsigned int GameStateHash(const Game *g) {
+    unsigned int h = HASH_SEED;
+    int header[] = { g->phase, g->currentLevel, g->frameCount, g->score, g->running, g->coop };
+    h = HashBytes(h, header, sizeof(header));
     
-    // Aumentar a dificuldade gradualmente conforme o jogo avança
-    if (g->phase == PHASE_BATTLE && g->frameCount % 500 == 0 && g->frameCount > 0) {
-        // Mostrar mensagem perturbadora aleatória
-        int msgIndex = GetRandomValue(0, 4);
-        const char* messages[] = {
-            "Suas memórias estão desaparecendo...",
-            "Você sente o vazio se aproximando...",
-            "Não há esperança no fim do caminho...",
-            "Seus arrependimentos o perseguem...",
-            "O coração está se fragmentando..."
-        };
-        HUDShowMessage(messages[msgIndex], 180);
+    const Player *hearts[2] = { &g->player, &g->partner };
+    for (int i = 0; i < 2; i++) {
+        const Player *p = hearts[i];
+        sim_t motion[] = { p->pos.x, p->pos.y, p->vel.x, p->vel.y, p->velocityY };
+        int status[] = { p->hp, p->invulFrames, p->isDead, p->isGrounded, p->moveType, p->currentPlatform,
+                         p->grazeTicks, p->grazeCount };
+        h = HashBytes(h, motion, sizeof(motion));
+        h = HashBytes(h, status, sizeof(status));
     }
     
-    // Verificação para reiniciar quando na tela de vitória
-    if (g->phase == PHASE_WIN) {
-        if (IsKeyPressed(KEY_ENTER) || IsKeyPressed(KEY_SPACE)) {
-            g->phase = PHASE_MENU;
-        }
-    }
+    const AttackManager *am = &g->attacks;
+    h = HashBytes(h, am->streamStart, sizeof(am->streamStart));
+    h = HashBytes(h, am->projectiles, am->streamStart[ATK_COUNT] * sizeof(Projectile));
+    h = HashBytes(h, &am->rngState, sizeof(am->rngState));
+    h = HashBytes(h, &am->projectileCap, sizeof(am->projectileCap));
     
-    g->frameCount++;
+    const EntityStore *es = &am->entities;
+    h = HashBytes(h, &es->count, sizeof(es->count));
+    h = HashBytes(h, es->rect, es->count * sizeof(SimRect));
+    h = HashBytes(h, es->velocity, es->count * sizeof(SimVec2));
+    h = HashBytes(h, es->beam, es->count * sizeof(SimBeam));
+    
+    const Boss *b = &g->boss;
+    int boss[] = { b->hp, b->phase, b->phaseTicks, b->emitterCount };
+    h = HashBytes(h, boss, sizeof(boss));
+    h = HashBytes(h, &b->pos, sizeof(b->pos));
+    h = HashBytes(h, b->orbit, b->emitterCount * sizeof(sim_t));
+    return h;
 }
 
-void GameDraw(const Game *g) {
-    if (!g->running) return;
+void GameExtractFrame(const Game *g, FramePacket *f) {
+    f->phase = g->phase;
+    f->currentLevel = g->currentLevel;
+    f->levelProgress = g->levelProgress;
+    f->frameCount = g->frameCount;
+    f->score = g->score;
+    f->running = g->running;
+    f->coop = g->coop;
+    f->battleBox = g->battleBox;
+    f->bgColorTop = g->bgColorTop;
+    f->bgColorBottom = g->bgColorBottom;
+    f->effectIntensity = g->effectIntensity;
+    f->player = g->player;
+    f->partner = g->partner;
+    AttackManagerExtract(&g->attacks, &f->attacks);
+    BossExtract(&g->boss, g->phase == PHASE_BOSS, &f->boss);
+    HUDExtract(f);
+}
+
+static void GameDrawFrame(const FramePacket *f) {
+    // Parado só desenha se for a tela de coração despedaçado
+    if (!f->running && !f->player.isDead) return;
     
     // Desenhar fundo com gradiente baseado no nível atual
-    for (int y = 0; y < GetScreenHeight(); y += 4) {
+    for (int y = 0; y < GAME_HEIGHT; y += 4) {
         // Calcular a cor interpolada entre o topo e o fundo
-        float t = (float)y / GetScreenHeight();
+        float t = (float)y / GAME_HEIGHT;
         
         // Adicionar efeito pulsante baseado na intensidade do nível
-        float pulse = g->effectIntensity * 0.2f * sinf(g->frameCount * 0.02f);
+        float pulse = f->effectIntensity * 0.2f * sinf(f->frameCount * 0.02f);
         
         // Interpolar entre as cores do topo e do fundo
         Color color = {
-            (unsigned char)(g->bgColorTop.r * (1-t) + g->bgColorBottom.r * t + pulse * 20),
-            (unsigned char)(g->bgColorTop.g * (1-t) + g->bgColorBottom.g * t),
-            (unsigned char)(g->bgColorTop.b * (1-t) + g->bgColorBottom.b * t + pulse * 30),
+            (unsigned char)(f->bgColorTop.r * (1-t) + f->bgColorBottom.r * t + pulse * 20),
+            (unsigned char)(f->bgColorTop.g * (1-t) + f->bgColorBottom.g * t),
+            (unsigned char)(f->bgColorTop.b * (1-t) + f->bgColorBottom.b * t + pulse * 30),
             255
         };
         
-        DrawLine(0, y, GetScreenWidth(), y, color);
+        DrawLine(0, y, GAME_WIDTH, y, color);
     }
     
     // Efeitos visuais específicos para cada nível
-    if (g->phase == PHASE_BATTLE || g->phase == PHASE_TRANSITION) {
-        switch (g->currentLevel) {
+    if (f->phase == PHASE_BATTLE || f->phase == PHASE_BOSS || f->phase == PHASE_TRANSITION) {
+        switch (f->currentLevel) {
             case LEVEL_VOID:
                 // Efeito de partículas flutuantes no vazio
-                for (int i = 0; i < 20; i++) {
-                    float x = fmodf(g->frameCount * 2 + i * 50, (float)GetScreenWidth());
-                    float y = 100 + 200 * sinf((g->frameCount + i * 30) * 0.01f);
-                    float size = 2 + sinf(g->frameCount * 0.05f + i) * 2;
+                for (int i = 0; i < QualityScaleCount(20); i++) {
+                    float x = fmodf(f->frameCount * 2 + i * 50, (float)GAME_WIDTH);
+                    float y = 100 + 200 * sinf((f->frameCount + i * 30) * 0.01f);
+                    float size = 2 + sinf(f->frameCount * 0.05f + i) * 2;
                     DrawCircle(x, y, size, (Color){80, 20, 120, 100});
                 }
                 break;
                 
             case LEVEL_MEMORY:
                 // Fragmentos de memória flutuando
-                for (int i = 0; i < 30; i++) {
-                    float x = fmodf(g->frameCount + i * 40, (float)GetScreenWidth());
-                    float y = 150 + 100 * sinf((g->frameCount + i * 20) * 0.02f);
-                    float size = 3 + cosf(g->frameCount * 0.03f + i) * 2;
+                for (int i = 0; i < QualityScaleCount(30); i++) {
+                    float x = fmodf(f->frameCount + i * 40, (float)GAME_WIDTH);
+                    float y = 150 + 100 * sinf((f->frameCount + i * 20) * 0.02f);
+                    float size = 3 + cosf(f->frameCount * 0.03f + i) * 2;
                     DrawRectangle(x, y, size * 3, size, (Color){120, 0, 150, 150});
                 }
                 break;
                 
             case LEVEL_REGRET:
                 // Sombras de arrependimento
-                for (int i = 0; i < 15; i++) {
-                    float x = fmodf(g->frameCount * 3 + i * 60, (float)GetScreenWidth());
-                    float y = 200 + 150 * sinf((g->frameCount + i * 40) * 0.01f);
-                    float size = 10 + sinf(g->frameCount * 0.02f + i) * 5;
+                for (int i = 0; i < QualityScaleCount(15); i++) {
+                    float x = fmodf(f->frameCount * 3 + i * 60, (float)GAME_WIDTH);
+                    float y = 200 + 150 * sinf((f->frameCount + i * 40) * 0.01f);
+                    float size = 10 + sinf(f->frameCount * 0.02f + i) * 5;
                     DrawCircle(x, y, size, (Color){100, 0, 20, 80});
                     DrawText("ERRO", x - 20, y - 10, 10, (Color){200, 0, 50, 150});
                 }
@@ -361,55 +747,65 @@ void GameDraw(const Game *g) {
                 
             case LEVEL_FEAR:
                 // Sombras dos medos
-                for (int i = 0; i < 25; i++) {
-                    float x = fmodf(g->frameCount * 1.5f + i * 70, (float)GetScreenWidth());
-                    float y = 100 + 250 * sinf((g->frameCount + i * 25) * 0.015f);
-                    float width = 15 + sinf(g->frameCount * 0.03f + i) * 5;
-                    float height = 30 + cosf(g->frameCount * 0.02f + i) * 10;
+                for (int i = 0; i < QualityScaleCount(25); i++) {
+                    float x = fmodf(f->frameCount * 1.5f + i * 70, (float)GAME_WIDTH);
+                    float y = 100 + 250 * sinf((f->frameCount + i * 25) * 0.015f);
+                    float width = 15 + sinf(f->frameCount * 0.03f + i) * 5;
+                    float height = 30 + cosf(f->frameCount * 0.02f + i) * 10;
                     DrawRectangle(x, y, width, height, (Color){20, 20, 30, 120});
                 }
                 break;
                 
             case LEVEL_HOPE:
                 // Centelhas de esperança
-                for (int i = 0; i < 40; i++) {
-                    float x = fmodf(g->frameCount * 2.5f + i * 30, (float)GetScreenWidth());
-                    float y = 150 + 200 * sinf((g->frameCount + i * 35) * 0.01f);
-                    float size = 1 + sinf(g->frameCount * 0.04f + i) * 1;
+                for (int i = 0; i < QualityScaleCount(40); i++) {
+                    float x = fmodf(f->frameCount * 2.5f + i * 30, (float)GAME_WIDTH);
+                    float y = 150 + 200 * sinf((f->frameCount + i * 35) * 0.01f);
+                    float size = 1 + sinf(f->frameCount * 0.04f + i) * 1;
                     DrawCircle(x, y, size, (Color){200, 200, 255, 180});
                 }
                 break;
                 
+            case LEVEL_BOSS:
+                // Rachaduras que pulsam com o coração partido
+                for (int i = 0; i < QualityScaleCount(12); i++) {
+                    float x = (i * 137 + 40) % GAME_WIDTH;
+                    float length = 40 + 30 * sinf(f->frameCount * 0.05f + i);
+                    DrawLineEx((Vector2){x, 0}, (Vector2){x + length * 0.4f, length}, 2, (Color){120, 0, 20, 120});
+                    DrawLineEx((Vector2){x, GAME_HEIGHT}, (Vector2){x - length * 0.4f, GAME_HEIGHT - length}, 2, (Color){120, 0, 20, 120});
+                }
+                break;
+                
             default:
                 break;
         }
     }
     
     // Menu inicial sombrio
-    if (g->phase == PHASE_MENU) {
+    if (f->phase == PHASE_MENU) {
         // Efeito de pulsação como um coração agonizante
-        float heartbeat = 1.0f + 0.2f * sinf(g->frameCount * 0.08f);
-        if (g->frameCount % 120 < 10) heartbeat *= 1.2f; // Batida irregular ocasional
+        float heartbeat = 1.0f + 0.2f * sinf(f->frameCount * 0.08f);
+        if (f->frameCount % 120 < 10) heartbeat *= 1.2f; // Batida irregular ocasional
         
         int titleSize = 60 * heartbeat;
         const char *title = "HEART";
         int titleWidth = MeasureText(title, titleSize);
         
         // Desenhar título com efeito de sangue escorrendo
-        DrawText(title, GetScreenWidth()/2 - titleWidth/2 + 4, 100 + 4, titleSize, (Color){20, 0, 5, 255});
-        DrawText(title, GetScreenWidth()/2 - titleWidth/2, 100, titleSize, (Color){180, 0, 20, 255});
+        DrawText(title, GAME_WIDTH/2 - titleWidth/2 + 4, 100 + 4, titleSize, (Color){20, 0, 5, 255});
+        DrawText(title, GAME_WIDTH/2 - titleWidth/2, 100, titleSize, (Color){180, 0, 20, 255});
         
         // Subtítulo sombrio
         const char *subtitle = "Entre o Vazio e a Esperança";
         int subtitleWidth = MeasureText(subtitle, 20);
-        DrawText(subtitle, GetScreenWidth()/2 - subtitleWidth/2, 170, 20, (Color){150, 150, 150, 255});
+        DrawText(subtitle, GAME_WIDTH/2 - subtitleWidth/2, 170, 20, (Color){150, 150, 150, 255});
         
         // Desenhar coração pixel art decorativo
-        float heartScale = 1.0f + 0.2f * sinf(g->frameCount * 0.1f);
+        float heartScale = 1.0f + 0.2f * sinf(f->frameCount * 0.1f);
         float heartSize = 40.0f * heartScale;
         float pixelSize = heartSize / 8.0f;
         
-        int x = GetScreenWidth()/2;
+        int x = GAME_WIDTH/2;
         int y = 220;
         
         Color heartColor = RED;
@@ -460,9 +856,9 @@ void GameDraw(const Game *g) {
         
         // Efeito de sangue escorrendo aleatoriamente na tela
         for (int i = 0; i < 5; i++) {
-            if ((g->frameCount + i*50) % 200 < 100) {
+            if ((f->frameCount + i*50) % 200 < 100) {
                 int x = 100 + i * 100;
-                int height = 50 + sinf(g->frameCount * 0.05f + i) * 30;
+                int height = 50 + sinf(f->frameCount * 0.05f + i) * 30;
                 DrawRectangleGradientV(x, 50, 2, height, (Color){180, 0, 20, 255}, (Color){100, 0, 10, 100});
             }
         }
@@ -470,13 +866,13 @@ void GameDraw(const Game *g) {
         // Instruções sombrias
         const char *instructions = "Pressione ENTER para enfrentar seus medos";
         int instWidth = MeasureText(instructions, 22);
-        DrawText(instructions, GetScreenWidth()/2 - instWidth/2, 300, 22, (Color){200, 200, 200, (unsigned char)(150 + sinf(g->frameCount * 0.1f) * 50)});
+        DrawText(instructions, GAME_WIDTH/2 - instWidth/2, 300, 22, (Color){200, 200, 200, (unsigned char)(150 + sinf(f->frameCount * 0.1f) * 50)});
         
         // Mensagem perturbadora que pisca ocasionalmente
-        if (g->frameCount % 180 < 30) {
+        if (f->frameCount % 180 < 30) {
             const char *warning = "Não há escapatoria";
             int warnWidth = MeasureText(warning, 18);
-            DrawText(warning, GetScreenWidth()/2 - warnWidth/2, 330, 18, (Color){180, 0, 20, 150});
+            DrawText(warning, GAME_WIDTH/2 - warnWidth/2, 330, 18, (Color){180, 0, 20, 150});
         }
         
         // Controles
@@ -485,54 +881,58 @@ void GameDraw(const Game *g) {
         DrawText("Espaço - Saltar sobre seus arrependimentos", 200, 450, 18, (Color){150, 150, 150, 180});
         DrawText("Shift - Fugir de seus medos (dash)", 200, 475, 18, (Color){150, 150, 150, 180});
         DrawText("R - Tentar novamente (quando despedaçado)", 200, 500, 18, (Color){150, 150, 150, 180});
+        DrawText("1-6 - Praticar um nível (6 = chefe)", 200, 525, 18, (Color){150, 150, 150, 180});
         
         return;
     }
     
     // Desenhar caixa de batalha como uma jaula de ossos e veias
-    float pulseWidth = 2.0f + sinf(g->frameCount * 0.05f) * 0.5f;
-    Color borderColor = (Color){150 + (int)(50 * sinf(g->frameCount * 0.02f)), 0, 20, 255};
+    float pulseWidth = 2.0f + sinf(f->frameCount * 0.05f) * 0.5f;
+    Color borderColor = (Color){150 + (int)(50 * sinf(f->frameCount * 0.02f)), 0, 20, 255};
     
     // Desenhar linhas pulsantes como veias
-    DrawRectangleLinesEx(g->battleBox, pulseWidth, borderColor);
+    DrawRectangleLinesEx(f->battleBox, pulseWidth, borderColor);
     
     // Adicionar efeito de sangue nos cantos da caixa
-    if (g->frameCount % 120 < 60) {
-        DrawRectangleGradientV(g->battleBox.x, g->battleBox.y, 20, 20, 
+    QualityTier quality = QualityCurrent();
+    if (quality < QUALITY_MINIMAL && f->frameCount % 120 < 60) {
+        DrawRectangleGradientV(f->battleBox.x, f->battleBox.y, 20, 20, 
                              (Color){180, 0, 20, 200}, (Color){100, 0, 10, 0});
-        DrawRectangleGradientV(g->battleBox.x + g->battleBox.width - 20, g->battleBox.y + g->battleBox.height - 20, 
+        DrawRectangleGradientV(f->battleBox.x + f->battleBox.width - 20, f->battleBox.y + f->battleBox.height - 20, 
                              20, 20, (Color){180, 0, 20, 200}, (Color){100, 0, 10, 0});
     }
     
-    // Adicionar ossos nas bordas da caixa de batalha
-    float boneLength = 20.0f;
-    float boneWidth = 6.0f;
-    Color boneColor = (Color){220, 220, 220, 200};
-    
-    // Ossos horizontais nas bordas superior e inferior
-    for (int i = 0; i < g->battleBox.width; i += 40) {
-        // Borda superior
-        DrawRectangle(g->battleBox.x + i, g->battleBox.y - boneWidth/2, boneLength, boneWidth, boneColor);
-        DrawCircle(g->battleBox.x + i + boneLength/2, g->battleBox.y, boneWidth * 0.8f, boneColor);
+    // Ossos nas bordas da caixa de batalha (borda simples em qualidade baixa)
+    if (quality < QUALITY_LOW) {
+        float boneLength = 20.0f;
+        float boneWidth = 6.0f;
+        Color boneColor = (Color){220, 220, 220, 200};
         
-        // Borda inferior
-        DrawRectangle(g->battleBox.x + i, g->battleBox.y + g->battleBox.height - boneWidth/2, boneLength, boneWidth, boneColor);
-        DrawCircle(g->battleBox.x + i + boneLength/2, g->battleBox.y + g->battleBox.height, boneWidth * 0.8f, boneColor);
-    }
-    
-    // Ossos verticais nas bordas laterais
-    for (int i = 0; i < g->battleBox.height; i += 40) {
-        // Borda esquerda
-        DrawRectangle(g->battleBox.x - boneWidth/2, g->battleBox.y + i, boneWidth, boneLength, boneColor);
-        DrawCircle(g->battleBox.x, g->battleBox.y + i + boneLength/2, boneWidth * 0.8f, boneColor);
+        // Ossos horizontais nas bordas superior e inferior
+        for (int i = 0; i < f->battleBox.width; i += 40) {
+            // Borda superior
+            DrawRectangle(f->battleBox.x + i, f->battleBox.y - boneWidth/2, boneLength, boneWidth, boneColor);
+            DrawCircle(f->battleBox.x + i + boneLength/2, f->battleBox.y, boneWidth * 0.8f, boneColor);
+            
+            // Borda inferior
+            DrawRectangle(f->battleBox.x + i, f->battleBox.y + f->battleBox.height - boneWidth/2, boneLength, boneWidth, boneColor);
+            DrawCircle(f->battleBox.x + i + boneLength/2, f->battleBox.y + f->battleBox.height, boneWidth * 0.8f, boneColor);
+        }
         
-        // Borda direita
-        DrawRectangle(g->battleBox.x + g->battleBox.width - boneWidth/2, g->battleBox.y + i, boneWidth, boneLength, boneColor);
-        DrawCircle(g->battleBox.x + g->battleBox.width, g->battleBox.y + i + boneLength/2, boneWidth * 0.8f, boneColor);
+        // Ossos verticais nas bordas laterais
+        for (int i = 0; i < f->battleBox.height; i += 40) {
+            // Borda esquerda
+            DrawRectangle(f->battleBox.x - boneWidth/2, f->battleBox.y + i, boneWidth, boneLength, boneColor);
+            DrawCircle(f->battleBox.x, f->battleBox.y + i + boneLength/2, boneWidth * 0.8f, boneColor);
+            
+            // Borda direita
+            DrawRectangle(f->battleBox.x + f->battleBox.width - boneWidth/2, f->battleBox.y + i, boneWidth, boneLength, boneColor);
+            DrawCircle(f->battleBox.x + f->battleBox.width, f->battleBox.y + i + boneLength/2, boneWidth * 0.8f, boneColor);
+        }
     }
     
     // Adicionar mensagens perturbadoras que aparecem e desaparecem no fundo da arena
-    if (g->frameCount % 300 < 60) {
+    if (f->frameCount % 300 < 60) {
         const char* mensagens[] = {
             "NÃO HÁ ESCAPATORIA",
             "SEUS PECADOS TE PERSEGUEM",
@@ -541,27 +941,30 @@ void GameDraw(const Game *g) {
             "DESISTA"
         };
         
-        int msgIndex = (g->frameCount / 300) % 5;
+        int msgIndex = (f->frameCount / 300) % 5;
         const char* msg = mensagens[msgIndex];
         int fontSize = 20;
         int textWidth = MeasureText(msg, fontSize);
         
         // Desenhar texto com efeito de sangue escorrendo
         DrawText(msg, 
-                g->battleBox.x + g->battleBox.width/2 - textWidth/2, 
-                g->battleBox.y + g->battleBox.height/2, 
+                f->battleBox.x + f->battleBox.width/2 - textWidth/2, 
+                f->battleBox.y + f->battleBox.height/2, 
                 fontSize, 
-                (Color){180, 0, 20, 50 + (int)(sinf(g->frameCount * 0.1f) * 30)});
+                (Color){180, 0, 20, 50 + (int)(sinf(f->frameCount * 0.1f) * 30)});
     }
     
-    // Desenhar elementos do jogo
-    AttackManagerDraw(&g->attacks);
-    PlayerDraw(&g->player);
+    // Desenhar elementos do jogo (o chefe fica atrás dos próprios projéteis)
+    BossDraw(&f->boss);
+    AttackManagerDraw(&f->attacks);
+    if (f->ghostVisible) PlayerDrawGhost(&f->ghost);   // Por baixo do coração de verdade
+    PlayerDraw(&f->player);
+    if (f->coop) PlayerDraw(&f->partner);
     
     // Desenhar partículas sombrias (fragmentos de memórias perdidas)
     for (int i = 0; i < 12; i++) {
-        float x = g->battleBox.x + GetRandomValue(0, (int)g->battleBox.width);
-        float y = g->battleBox.y + GetRandomValue(0, (int)g->battleBox.height);
+        float x = f->battleBox.x + GetRandomValue(0, (int)f->battleBox.width);
+        float y = f->battleBox.y + GetRandomValue(0, (int)f->battleBox.height);
         float size = GetRandomValue(1, 3);
         
         // Cores alternando entre vermelho escuro e cinza (memórias de sangue e cinzas)
@@ -578,19 +981,19 @@ void GameDraw(const Game *g) {
     }
     
     // Adicionar efeito de distorção visual ocasional (sanidade diminuindo)
-    if (g->frameCount % 300 < 10) {
-        DrawRectangle(0, 0, GetScreenWidth(), GetScreenHeight(), (Color){200, 0, 0, 30});
+    if (f->frameCount % 300 < 10) {
+        DrawRectangle(0, 0, GAME_WIDTH, GAME_HEIGHT, (Color){200, 0, 0, 30});
     }
     
     // Tela de "vitória" ambivalente - será mesmo uma vitória?
-    if (g->phase == PHASE_WIN) {
+    if (f->phase == PHASE_WIN) {
         // Título com efeito de pulsação como batimentos cardíacos fracos
-        float heartbeat = 1.0f + 0.15f * sinf(g->frameCount * 0.04f);
+        float heartbeat = 1.0f + 0.15f * sinf(f->frameCount * 0.04f);
         int titleSize = 50 * heartbeat;
         
         // Alternar entre "LIBERTAÇÃO" e "DESESPERO" para criar ambiguidade
         const char *title;
-        if ((g->frameCount / 120) % 2 == 0) {
+        if ((f->frameCount / 120) % 2 == 0) {
             title = "LIBERTAÇÃO";
         } else {
             title = "DESESPERO";
@@ -599,26 +1002,26 @@ void GameDraw(const Game *g) {
         int titleWidth = MeasureText(title, titleSize);
         
         // Desenhar título com cor vermelha sangue e sombra
-        DrawText(title, GetScreenWidth()/2 - titleWidth/2 + 3, 140 + 3, titleSize, (Color){20, 0, 0, 255});
-        DrawText(title, GetScreenWidth()/2 - titleWidth/2, 140, titleSize, (Color){180, 0, 20, 255});
+        DrawText(title, GAME_WIDTH/2 - titleWidth/2 + 3, 140 + 3, titleSize, (Color){20, 0, 0, 255});
+        DrawText(title, GAME_WIDTH/2 - titleWidth/2, 140, titleSize, (Color){180, 0, 20, 255});
         
         // Mensagem ambígua
         const char *message = "Seu coração encontrou o que procurava?";
         int messageWidth = MeasureText(message, 24);
-        DrawText(message, GetScreenWidth()/2 - messageWidth/2, 210, 24, (Color){200, 200, 200, 220});
+        DrawText(message, GAME_WIDTH/2 - messageWidth/2, 210, 24, (Color){200, 200, 200, 220});
         
         // Mostrar pontuação final
         char scoreText[32];
-        sprintf(scoreText, "Final Score: %d", g->score);
+        sprintf(scoreText, "Final Score: %d", f->score);
         int scoreWidth = MeasureText(scoreText, 30);
-        DrawText(scoreText, GetScreenWidth()/2 - scoreWidth/2, 250, 30, GOLD);
+        DrawText(scoreText, GAME_WIDTH/2 - scoreWidth/2, 250, 30, GOLD);
         
         // Desenhar coração pixel art decorativo
-        float heartScale = 1.0f + 0.2f * sinf(g->frameCount * 0.1f);
+        float heartScale = 1.0f + 0.2f * sinf(f->frameCount * 0.1f);
         float heartSize = 30.0f * heartScale;
         float pixelSize = heartSize / 8.0f;
         
-        int x = GetScreenWidth()/2;
+        int x = GAME_WIDTH/2;
         int y = 300;
         
         Color heartColor = RED;
@@ -670,11 +1073,19 @@ void GameDraw(const Game *g) {
         // Instruções para reiniciar
         const char *restart = "Press ENTER to restart";
         int restartWidth = MeasureText(restart, 20);
-        DrawText(restart, GetScreenWidth()/2 - restartWidth/2, 350, 20, LIGHTGRAY);
+        DrawText(restart, GAME_WIDTH/2 - restartWidth/2, 350, 20, LIGHTGRAY);
         
         return;
     }
     
     // Desenhar HUD
-    HUDDraw(g);
+    AllocPhase previous = AllocTrackEnter(ALLOC_PHASE_HUD);
+    HUDDraw(f);
+    AllocTrackLeave(previous);
+}
+
+void GameDraw(const FramePacket *f) {
+    AllocPhase previous = AllocTrackEnter(ALLOC_PHASE_DRAW);
+    GameDrawFrame(f);
+    AllocTrackLeave(previous);
 }
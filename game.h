@@ -5,25 +5,42 @@
 #include "common.h" // Definições compartilhadas
 #include "player.h"
 #include "attack.h"
+#include "boss.h"
+#include "utils.h"
 
 // GamePhase agora está definido em common.h
 
+// Eventos agendados da batalha (ordem do enum = ordem de execução no mesmo frame)
+typedef enum {
+    EVENT_PROGRESS,         // Progresso do nível muda de porcentagem
+    EVENT_LEVEL_COMPLETE,   // Pontuação alvo do nível alcançada
+    EVENT_MOVE_CHANGE,      // Troca do tipo de movimento (LEVEL_HOPE)
+    EVENT_TAUNT,            // Mensagem perturbadora periódica
+    EVENT_WIN               // Sobreviveu tempo suficiente
+} GameEventType;
+
 // Forward declaration para resolver problemas de dependência circular
 typedef struct Game Game;
 
 struct Game {
     Player player;
-    AttackManager attacks;
+    Player partner;         // Segundo coração (só no modo cooperativo)
+    int coop;               // 1 = dois corações na mesma caixa de batalha
+    Boss boss;              // Chefe final (só em LEVEL_BOSS)
     GamePhase phase;
     GameLevel currentLevel;
     int levelProgress;      // Progresso dentro do nível atual (0-100%)
     int levelStartScore;    // Pontuação no início do nível atual
     int levelEndScore;      // Pontuação alvo para completar o nível
+    EventQueue events;      // Eventos agendados por frame (ver GameEventType)
+    Timer transitionTimer;  // Duração da transição entre níveis
     Rectangle battleBox;
     int frameCount;
     int score;
     int running;
     Music bgMusic;          // Música de fundo
+    int musicLoaded;        // 1 quando o carregamento em segundo plano termina
+    float musicVolume;      // Volume atual (sobe em fade-in até MUSIC_VOLUME)
     int musicPlaying;
     int audioResetCounter;  // Contador para reiniciar o áudio periodicamente
     
@@ -31,11 +48,89 @@ struct Game {
     Color bgColorTop;       // Cor do topo do gradiente de fundo
     Color bgColorBottom;    // Cor do fundo do gradiente de fundo
     float effectIntensity;  // Intensidade dos efeitos visuais (0.0-1.0)
+    
+    // Por último: termina no pool de projéteis, e o snapshot para nos vivos
+    AttackManager attacks;
 };
 
+// Cópia POD do estado da partida para reinício instantâneo e checkpoints.
+// O handle de música e o estado do áudio não fazem parte da cópia.
+// Só os primeiros GameSnapshotBytes(s) bytes valem: o pool de projéteis
+// tem espaço para o chefe (MAX_PROJECTILES), mas a cópia vai só até o fim
+// dos vivos, então um nível com 64 projéteis não paga pelos 3072 nem no
+// anel da rede, nem nos checkpoints, nem nos quadros-chave do replay.
+#define GAME_SNAPSHOT_VERSION 9
+
+typedef struct {
+    unsigned int version;   // GAME_SNAPSHOT_VERSION de quem capturou
+    unsigned int size;      // sizeof(Game) de quem capturou
+    Game game;
+} GameSnapshot;
+
+void GameSnapshotCapture(const Game *g, GameSnapshot *s);
+int GameSnapshotRestore(Game *g, const GameSnapshot *s);
+int GameSnapshotBytes(const GameSnapshot *s);       // 0 se a contagem de vivos for inválida
+void GameSnapshotCopy(GameSnapshot *dst, const GameSnapshot *src);
+void GameCopy(Game *dst, const Game *src);          // Cópia só até o fim dos projéteis vivos
+// Checkpoints de início de nível (usados por GameRestart). Ficam fora do
+// snapshot, então o replay os grava à parte.
+const GameSnapshot *GameCheckpointGet(GameLevel level, unsigned int *serial);  // NULL se não houver
+void GameCheckpointSet(GameLevel level, const GameSnapshot *s);                // NULL apaga
+// Conjunto de checkpoints ativo. Uma segunda partida no mesmo processo (o
+// fantasma) troca pelo seu enquanto simula e devolve o anterior depois.
+typedef struct {
+    GameSnapshot level[LEVEL_COUNT];
+    int valid[LEVEL_COUNT];
+    unsigned int serial[LEVEL_COUNT];   // Muda a cada captura
+} GameCheckpoints;
+GameCheckpoints *GameUseCheckpoints(GameCheckpoints *set);  // NULL = o da partida; retorna o anterior
+void GameRestart(Game *g, GameLevel level);
+
+// Teclas do frame, lidas na thread principal (a simulação não lê o teclado)
+typedef struct {
+    PlayerInput player;
+    int confirm;        // ENTER
+    int start;          // ENTER ou ESPAÇO
+    int restart;        // R
+    int practiceLevel;  // Nível escolhido com 1-6 (-1 se nenhum)
+} GameInput;
+
+// Tudo o que GameDraw e HUDDraw precisam de um tick, copiado depois dele.
+// O desenho lê só o pacote, então pode rodar enquanto o próximo tick simula.
+#define HUD_MSG_MAX 128
+typedef struct {
+    GamePhase phase;
+    GameLevel currentLevel;
+    int levelProgress;
+    int frameCount;
+    int score;
+    int running;
+    int coop;
+    Rectangle battleBox;
+    Color bgColorTop, bgColorBottom;
+    float effectIntensity;
+    Player player, partner;
+    AttackDrawState attacks;
+    BossDrawState boss;
+    char hudMsg[HUD_MSG_MAX];
+    int hudMsgFrames;
+    Player ghost;           // Coração do replay que corre junto (ver ghost.h)
+    int ghostVisible;
+    int ghostScore;
+} FramePacket;
+
 void SetupLevel(Game *g, GameLevel level);
 void GameInit(Game *g);
-void GameUpdate(Game *g);
-void GameDraw(const Game *g);
+void GameLoadAudio(Game *g);
+GameInput GameReadInput(void);
+void GameUpdate(Game *g, const GameInput *input);
+// Cooperativo em rede: menu e nova tentativa com os comandos dos dois lados
+// já juntados, e um PlayerInput por coração. Igual nos dois processos.
+void GameUpdateCoop(Game *g, const GameInput *commands, const PlayerInput inputs[2]);
+void GameUpdateAudio(Game *g);
+void GameTick(Game *g, const PlayerInput inputs[2]);
+unsigned int GameStateHash(const Game *g);
+void GameExtractFrame(const Game *g, FramePacket *f);
+void GameDraw(const FramePacket *f);
 
 #endif
@@ -0,0 +1,105 @@
+#include "ghost.h"
+#include "hud.h"
+#include "replay.h"
+#include "telemetry.h"
+
+static Game ghost;
+static GameCheckpoints ghostCheckpoints;    // Os do jogo ao vivo não servem
+static int active = 0;
+static int frame = 0, frameCount = 0;
+static int waiting = 1;              // A partida ao vivo ainda não largou
+static GameLevel liveLevel = LEVEL_VOID;
+static GhostStats stats;
+static double totalSeconds = 0.0;
+
+// Um tick do fantasma com os checkpoints e o HUD dele, fora da telemetria
+static void StepGhost(void) {
+    GameCheckpoints *own = GameUseCheckpoints(&ghostCheckpoints);
+    HUDMute(1);
+    TelemetryMute(1);
+    ReplayStep(&ghost, frame++);
+    TelemetryMute(0);
+    HUDMute(0);
+    GameUseCheckpoints(own);
+}
+
+int GhostStart(const char *path) {
+    if (!ReplayOpen(path)) return 0;
+
+    // A gravação começa no menu: pular até a partida começar, para largar
+    // junto com o jogador
+    GameInit(&ghost);
+    frameCount = ReplayFrameCount();
+    frame = 0;
+    while (frame < frameCount && ghost.phase == PHASE_MENU) StepGhost();
+
+    active = 1;
+    waiting = 1;
+    stats = (GhostStats){0};
+    totalSeconds = 0.0;
+    TraceLog(LOG_INFO, "GHOST: %s a partir do frame %d de %d", path, frame, frameCount);
+    return 1;
+}
+
+int GhostActive(void) {
+    return active;
+}
+
+void GhostStep(const Game *live) {
+    if (!active) return;
+    liveLevel = live->currentLevel;
+    if (live->phase == PHASE_MENU) {
+        waiting = 1;
+        return;
+    }
+    // No tick em que o jogador larga os dois acabaram de sair do menu
+    if (waiting) {
+        waiting = 0;
+        return;
+    }
+    if (frame >= frameCount) return;
+
+    double start = TimeNow();
+    StepGhost();
+    double us = (TimeNow() - start) * 1e6;
+
+    totalSeconds += us / 1e6;
+    stats.steps++;
+    if (us > stats.maxUs) {
+        stats.maxUs = us;
+        stats.maxProjectiles = ghost.attacks.streamStart[ATK_COUNT];
+    }
+}
+
+int GhostExtract(FramePacket *f) {
+    // Só faz sentido ver o fantasma no mesmo nível que o jogador
+    f->ghostVisible = active && ghost.currentLevel == liveLevel &&
+                      (ghost.phase == PHASE_BATTLE || ghost.phase == PHASE_BOSS || ghost.phase == PHASE_TRANSITION);
+    f->ghost = ghost.player;
+    f->ghostScore = ghost.score;
+    return f->ghostVisible;
+}
+
+void GhostGetStats(GhostStats *s) {
+    *s = stats;
+    s->avgUs = stats.steps ? totalSeconds * 1e6 / stats.steps : 0.0;
+    s->frame = frame;
+    s->frameCount = frameCount;
+}
+
+void GhostDrawStats(const GhostStats *s) {
+    DrawText(TextFormat("GHOST frame %d/%d  tick %.1f us (pior %.1f us, %d projéteis)",
+                        s->frame, s->frameCount, s->avgUs, s->maxUs, s->maxProjectiles),
+             10, GAME_HEIGHT - 84, 14, LIGHTGRAY);
+}
+
+void GhostStop(void) {
+    if (!active) return;
+    GhostStats s;
+    GhostGetStats(&s);
+    double frameUs = 1e6 / 60.0;
+    TraceLog(LOG_INFO, "GHOST: %ld ticks, média %.1f us, pior %.1f us com %d projéteis (%.2f%% do frame, limite %.0f%%)",
+             s.steps, s.avgUs, s.maxUs, s.maxProjectiles, 100.0 * s.maxUs / frameUs, 100.0 * GHOST_BUDGET_FRACTION);
+    ReplayClose();
+    active = 0;
+}
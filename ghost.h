@@ -0,0 +1,26 @@
+#ifndef GHOST_H
+#define GHOST_H
+#include "game.h"
+
+// Corrida contra um replay: uma segunda partida, comandada pelas entradas
+// gravadas, avança um tick a cada tick da partida ao vivo (começando junto
+// quando a partida sai do menu). Só o coração dela é desenhado, translúcido.
+// A segunda simulação tem que caber em GHOST_BUDGET_FRACTION de um frame.
+#define GHOST_BUDGET_FRACTION 0.10
+
+typedef struct {
+    long steps;
+    double avgUs, maxUs;            // Custo do tick do fantasma
+    int maxProjectiles;             // Projéteis do fantasma no tick mais caro
+    int frame, frameCount;          // Posição no replay
+} GhostStats;
+
+int GhostStart(const char *path);   // 0 se o replay não abrir
+int GhostActive(void);
+void GhostStep(const Game *live);   // Na thread da simulação, depois do tick ao vivo
+int GhostExtract(FramePacket *f);   // Preenche ghost* do pacote; 1 se visível
+void GhostGetStats(GhostStats *s);
+void GhostDrawStats(const GhostStats *s);
+void GhostStop(void);
+
+#endif
@@ -5,15 +5,18 @@
 #include <math.h>
 #include "hud.h"
 
-static char hudMsg[128] = "";
+static char hudMsg[HUD_MSG_MAX] = "";
 static int hudMsgFrames = 0;
+static int hudMuted = 0;
+static HUDState mutedMsg;           // Último pedido ignorado por estar mudo
+static int mutedPending = 0;
 
-void HUDDraw(const Game *g) {
+void HUDDraw(const FramePacket *f) {
     // Barra de vida estilizada
     DrawRectangleRounded((Rectangle){30, 30, 210, 30}, 0.3f, 10, (Color){40, 40, 40, 200});
     
     // Calcular largura da barra de vida
-    float healthPercent = g->player.hp / (float)g->player.maxHp;
+    float healthPercent = f->player.hp / (float)f->player.maxHp;
     int healthWidth = (int)(200 * healthPercent);
     
     // Cor da barra de vida baseada na quantidade de vida
@@ -31,15 +34,20 @@ void HUDDraw(const Game *g) {
     
     // Texto da vida com sombra
     char healthText[32];
-    sprintf(healthText, "HP: %d/%d", g->player.hp, g->player.maxHp);
+    sprintf(healthText, "HP: %d/%d", f->player.hp, f->player.maxHp);
     DrawText(healthText, 42, 38, 18, (Color){0, 0, 0, 120}); // Sombra
     DrawText(healthText, 40, 36, 18, WHITE);
     
+    // Vida do parceiro no modo cooperativo
+    if (f->coop) {
+        DrawText(TextFormat("P2 HP: %d/%d", f->partner.hp, f->partner.maxHp), 250, 38, 18, (Color){20, 180, 220, 255});
+    }
+    
     // Informações de fase e pontuação
     char phaseText[64];
     const char* phaseName = "";
     
-    switch(g->phase) {
+    switch(f->phase) {
         case PHASE_MENU: phaseName = "Menu"; break;
         case PHASE_GAME: phaseName = "Game"; break;
         case PHASE_BATTLE: phaseName = "Battle"; break;
@@ -54,59 +62,72 @@ void HUDDraw(const Game *g) {
     DrawText(phaseText, 30, 70, 20, GOLD);
     
     // Pontuação
-    DrawText(TextFormat("Score: %d", g->score), GetScreenWidth() - 150, 36, 20, SKYBLUE);
+    DrawText(TextFormat("Score: %d", f->score), GAME_WIDTH - 150, 36, 20, SKYBLUE);
+    
+    // Raspões da partida (os dois corações no cooperativo)
+    int grazes = f->player.grazeCount + (f->coop ? f->partner.grazeCount : 0);
+    if (grazes > 0) {
+        DrawText(TextFormat("Raspões: %d", grazes), GAME_WIDTH - 150, f->ghostVisible ? 76 : 58, 16, (Color){200, 200, 230, 255});
+    }
+    
+    // Vantagem sobre o fantasma (corrida contra o melhor replay)
+    if (f->ghostVisible) {
+        int lead = f->score - f->ghostScore;
+        DrawText(TextFormat("Fantasma: %+d", lead), GAME_WIDTH - 150, 58, 16,
+                 lead >= 0 ? (Color){120, 220, 140, 255} : (Color){200, 200, 255, 255});
+    }
     
     // Mostrar informações do nível atual (se estiver em batalha ou transição)
-    if (g->phase == PHASE_BATTLE || g->phase == PHASE_TRANSITION) {
+    if (f->phase == PHASE_BATTLE || f->phase == PHASE_BOSS || f->phase == PHASE_TRANSITION) {
         // Nomes dos níveis
         const char* levelNames[] = {
             "O Vazio",
             "Memórias Fragmentadas",
             "Arrependimentos",
             "Medos Profundos",
-            "Centelha de Esperança"
+            "Centelha de Esperança",
+            "O Coração Partido"
         };
         
-        // Mostrar nome do nível atual
+        // Mostrar nome do nível atual (no chefe, a barra é a vida que ele já perdeu)
         char levelText[64];
-        sprintf(levelText, "Nível %d: %s", g->currentLevel + 1, levelNames[g->currentLevel]);
-        DrawText(levelText, GetScreenWidth() - 300, 10, 20, WHITE);
+        if (f->currentLevel == LEVEL_BOSS) sprintf(levelText, "Chefe: %s", levelNames[f->currentLevel]);
+        else sprintf(levelText, "Nível %d: %s", f->currentLevel + 1, levelNames[f->currentLevel]);
+        DrawText(levelText, GAME_WIDTH - 300, 10, 20, WHITE);
         
         // Barra de progresso do nível (estilo Geometry Dash)
-        DrawRectangle(GetScreenWidth() - 300, 40, 250, 15, DARKGRAY);
-        DrawRectangle(GetScreenWidth() - 300, 40, (250 * g->levelProgress) / 100, 15, 
+        DrawRectangle(GAME_WIDTH - 300, 40, 250, 15, DARKGRAY);
+        DrawRectangle(GAME_WIDTH - 300, 40, (250 * f->levelProgress) / 100, 15, 
                      (Color){100, 200, 255, 255});
-        DrawRectangleLinesEx((Rectangle){GetScreenWidth() - 300, 40, 250, 15}, 1, WHITE);
+        DrawRectangleLinesEx((Rectangle){GAME_WIDTH - 300, 40, 250, 15}, 1, WHITE);
         
         // Mostrar porcentagem de progresso
         char progressText[16];
-        sprintf(progressText, "%d%%", g->levelProgress);
-        DrawText(progressText, GetScreenWidth() - 50, 38, 18, WHITE);
+        sprintf(progressText, "%d%%", f->levelProgress);
+        DrawText(progressText, GAME_WIDTH - 50, 38, 18, WHITE);
     }
     
     // Mensagem temporária com efeito de fade
-    if (hudMsgFrames > 0) {
-        float alpha = hudMsgFrames > 30 ? 1.0f : hudMsgFrames / 30.0f;
+    if (f->hudMsgFrames > 0) {
+        float alpha = f->hudMsgFrames > 30 ? 1.0f : f->hudMsgFrames / 30.0f;
         float scale = 1.0f + 0.2f * (1.0f - alpha); // Efeito de escala
         int fontSize = 22 * scale;
         
-        int textWidth = MeasureText(hudMsg, fontSize);
-        int xPos = GetScreenWidth()/2 - textWidth/2;
+        int textWidth = MeasureText(f->hudMsg, fontSize);
+        int xPos = GAME_WIDTH/2 - textWidth/2;
         
         // Desenhar caixa de mensagem
         DrawRectangleRounded((Rectangle){xPos - 10, 32 - 5, textWidth + 20, fontSize + 10}, 0.3f, 8, Fade(BLACK, 0.7f * alpha));
         
         // Desenhar texto com sombra
-        DrawText(hudMsg, xPos + 2, 34, fontSize, Fade((Color){0, 0, 0, 180}, alpha));
-        DrawText(hudMsg, xPos, 32, fontSize, Fade(WHITE, alpha));
-        
-        hudMsgFrames--;
+        DrawText(f->hudMsg, xPos + 2, 34, fontSize, Fade((Color){0, 0, 0, 180}, alpha));
+        DrawText(f->hudMsg, xPos, 32, fontSize, Fade(WHITE, alpha));
     }
     
     // Tela de morte estilizada
-    if (g->player.isDead) {
+    if (f->player.isDead) {
         // Fundo escuro com gradiente
-        DrawRectangleGradientV(0, 0, GetScreenWidth(), GetScreenHeight(), 
+        DrawRectangleGradientV(0, 0, GAME_WIDTH, GAME_HEIGHT, 
                              Fade((Color){20, 0, 0, 200}, 0.8f), 
                              Fade(BLACK, 0.9f));
         
@@ -116,17 +137,21 @@ void HUDDraw(const Game *g) {
         int textWidth = MeasureText(gameOverText, fontSize);
         
         // Sombra do texto
-        DrawText(gameOverText, GetScreenWidth()/2 - textWidth/2 + 4, 180 + 4, fontSize, (Color){100, 0, 0, 255});
-        DrawText(gameOverText, GetScreenWidth()/2 - textWidth/2, 180, fontSize, RED);
+        DrawText(gameOverText, GAME_WIDTH/2 - textWidth/2 + 4, 180 + 4, fontSize, (Color){100, 0, 0, 255});
+        DrawText(gameOverText, GAME_WIDTH/2 - textWidth/2, 180, fontSize, RED);
         
         // Instruções para reiniciar
         const char* restartText = "Press R to restart";
         int restartWidth = MeasureText(restartText, 24);
-        DrawText(restartText, GetScreenWidth()/2 - restartWidth/2, 260, 24, WHITE);
+        DrawText(restartText, GAME_WIDTH/2 - restartWidth/2, 260, 24, WHITE);
+        
+        const char* retryText = "Press ENTER to retry this level";
+        int retryWidth = MeasureText(retryText, 20);
+        DrawText(retryText, GAME_WIDTH/2 - retryWidth/2, 290, 20, LIGHTGRAY);
         
         // Desenhar coração quebrado
         float heartSize = 40.0f;
-        Vector2 heartPos = {GetScreenWidth()/2, 330};
+        Vector2 heartPos = {GAME_WIDTH/2, 330};
         
         // Desenhar metades do coração separadas
         DrawCircleV((Vector2){heartPos.x - heartSize/4 - 10, heartPos.y - heartSize/8}, heartSize/3, RED);
@@ -145,9 +170,9 @@ void HUDDraw(const Game *g) {
     }
     
     // Tela de vitória estilizada
-    if (g->phase == PHASE_WIN) {
+    if (f->phase == PHASE_WIN) {
         // Fundo claro com gradiente
-        DrawRectangleGradientV(0, 0, GetScreenWidth(), GetScreenHeight(), 
+        DrawRectangleGradientV(0, 0, GAME_WIDTH, GAME_HEIGHT, 
                              Fade((Color){50, 50, 100, 200}, 0.7f), 
                              Fade((Color){20, 20, 50, 200}, 0.8f));
         
@@ -157,24 +182,24 @@ void HUDDraw(const Game *g) {
         int textWidth = MeasureText(victoryText, fontSize);
         
         // Sombra do texto
-        DrawText(victoryText, GetScreenWidth()/2 - textWidth/2 + 4, 180 + 4, fontSize, (Color){0, 50, 0, 255});
-        DrawText(victoryText, GetScreenWidth()/2 - textWidth/2, 180, fontSize, GREEN);
+        DrawText(victoryText, GAME_WIDTH/2 - textWidth/2 + 4, 180 + 4, fontSize, (Color){0, 50, 0, 255});
+        DrawText(victoryText, GAME_WIDTH/2 - textWidth/2, 180, fontSize, GREEN);
         
         // Mensagem de parabéns
         const char* congratsText = "Congratulations!";
         int congratsWidth = MeasureText(congratsText, 30);
-        DrawText(congratsText, GetScreenWidth()/2 - congratsWidth/2, 260, 30, WHITE);
+        DrawText(congratsText, GAME_WIDTH/2 - congratsWidth/2, 260, 30, WHITE);
         
         // Pontuação final
         char scoreText[64];
-        sprintf(scoreText, "Final Score: %d", g->score);
+        sprintf(scoreText, "Final Score: %d", f->score);
         int scoreWidth = MeasureText(scoreText, 24);
-        DrawText(scoreText, GetScreenWidth()/2 - scoreWidth/2, 300, 24, GOLD);
+        DrawText(scoreText, GAME_WIDTH/2 - scoreWidth/2, 300, 24, GOLD);
         
         // Desenhar coração pulsante
         float pulse = sinf(GetTime() * 5.0f) * 0.2f + 1.0f;
         float heartSize = 50.0f * pulse;
-        Vector2 heartPos = {GetScreenWidth()/2, 370};
+        Vector2 heartPos = {GAME_WIDTH/2, 370};
         
         // Desenhar dois círculos para formar o topo do coração
         DrawCircleV((Vector2){heartPos.x - heartSize/4, heartPos.y - heartSize/8}, heartSize/3, RED);
@@ -188,8 +213,8 @@ void HUDDraw(const Game *g) {
         
         // Desenhar partículas de celebração
         for (int i = 0; i < 20; i++) {
-            float x = GetRandomValue(0, GetScreenWidth());
-            float y = GetRandomValue(0, GetScreenHeight());
+            float x = GetRandomValue(0, GAME_WIDTH);
+            float y = GetRandomValue(0, GAME_HEIGHT);
             float size = GetRandomValue(2, 5);
             Color particleColor = (Color){
                 GetRandomValue(100, 255),
@@ -203,8 +228,44 @@ void HUDDraw(const Game *g) {
 }
 
 void HUDShowMessage(const char *msg, int frames) {
-    strncpy(hudMsg, msg, sizeof(hudMsg)-1);
-    hudMsg[sizeof(hudMsg)-1] = '\0';
+    char *dst = hudMuted ? mutedMsg.msg : hudMsg;
+    strncpy(dst, msg, HUD_MSG_MAX-1);
+    dst[HUD_MSG_MAX-1] = '\0';
+    if (hudMuted) {
+        mutedMsg.frames = frames;
+        mutedPending = 1;
+        return;
+    }
     hudMsgFrames = frames;
 }
 
+void HUDMute(int muted) {
+    hudMuted = muted;
+    mutedPending = 0;
+}
+
+int HUDTakeMuted(HUDState *s) {
+    if (!mutedPending) return 0;
+    *s = mutedMsg;
+    mutedPending = 0;
+    return 1;
+}
+
+void HUDGetState(HUDState *s) {
+    memcpy(s->msg, hudMsg, sizeof(s->msg));
+    s->frames = hudMsgFrames;
+}
+
+void HUDSetState(const HUDState *s) {
+    memcpy(hudMsg, s->msg, sizeof(hudMsg));
+    hudMsgFrames = s->frames;
+}
+
+void HUDUpdate(void) {
+    if (hudMsgFrames > 0) hudMsgFrames--;
+}
+
+void HUDExtract(FramePacket *f) {
+    memcpy(f->hudMsg, hudMsg, sizeof(f->hudMsg));
+    f->hudMsgFrames = hudMsgFrames;
+}
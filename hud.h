@@ -4,7 +4,21 @@
 // Game já está definido em game.h
 #include "game.h"
 
-void HUDDraw(const Game *g);
+// Mensagem na tela e quantos frames ela ainda fica
+typedef struct {
+    char msg[HUD_MSG_MAX];
+    int frames;
+} HUDState;
+
+void HUDDraw(const FramePacket *f);
 void HUDShowMessage(const char *msg, int frames);
+void HUDMute(int muted);            // Ignora mensagens (simulação do fantasma)
+// A última mensagem pedida enquanto mudo, desde a última chamada (0 se nenhuma).
+// A ressimulação da rede usa para refazer o HUD do estado corrigido.
+int HUDTakeMuted(HUDState *s);
+void HUDGetState(HUDState *s);
+void HUDSetState(const HUDState *s);
+void HUDUpdate(void);               // Conta a duração da mensagem (uma vez por frame)
+void HUDExtract(FramePacket *f);    // Copia a mensagem atual para o pacote
 
 #endif
@@ -0,0 +1,236 @@
+#define _POSIX_C_SOURCE 200809L
+#include "input.h"
+// Sem raylib.h aqui: os KEY_* do kernel colidem com os da raylib
+#include <linux/input.h>
+#include <dirent.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/ioctl.h>
+#include <time.h>
+#include <unistd.h>
+
+// Teclas que o coração usa (as mesmas de PlayerReadInput)
+static const struct {
+    unsigned short code;
+    unsigned char buttons;
+    unsigned char jump;             // Apertar gera INPUT_JUMP
+} keyTable[] = {
+    { KEY_LEFT,       INPUT_LEFT,  0 },
+    { KEY_A,          INPUT_LEFT,  0 },
+    { KEY_RIGHT,      INPUT_RIGHT, 0 },
+    { KEY_D,          INPUT_RIGHT, 0 },
+    { KEY_UP,         INPUT_UP,    1 },
+    { KEY_W,          INPUT_UP,    1 },
+    { KEY_DOWN,       INPUT_DOWN,  0 },
+    { KEY_S,          INPUT_DOWN,  0 },
+    { KEY_SPACE,      0,           1 },
+    { KEY_LEFTSHIFT,  INPUT_DASH,  0 },
+    { KEY_RIGHTSHIFT, INPUT_DASH,  0 },
+};
+#define KEY_TABLE_COUNT ((int)(sizeof(keyTable) / sizeof(keyTable[0])))
+
+// Fila de um produtor (thread de entrada) e um consumidor (quem monta o tick)
+static InputEvent queue[INPUT_QUEUE_SIZE];
+static atomic_uint queueHead, queueTail;
+static atomic_int stopping;
+static atomic_long dropped;
+
+static int devices[INPUT_MAX_DEVICES];
+static int deviceCount = 0;
+static int monotonicStamps = 1;     // Os dispositivos aceitaram CLOCK_MONOTONIC
+static pthread_t thread;
+static int running = 0;
+
+// Estado do consumidor
+static unsigned int heldKeys = 0;
+static unsigned char lastHorizontal = 0, lastVertical = 0;  // Direção apertada por último em cada eixo
+static long consumed = 0;
+static double waitSum = 0.0;
+
+static double Now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static int HasBit(const unsigned long *bits, int bit) {
+    int width = 8 * sizeof(unsigned long);
+    return (bits[bit / width] >> (bit % width)) & 1;
+}
+
+static void Push(const InputEvent *ev) {
+    unsigned int head = atomic_load_explicit(&queueHead, memory_order_relaxed);
+    unsigned int tail = atomic_load_explicit(&queueTail, memory_order_acquire);
+    if (head - tail == INPUT_QUEUE_SIZE) {
+        atomic_fetch_add(&dropped, 1);
+        return;
+    }
+    queue[head & (INPUT_QUEUE_SIZE - 1)] = *ev;
+    atomic_store_explicit(&queueHead, head + 1, memory_order_release);
+}
+
+static int Pop(InputEvent *ev) {
+    unsigned int tail = atomic_load_explicit(&queueTail, memory_order_relaxed);
+    unsigned int head = atomic_load_explicit(&queueHead, memory_order_acquire);
+    if (tail == head) return 0;
+    *ev = queue[tail & (INPUT_QUEUE_SIZE - 1)];
+    atomic_store_explicit(&queueTail, tail + 1, memory_order_release);
+    return 1;
+}
+
+static int FindKey(unsigned short code) {
+    for (int i = 0; i < KEY_TABLE_COUNT; i++) {
+        if (keyTable[i].code == code) return i;
+    }
+    return -1;
+}
+
+static void *InputThread(void *arg) {
+    (void)arg;
+    struct pollfd fds[INPUT_MAX_DEVICES];
+    for (int i = 0; i < deviceCount; i++) {
+        fds[i].fd = devices[i];
+        fds[i].events = POLLIN;
+    }
+
+    // Timeout curto só para perceber o InputStop
+    while (!atomic_load(&stopping)) {
+        if (poll(fds, deviceCount, 100) <= 0) continue;
+
+        for (int d = 0; d < deviceCount; d++) {
+            if (!(fds[d].revents & POLLIN)) continue;
+
+            struct input_event raw[32];
+            ssize_t bytes;
+            while ((bytes = read(fds[d].fd, raw, sizeof(raw))) > 0) {
+                int count = bytes / sizeof(raw[0]);
+                for (int i = 0; i < count; i++) {
+                    // value: 0 = solta, 1 = aperta, 2 = repetição automática (ignorada)
+                    if (raw[i].type != EV_KEY || raw[i].value > 1) continue;
+                    int key = FindKey(raw[i].code);
+                    if (key < 0) continue;
+
+                    InputEvent ev;
+                    ev.time = monotonicStamps ? raw[i].input_event_sec + raw[i].input_event_usec / 1e6 : Now();
+                    ev.key = (unsigned char)key;
+                    ev.down = (unsigned char)raw[i].value;
+                    Push(&ev);
+                }
+            }
+        }
+    }
+    return NULL;
+}
+
+// Abre os teclados em /dev/input (precisa de permissão, em geral o grupo input)
+static void OpenKeyboards(void) {
+    DIR *dir = opendir("/dev/input");
+    if (!dir) return;
+
+    struct dirent *entry;
+    while ((entry = readdir(dir)) != NULL && deviceCount < INPUT_MAX_DEVICES) {
+        if (strncmp(entry->d_name, "event", 5) != 0) continue;
+
+        char path[300];
+        snprintf(path, sizeof(path), "/dev/input/%s", entry->d_name);
+        int fd = open(path, O_RDONLY | O_NONBLOCK | O_CLOEXEC);
+        if (fd < 0) continue;
+
+        unsigned long keyBits[KEY_MAX / (8 * sizeof(unsigned long)) + 1] = {0};
+        if (ioctl(fd, EVIOCGBIT(EV_KEY, sizeof(keyBits)), keyBits) < 0 ||
+            !HasBit(keyBits, KEY_SPACE) || !HasBit(keyBits, KEY_A)) {
+            close(fd);  // Mouse, botão de energia etc.
+            continue;
+        }
+
+        // Horários no mesmo relógio de TimeNow()
+        int clockId = CLOCK_MONOTONIC;
+        if (ioctl(fd, EVIOCSCLOCKID, &clockId) < 0) monotonicStamps = 0;
+        devices[deviceCount++] = fd;
+    }
+    closedir(dir);
+}
+
+int InputStart(void) {
+    if (running) return 1;
+    OpenKeyboards();
+    if (deviceCount == 0) return 0;
+
+    atomic_store(&stopping, 0);
+    if (pthread_create(&thread, NULL, InputThread, NULL) != 0) {
+        for (int i = 0; i < deviceCount; i++) close(devices[i]);
+        deviceCount = 0;
+        return 0;
+    }
+    running = 1;
+    return 1;
+}
+
+int InputActive(void) {
+    return running;
+}
+
+// Direções opostas no mesmo tick: vale a apertada por último (um toque
+// curto para a esquerda segurando a direita ainda move para a esquerda)
+static unsigned char ResolveAxis(unsigned char buttons, unsigned char axis, unsigned char last) {
+    if ((buttons & axis) == axis) buttons &= (unsigned char)~(axis & ~last);
+    return buttons;
+}
+
+int InputRead(PlayerInput *out, int focused) {
+    if (!running) return 0;
+
+    // Uma tecla apertada e solta dentro do mesmo frame ainda conta neste tick
+    unsigned int touched = heldKeys;
+    int jump = 0;
+    double now = Now();
+    InputEvent ev;
+    while (Pop(&ev)) {
+        unsigned int bit = 1u << ev.key;
+        if (ev.down) {
+            unsigned char buttons = keyTable[ev.key].buttons;
+            heldKeys |= bit;
+            touched |= bit;
+            if (keyTable[ev.key].jump) jump = 1;
+            if (buttons & (INPUT_LEFT | INPUT_RIGHT)) lastHorizontal = buttons;
+            if (buttons & (INPUT_UP | INPUT_DOWN)) lastVertical = buttons;
+        } else {
+            heldKeys &= ~bit;
+        }
+        consumed++;
+        waitSum += now - ev.time;
+    }
+
+    out->buttons = 0;
+    // evdev vê o teclado mesmo com a janela em segundo plano
+    if (!focused) {
+        heldKeys = 0;
+        return 1;
+    }
+    for (int i = 0; i < KEY_TABLE_COUNT; i++) {
+        if (touched & (1u << i)) out->buttons |= keyTable[i].buttons;
+    }
+    out->buttons = ResolveAxis(out->buttons, INPUT_LEFT | INPUT_RIGHT, lastHorizontal);
+    out->buttons = ResolveAxis(out->buttons, INPUT_UP | INPUT_DOWN, lastVertical);
+    if (jump) out->buttons |= INPUT_JUMP;
+    return 1;
+}
+
+void InputGetStats(long *events, long *lost, double *avgWaitMs) {
+    *events = consumed;
+    *lost = atomic_load(&dropped);
+    *avgWaitMs = consumed ? waitSum * 1000.0 / consumed : 0.0;
+}
+
+void InputStop(void) {
+    if (!running) return;
+    atomic_store(&stopping, 1);
+    pthread_join(thread, NULL);
+    for (int i = 0; i < deviceCount; i++) close(devices[i]);
+    deviceCount = 0;
+    running = 0;
+}
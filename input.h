@@ -0,0 +1,43 @@
+#ifndef INPUT_H
+#define INPUT_H
+
+// Entrada de um jogador em um tick. Vem do teclado ou da rede, então
+// PlayerUpdate não lê o teclado diretamente.
+enum {
+    INPUT_LEFT  = 1 << 0,
+    INPUT_RIGHT = 1 << 1,
+    INPUT_UP    = 1 << 2,
+    INPUT_DOWN  = 1 << 3,
+    INPUT_JUMP  = 1 << 4,   // Pulo apertado neste tick (borda, não nível)
+    INPUT_DASH  = 1 << 5
+};
+typedef struct { unsigned char buttons; } PlayerInput;
+
+// Teclado cru (evdev no Linux): uma thread lê /dev/input e guarda cada
+// aperto/solta com horário numa fila sem trava. A cada tick a fila é
+// consumida inteira, então um toque mais curto que um frame não se perde.
+// Sem acesso aos dispositivos o jogo continua lendo o teclado pela raylib.
+#define INPUT_QUEUE_SIZE 256        // Potência de 2
+#define INPUT_MAX_DEVICES 8
+
+typedef struct {
+    double time;                    // Relógio de TimeNow()
+    unsigned char key;              // Índice na tabela de teclas do jogo
+    unsigned char down;
+} InputEvent;
+
+int InputStart(void);               // 1 se a thread evdev está rodando
+int InputActive(void);
+// Consome os eventos pendentes e devolve os botões do tick. Retorna 0 se
+// não há backend cru (quem chama usa a raylib).
+//
+// A ordem dos eventos é resolvida aqui e não chega à simulação: o tick
+// recebe um byte de botões por coração, que é o que o replay grava e a
+// rede troca. Dentro do tick, um toque (aperta e solta) ainda conta, o pulo
+// vale se houve qualquer aperto e, entre direções opostas, vale a última.
+int InputRead(PlayerInput *out, int focused);
+// Eventos consumidos, perdidos por fila cheia e espera média até o tick
+void InputGetStats(long *events, long *lost, double *avgWaitMs);
+void InputStop(void);
+
+#endif
@@ -0,0 +1,103 @@
+#define _POSIX_C_SOURCE 200809L
+#include "leaderboard.h"
+#include <stdio.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#define LEADERBOARD_TIMEOUT_MS 2000
+
+// Conecta ao serviço com timeout de envio e recebimento (-1 se não houver)
+static int Connect(void) {
+    int fd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (fd < 0) return -1;
+
+    struct timeval timeout = { LEADERBOARD_TIMEOUT_MS / 1000, (LEADERBOARD_TIMEOUT_MS % 1000) * 1000 };
+    setsockopt(fd, SOL_SOCKET, SO_SNDTIMEO, &timeout, sizeof(timeout));
+    setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+
+    struct sockaddr_un addr = {0};
+    addr.sun_family = AF_UNIX;
+    strncpy(addr.sun_path, LEADERBOARD_SOCKET, sizeof(addr.sun_path) - 1);
+    if (connect(fd, (struct sockaddr *)&addr, sizeof(addr)) < 0) {
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+static int SendAll(int fd, const void *data, size_t size) {
+    const char *p = data;
+    while (size > 0) {
+        ssize_t sent = send(fd, p, size, MSG_NOSIGNAL);
+        if (sent <= 0) return 0;
+        p += sent;
+        size -= sent;
+    }
+    return 1;
+}
+
+static int RecvAll(int fd, void *data, size_t size) {
+    char *p = data;
+    while (size > 0) {
+        ssize_t got = recv(fd, p, size, 0);
+        if (got <= 0) return 0;
+        p += got;
+        size -= got;
+    }
+    return 1;
+}
+
+int LeaderboardSubmit(const char *replayPath, const char *name, int score, unsigned int *ticket) {
+    FILE *f = fopen(replayPath, "rb");
+    if (!f) return 0;
+    fseek(f, 0, SEEK_END);
+    long size = ftell(f);
+    rewind(f);
+    if (size <= 0 || size > LEADERBOARD_MAX_REPLAY) {
+        fclose(f);
+        return 0;
+    }
+
+    int fd = Connect();
+    if (fd < 0) {
+        fclose(f);
+        return 0;
+    }
+
+    LeaderboardRequest req = { LEADERBOARD_MAGIC, LEADERBOARD_SUBMIT, {0}, score, (unsigned int)size };
+    strncpy(req.name, name, LEADERBOARD_NAME_MAX - 1);
+    int ok = SendAll(fd, &req, sizeof(req));
+
+    // O serviço só grava o arquivo e responde; a verificação fica para depois
+    char buffer[64 * 1024];
+    size_t chunk;
+    while (ok && (chunk = fread(buffer, 1, sizeof(buffer), f)) > 0) ok = SendAll(fd, buffer, chunk);
+    fclose(f);
+
+    LeaderboardReply reply;
+    ok = ok && RecvAll(fd, &reply, sizeof(reply)) && reply.status == LEADERBOARD_QUEUED;
+    close(fd);
+    if (ok && ticket) *ticket = reply.ticket;
+    return ok;
+}
+
+int LeaderboardTop(LeaderboardEntry *out, int max) {
+    int fd = Connect();
+    if (fd < 0) return 0;
+
+    LeaderboardRequest req = { LEADERBOARD_MAGIC, LEADERBOARD_TOP, {0}, 0, 0 };
+    LeaderboardReply reply;
+    int count = 0;
+    if (SendAll(fd, &req, sizeof(req)) && RecvAll(fd, &reply, sizeof(reply)) && reply.status == LEADERBOARD_OK) {
+        for (unsigned int i = 0; i < reply.count; i++) {
+            LeaderboardEntry entry;
+            if (!RecvAll(fd, &entry, sizeof(entry))) break;
+            if (count < max) out[count++] = entry;
+        }
+    }
+    close(fd);
+    return count;
+}
@@ -0,0 +1,58 @@
+#ifndef LEADERBOARD_H
+#define LEADERBOARD_H
+
+// Placar local: o jogo envia o replay da partida para o serviço
+// leaderboardd por um socket Unix; o serviço refaz a partida sem janela e
+// só guarda a pontuação se ela bater com a da ressimulação. Pontuação de
+// um replay = maior g->score alcançado em qualquer frame dele.
+//
+// Protocolo (uma requisição por conexão, inteiros na ordem da máquina):
+//   envio: LeaderboardRequest | bytes do replay -> LeaderboardReply
+//   top:   LeaderboardRequest                  -> LeaderboardReply | LeaderboardEntry[count]
+#define LEADERBOARD_SOCKET "/tmp/heartgame-leaderboard.sock"
+#define LEADERBOARD_MAGIC "HLBD"
+#define LEADERBOARD_NAME_MAX 16
+#define LEADERBOARD_TOP_MAX 20
+#define LEADERBOARD_MAX_REPLAY (64 * 1024 * 1024)
+
+typedef enum {
+    LEADERBOARD_SUBMIT,
+    LEADERBOARD_TOP
+} LeaderboardRequestType;
+
+typedef enum {
+    LEADERBOARD_QUEUED,         // Aceito; a verificação acontece depois
+    LEADERBOARD_BUSY,           // Fila cheia, tente de novo mais tarde
+    LEADERBOARD_INVALID,        // Requisição malformada ou replay grande demais
+    LEADERBOARD_OK              // Resposta de LEADERBOARD_TOP
+} LeaderboardStatus;
+
+typedef struct {
+    char magic[4];
+    unsigned int type;          // LeaderboardRequestType
+    char name[LEADERBOARD_NAME_MAX];
+    int claimedScore;
+    unsigned int replaySize;
+} LeaderboardRequest;
+
+typedef struct {
+    unsigned int status;        // LeaderboardStatus
+    unsigned int ticket;        // Número do envio (LEADERBOARD_QUEUED)
+    unsigned int count;         // Entradas que seguem (LEADERBOARD_OK)
+} LeaderboardReply;
+
+// Registro do log (só acrescentado) e do índice em memória
+typedef struct {
+    char name[LEADERBOARD_NAME_MAX];
+    int score;
+    unsigned int frames;        // Duração do replay
+    unsigned int ticket;
+    long long time;             // Segundos desde a época, quando foi verificado
+} LeaderboardEntry;
+
+// Cliente (usado pelo jogo). LeaderboardSubmit retorna 0 se o serviço não
+// aceitou o envio; LeaderboardTop devolve quantas entradas leu.
+int LeaderboardSubmit(const char *replayPath, const char *name, int score, unsigned int *ticket);
+int LeaderboardTop(LeaderboardEntry *out, int max);
+
+#endif
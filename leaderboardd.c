@@ -0,0 +1,506 @@
+// Serviço do placar local: recebe replays do jogo por LEADERBOARD_SOCKET,
+// refaz cada partida sem janela num grupo de processos de trabalho e grava
+// as pontuações confirmadas num log que só cresce.
+//   ./leaderboardd [--workers N] [--log ARQUIVO] [--spool DIR]
+//   ./leaderboardd --top        (consulta o serviço que está rodando)
+// A thread única faz só E/S sem bloquear: um envio é gravado em disco e
+// respondido na hora, e a verificação entra numa fila. Os trabalhadores são
+// processos (fork), não threads, porque o estado da simulação é estático
+// por módulo (checkpoints de game.c, cache de padrões).
+#define _POSIX_C_SOURCE 200809L
+#include "leaderboard.h"
+#include "replay.h"
+#include "utils.h"
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <sys/wait.h>
+#include <time.h>
+#include <unistd.h>
+
+#define DAEMON_MAX_CLIENTS 32
+#define DAEMON_MAX_WORKERS 32
+#define DAEMON_QUEUE_SIZE 256           // Envios esperando verificação
+#define DAEMON_INDEX_MAX 65536          // Melhores pontuações mantidas em memória
+#define DAEMON_CLIENT_TIMEOUT 5.0       // s sem dados até derrubar a conexão
+#define DAEMON_STATS_INTERVAL 10.0      // s entre relatórios de vazão
+
+typedef struct {
+    unsigned int ticket;
+    char name[LEADERBOARD_NAME_MAX];
+    int claimedScore;
+} Job;
+
+typedef enum {
+    VERIFY_OK,
+    VERIFY_UNREADABLE,      // ReplayOpen recusou (corrompido ou de outro build)
+    VERIFY_DESYNC,          // Quadro-chave diferente da ressimulação
+    VERIFY_CRASHED          // O trabalhador morreu sem responder
+} VerifyStatus;
+
+typedef struct {
+    unsigned int status;    // VerifyStatus
+    int score;
+    unsigned int frames;
+} VerifyResult;
+
+typedef struct {
+    int fd;                 // -1 = livre
+    LeaderboardRequest req;
+    size_t headerBytes;
+    unsigned int payloadBytes;
+    int spool;
+    unsigned int ticket;
+    double lastActivity;
+} Client;
+
+typedef struct {
+    pid_t pid;              // 0 = livre
+    int pipe;
+    Job job;
+    double start;
+} Worker;
+
+static const char *logPath = "leaderboard.log";
+static const char *spoolDir = "leaderboard-spool";
+static int workerCount = 0;
+
+static volatile sig_atomic_t stopping = 0;
+static int listenFd = -1;
+static int logFd = -1;
+static Client clients[DAEMON_MAX_CLIENTS];
+static Worker workers[DAEMON_MAX_WORKERS];
+static Job queue[DAEMON_QUEUE_SIZE];
+static int queueHead = 0, queueCount = 0, queueMax = 0;
+static unsigned int nextTicket = 1;
+static Game initialGame;    // Estado de GameInit, herdado pelos trabalhadores
+
+// Índice em memória: ordenado por pontuação (empate: envio mais antigo antes)
+static LeaderboardEntry board[DAEMON_INDEX_MAX];
+static int boardCount = 0;
+
+// Vazão (no intervalo atual e desde o início)
+typedef struct {
+    long accepted, rejected;
+    long ticks;
+    double verifySeconds;
+} Throughput;
+static Throughput interval, total;
+
+static void OnSignal(int sig) {
+    (void)sig;
+    stopping = 1;
+}
+
+static void SpoolPath(unsigned int ticket, char *path, size_t size) {
+    snprintf(path, size, "%s/%u.hrep", spoolDir, ticket);
+}
+
+static int Ranks(const LeaderboardEntry *a, const LeaderboardEntry *b) {
+    return a->score > b->score || (a->score == b->score && a->ticket < b->ticket);
+}
+
+static void BoardInsert(const LeaderboardEntry *entry) {
+    if (boardCount == DAEMON_INDEX_MAX && !Ranks(entry, &board[boardCount - 1])) return;
+
+    int lo = 0, hi = boardCount;
+    while (lo < hi) {
+        int mid = (lo + hi) / 2;
+        if (Ranks(&board[mid], entry)) lo = mid + 1;
+        else hi = mid;
+    }
+    if (boardCount == DAEMON_INDEX_MAX) boardCount--;   // Sai o último
+    memmove(&board[lo + 1], &board[lo], (boardCount - lo) * sizeof(board[0]));
+    board[lo] = *entry;
+    boardCount++;
+}
+
+// Reconstrói o índice a partir do log (um registro incompleto no fim é ignorado)
+static int LoadLog(void) {
+    logFd = open(logPath, O_RDWR | O_CREAT | O_APPEND | O_CLOEXEC, 0644);
+    if (logFd < 0) {
+        perror(logPath);
+        return 0;
+    }
+
+    LeaderboardEntry entry;
+    long count = 0;
+    while (read(logFd, &entry, sizeof(entry)) == sizeof(entry)) {
+        BoardInsert(&entry);
+        if (entry.ticket >= nextTicket) nextTicket = entry.ticket + 1;
+        count++;
+    }
+    printf("leaderboardd: %ld pontuações em %s\n", count, logPath);
+    return 1;
+}
+
+static void LogAppend(const LeaderboardEntry *entry) {
+    if (write(logFd, entry, sizeof(*entry)) != sizeof(*entry)) perror(logPath);
+    else fdatasync(logFd);
+}
+
+// Processo de trabalho: refaz a partida a partir de GameInit só com as
+// entradas gravadas. Os quadros-chave servem para conferir a ressimulação,
+// nunca como ponto de partida (senão um snapshot forjado valeria).
+static void VerifyJob(const Job *job, int out) {
+    VerifyResult result = { VERIFY_UNREADABLE, 0, 0 };
+    char path[512];
+    SpoolPath(job->ticket, path, sizeof(path));
+
+    if (ReplayOpen(path)) {
+        static Game g;
+        g = initialGame;
+        int frames = ReplayFrameCount();
+        int best = g.score;
+        result.status = VERIFY_OK;
+        for (int f = 0; f < frames; f++) {
+            const GameSnapshot *keyframe = ReplayKeyframe(f);
+            if (keyframe && GameStateHash(&keyframe->game) != GameStateHash(&g)) {
+                result.status = VERIFY_DESYNC;
+                break;
+            }
+            ReplayStep(&g, f);
+            if (g.score > best) best = g.score;
+        }
+        result.score = best;
+        result.frames = frames;
+        ReplayClose();
+    }
+    if (write(out, &result, sizeof(result)) != sizeof(result)) _exit(1);
+    _exit(0);
+}
+
+static void Dispatch(void) {
+    for (int w = 0; w < workerCount && queueCount > 0; w++) {
+        if (workers[w].pid) continue;
+
+        int fds[2];
+        if (pipe(fds) < 0) return;
+        Job *job = &queue[queueHead];
+        pid_t pid = fork();
+        if (pid < 0) {
+            close(fds[0]);
+            close(fds[1]);
+            return;
+        }
+        if (pid == 0) {
+            close(fds[0]);
+            close(listenFd);
+            for (int c = 0; c < DAEMON_MAX_CLIENTS; c++) {
+                if (clients[c].fd >= 0) close(clients[c].fd);
+            }
+            VerifyJob(job, fds[1]);
+        }
+        close(fds[1]);
+        workers[w] = (Worker){ pid, fds[0], *job, TimeNow() };
+        queueHead = (queueHead + 1) % DAEMON_QUEUE_SIZE;
+        queueCount--;
+    }
+}
+
+static void FinishWorker(Worker *w) {
+    VerifyResult result = { VERIFY_CRASHED, 0, 0 };
+    if (read(w->pipe, &result, sizeof(result)) != sizeof(result)) result = (VerifyResult){ VERIFY_CRASHED, 0, 0 };
+    close(w->pipe);
+    waitpid(w->pid, NULL, 0);
+    w->pid = 0;
+
+    double seconds = TimeNow() - w->start;
+    const Job *job = &w->job;
+    char path[512];
+    SpoolPath(job->ticket, path, sizeof(path));
+    unlink(path);
+
+    static const char *reasons[] = { "pontuação diferente", "replay ilegível", "ressimulação divergiu", "verificação falhou" };
+    Throughput *counters[] = { &interval, &total };
+    for (int i = 0; i < 2; i++) {
+        counters[i]->ticks += result.frames;
+        counters[i]->verifySeconds += seconds;
+    }
+
+    if (result.status == VERIFY_OK && result.score == job->claimedScore) {
+        LeaderboardEntry entry = {0};
+        memcpy(entry.name, job->name, LEADERBOARD_NAME_MAX);
+        entry.name[LEADERBOARD_NAME_MAX - 1] = '\0';
+        entry.score = result.score;
+        entry.frames = result.frames;
+        entry.ticket = job->ticket;
+        entry.time = (long long)time(NULL);
+        LogAppend(&entry);
+        BoardInsert(&entry);
+        interval.accepted++;
+        total.accepted++;
+        printf("leaderboardd: #%u %s: %d pontos confirmados (%u frames em %.1f ms)\n",
+               job->ticket, entry.name, entry.score, result.frames, seconds * 1000.0);
+    } else {
+        interval.rejected++;
+        total.rejected++;
+        printf("leaderboardd: #%u recusado: %s (declarou %d, replay deu %d)\n",
+               job->ticket, reasons[result.status == VERIFY_OK ? 0 : result.status], job->claimedScore, result.score);
+    }
+}
+
+static void CloseClient(Client *c) {
+    if (c->spool >= 0) {
+        // Envio interrompido no meio: o arquivo parcial não serve
+        char path[512];
+        SpoolPath(c->ticket, path, sizeof(path));
+        close(c->spool);
+        unlink(path);
+    }
+    close(c->fd);
+    c->fd = -1;
+    c->spool = -1;
+}
+
+static void Reply(Client *c, LeaderboardStatus status, const void *extra, size_t extraSize) {
+    LeaderboardReply reply = { status, c->ticket, (unsigned int)(extraSize / sizeof(LeaderboardEntry)) };
+    // Cabe inteiro no buffer de um socket recém-aberto
+    if (send(c->fd, &reply, sizeof(reply), MSG_NOSIGNAL) == sizeof(reply) && extraSize > 0) {
+        send(c->fd, extra, extraSize, MSG_NOSIGNAL);
+    }
+}
+
+// Cabeçalho completo: responde consultas e prepara o arquivo do envio
+static void StartRequest(Client *c) {
+    const LeaderboardRequest *req = &c->req;
+    if (memcmp(req->magic, LEADERBOARD_MAGIC, 4) != 0) {
+        Reply(c, LEADERBOARD_INVALID, NULL, 0);
+        CloseClient(c);
+        return;
+    }
+
+    if (req->type == LEADERBOARD_TOP) {
+        int count = boardCount < LEADERBOARD_TOP_MAX ? boardCount : LEADERBOARD_TOP_MAX;
+        Reply(c, LEADERBOARD_OK, board, count * sizeof(board[0]));
+        CloseClient(c);
+        return;
+    }
+
+    if (req->type != LEADERBOARD_SUBMIT || req->replaySize == 0 || req->replaySize > LEADERBOARD_MAX_REPLAY) {
+        Reply(c, LEADERBOARD_INVALID, NULL, 0);
+        CloseClient(c);
+        return;
+    }
+    // Recusar já, antes de receber megabytes que não caberiam na fila
+    if (queueCount == DAEMON_QUEUE_SIZE) {
+        Reply(c, LEADERBOARD_BUSY, NULL, 0);
+        CloseClient(c);
+        return;
+    }
+
+    char path[512];
+    c->ticket = nextTicket++;
+    SpoolPath(c->ticket, path, sizeof(path));
+    c->spool = open(path, O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (c->spool < 0) {
+        perror(path);
+        Reply(c, LEADERBOARD_BUSY, NULL, 0);
+        CloseClient(c);
+    }
+}
+
+static void FinishSubmission(Client *c) {
+    close(c->spool);
+    c->spool = -1;
+
+    // A fila pode ter enchido enquanto o replay chegava
+    if (queueCount == DAEMON_QUEUE_SIZE) {
+        char path[512];
+        SpoolPath(c->ticket, path, sizeof(path));
+        unlink(path);
+        Reply(c, LEADERBOARD_BUSY, NULL, 0);
+        CloseClient(c);
+        return;
+    }
+
+    Job *job = &queue[(queueHead + queueCount++) % DAEMON_QUEUE_SIZE];
+    job->ticket = c->ticket;
+    memcpy(job->name, c->req.name, LEADERBOARD_NAME_MAX);
+    job->claimedScore = c->req.claimedScore;
+    if (queueCount > queueMax) queueMax = queueCount;
+    Reply(c, LEADERBOARD_QUEUED, NULL, 0);
+    CloseClient(c);
+}
+
+static void ReadClient(Client *c) {
+    c->lastActivity = TimeNow();
+
+    if (c->headerBytes < sizeof(c->req)) {
+        ssize_t got = recv(c->fd, (char *)&c->req + c->headerBytes, sizeof(c->req) - c->headerBytes, 0);
+        if (got <= 0) {
+            if (got == 0 || (errno != EAGAIN && errno != EWOULDBLOCK)) CloseClient(c);
+            return;
+        }
+        c->headerBytes += got;
+        if (c->headerBytes == sizeof(c->req)) StartRequest(c);
+        return;
+    }
+
+    char buffer[64 * 1024];
+    size_t want = c->req.replaySize - c->payloadBytes;
+    if (want > sizeof(buffer)) want = sizeof(buffer);
+    ssize_t got = recv(c->fd, buffer, want, 0);
+    if (got <= 0) {
+        if (got == 0 || (errno != EAGAIN && errno != EWOULDBLOCK)) CloseClient(c);
+        return;
+    }
+    if (write(c->spool, buffer, got) != got) {
+        Reply(c, LEADERBOARD_BUSY, NULL, 0);
+        CloseClient(c);
+        return;
+    }
+    c->payloadBytes += got;
+    if (c->payloadBytes == c->req.replaySize) FinishSubmission(c);
+}
+
+static void AcceptClients(void) {
+    for (int i = 0; i < DAEMON_MAX_CLIENTS; i++) {
+        if (clients[i].fd >= 0) continue;
+        int fd = accept(listenFd, NULL, NULL);
+        if (fd < 0) return;
+        fcntl(fd, F_SETFL, O_NONBLOCK);
+        fcntl(fd, F_SETFD, FD_CLOEXEC);
+        memset(&clients[i], 0, sizeof(clients[i]));
+        clients[i].fd = fd;
+        clients[i].spool = -1;
+        clients[i].lastActivity = TimeNow();
+    }
+}
+
+static void PrintThroughput(const char *label, const Throughput *t, double seconds) {
+    long verified = t->accepted + t->rejected;
+    printf("leaderboardd: %s: %ld verificados (%ld recusados) em %.1f s, %.1f replays/s, %.1f Mticks/s, "
+           "%.1f ms por replay, fila máx %d\n",
+           label, verified, t->rejected, seconds, verified / seconds, t->ticks / seconds / 1e6,
+           verified ? t->verifySeconds * 1000.0 / verified : 0.0, queueMax);
+}
+
+static int OpenSocket(void) {
+    struct sockaddr_un addr = {0};
+    addr.sun_family = AF_UNIX;
+    strncpy(addr.sun_path, LEADERBOARD_SOCKET, sizeof(addr.sun_path) - 1);
+
+    // Um socket que ainda aceita conexões é de outro serviço rodando
+    int probe = socket(AF_UNIX, SOCK_STREAM, 0);
+    int taken = probe >= 0 && connect(probe, (struct sockaddr *)&addr, sizeof(addr)) == 0;
+    if (probe >= 0) close(probe);
+    if (taken) {
+        fprintf(stderr, "leaderboardd: já há um serviço em %s\n", LEADERBOARD_SOCKET);
+        return 0;
+    }
+    unlink(LEADERBOARD_SOCKET);
+
+    listenFd = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (listenFd < 0 || bind(listenFd, (struct sockaddr *)&addr, sizeof(addr)) < 0 || listen(listenFd, 128) < 0) {
+        perror(LEADERBOARD_SOCKET);
+        return 0;
+    }
+    return 1;
+}
+
+static int PrintTop(void) {
+    LeaderboardEntry top[LEADERBOARD_TOP_MAX];
+    int count = LeaderboardTop(top, LEADERBOARD_TOP_MAX);
+    for (int i = 0; i < count; i++) {
+        printf("%2d. %-*s %8d  (%u frames)\n", i + 1, LEADERBOARD_NAME_MAX, top[i].name, top[i].score, top[i].frames);
+    }
+    if (count == 0) printf("placar vazio ou serviço parado\n");
+    return 0;
+}
+
+int main(int argc, char **argv) {
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--top") == 0) return PrintTop();
+        if (i + 1 >= argc) break;
+        if (strcmp(argv[i], "--workers") == 0) workerCount = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--log") == 0) logPath = argv[++i];
+        else if (strcmp(argv[i], "--spool") == 0) spoolDir = argv[++i];
+    }
+    if (workerCount <= 0) workerCount = (int)sysconf(_SC_NPROCESSORS_ONLN);
+    if (workerCount < 1) workerCount = 1;
+    if (workerCount > DAEMON_MAX_WORKERS) workerCount = DAEMON_MAX_WORKERS;
+
+    SetTraceLogLevel(LOG_WARNING);
+    setvbuf(stdout, NULL, _IOLBF, 0);
+    mkdir(spoolDir, 0755);
+    if (!LoadLog() || !OpenSocket()) return 1;
+
+    struct sigaction sa = {0};
+    sa.sa_handler = OnSignal;
+    sigaction(SIGINT, &sa, NULL);
+    sigaction(SIGTERM, &sa, NULL);
+
+    GameInit(&initialGame);
+    for (int i = 0; i < DAEMON_MAX_CLIENTS; i++) clients[i].fd = clients[i].spool = -1;
+    printf("leaderboardd: ouvindo em %s com %d trabalhadores\n", LEADERBOARD_SOCKET, workerCount);
+
+    double startTime = TimeNow(), intervalStart = startTime;
+    while (!stopping) {
+        // listen | clientes | trabalhadores
+        struct pollfd fds[1 + DAEMON_MAX_CLIENTS + DAEMON_MAX_WORKERS];
+        Client *fdClient[1 + DAEMON_MAX_CLIENTS + DAEMON_MAX_WORKERS] = {0};
+        Worker *fdWorker[1 + DAEMON_MAX_CLIENTS + DAEMON_MAX_WORKERS] = {0};
+        int n = 0;
+        fds[n++] = (struct pollfd){ listenFd, POLLIN, 0 };
+        for (int i = 0; i < DAEMON_MAX_CLIENTS; i++) {
+            if (clients[i].fd < 0) continue;
+            fdClient[n] = &clients[i];
+            fds[n++] = (struct pollfd){ clients[i].fd, POLLIN, 0 };
+        }
+        for (int w = 0; w < workerCount; w++) {
+            if (!workers[w].pid) continue;
+            fdWorker[n] = &workers[w];
+            fds[n++] = (struct pollfd){ workers[w].pipe, POLLIN, 0 };
+        }
+
+        if (poll(fds, n, 1000) < 0 && errno != EINTR) break;
+
+        for (int i = 1; i < n; i++) {
+            if (!fds[i].revents) continue;
+            if (fdClient[i]) ReadClient(fdClient[i]);
+            else FinishWorker(fdWorker[i]);
+        }
+        if (fds[0].revents & POLLIN) AcceptClients();
+
+        double now = TimeNow();
+        for (int i = 0; i < DAEMON_MAX_CLIENTS; i++) {
+            if (clients[i].fd >= 0 && now - clients[i].lastActivity > DAEMON_CLIENT_TIMEOUT) CloseClient(&clients[i]);
+        }
+        Dispatch();
+
+        if (now - intervalStart >= DAEMON_STATS_INTERVAL) {
+            if (interval.accepted + interval.rejected > 0) PrintThroughput("últimos", &interval, now - intervalStart);
+            interval = (Throughput){0};
+            intervalStart = now;
+        }
+    }
+
+    // Para de receber, mas verifica tudo o que já foi aceito
+    for (int i = 0; i < DAEMON_MAX_CLIENTS; i++) {
+        if (clients[i].fd >= 0) CloseClient(&clients[i]);
+    }
+    int busy;
+    do {
+        Dispatch();
+        busy = 0;
+        for (int w = 0; w < workerCount; w++) {
+            if (workers[w].pid) {
+                FinishWorker(&workers[w]);
+                busy = 1;
+            }
+        }
+    } while (busy || queueCount > 0);
+    PrintThroughput("total", &total, TimeNow() - startTime);
+    close(listenFd);
+    unlink(LEADERBOARD_SOCKET);
+    close(logFd);
+    return 0;
+}
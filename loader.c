@@ -0,0 +1,131 @@
+#include "loader.h"
+#include <pthread.h>
+
+typedef enum { JOB_FREE, JOB_QUEUED, JOB_RUNNING, JOB_DONE } LoaderJobState;
+
+typedef struct {
+    LoaderFn work, done;
+    void *ctx;
+    LoaderJobState state;
+    unsigned int seq;       // Ordem de envio (entrega e execução seguem ela)
+} LoaderJob;
+
+static LoaderJob jobs[LOADER_MAX_JOBS];
+static unsigned int nextSeq = 0;     // Próximo número de envio
+static unsigned int nextDone = 0;    // Próximo job a ter o `done` executado
+static pthread_t workers[LOADER_WORKERS];
+static int workerCount = 0;
+static int stopping = 0;
+static pthread_mutex_t lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t wake = PTHREAD_COND_INITIALIZER;     // Job novo ou parada
+static pthread_cond_t finished = PTHREAD_COND_INITIALIZER; // Algum job terminou
+
+// Job na fila com menor número de envio (chamar com o lock)
+static LoaderJob *NextQueued(void) {
+    LoaderJob *best = NULL;
+    for (int i = 0; i < LOADER_MAX_JOBS; i++) {
+        if (jobs[i].state == JOB_QUEUED && (!best || jobs[i].seq < best->seq)) best = &jobs[i];
+    }
+    return best;
+}
+
+static void *LoaderWorker(void *arg) {
+    (void)arg;
+    pthread_mutex_lock(&lock);
+    for (;;) {
+        LoaderJob *job;
+        while (!(job = NextQueued()) && !stopping) pthread_cond_wait(&wake, &lock);
+        if (!job) break;
+
+        job->state = JOB_RUNNING;
+        pthread_mutex_unlock(&lock);
+        if (job->work) job->work(job->ctx);
+        pthread_mutex_lock(&lock);
+
+        job->state = JOB_DONE;
+        pthread_cond_broadcast(&finished);
+    }
+    pthread_mutex_unlock(&lock);
+    return NULL;
+}
+
+int LoaderInit(int count) {
+    if (count > LOADER_WORKERS) count = LOADER_WORKERS;
+    stopping = 0;
+    for (workerCount = 0; workerCount < count; workerCount++) {
+        if (pthread_create(&workers[workerCount], NULL, LoaderWorker, NULL) != 0) break;
+    }
+    return workerCount;
+}
+
+int LoaderSubmit(LoaderFn work, LoaderFn done, void *ctx) {
+    pthread_mutex_lock(&lock);
+    for (int i = 0; i < LOADER_MAX_JOBS; i++) {
+        if (jobs[i].state != JOB_FREE) continue;
+
+        jobs[i] = (LoaderJob){ work, done, ctx, JOB_QUEUED, nextSeq++ };
+        pthread_cond_signal(&wake);
+        pthread_mutex_unlock(&lock);
+
+        // Sem threads de trabalho: executa agora mesmo, na thread atual
+        if (workerCount == 0) {
+            if (work) work(ctx);
+            pthread_mutex_lock(&lock);
+            jobs[i].state = JOB_DONE;
+            pthread_mutex_unlock(&lock);
+        }
+        return 1;
+    }
+    pthread_mutex_unlock(&lock);
+    return 0;
+}
+
+int LoaderPoll(void) {
+    int pending = 0;
+
+    pthread_mutex_lock(&lock);
+    for (;;) {
+        // Entrega em ordem: para no primeiro job que ainda não terminou
+        LoaderJob *job = NULL;
+        for (int i = 0; i < LOADER_MAX_JOBS; i++) {
+            if (jobs[i].state != JOB_FREE && jobs[i].seq == nextDone) job = &jobs[i];
+        }
+        if (!job || job->state != JOB_DONE) break;
+
+        LoaderFn done = job->done;
+        void *ctx = job->ctx;
+        job->state = JOB_FREE;
+        nextDone++;
+
+        pthread_mutex_unlock(&lock);
+        if (done) done(ctx);
+        pthread_mutex_lock(&lock);
+    }
+    for (int i = 0; i < LOADER_MAX_JOBS; i++) {
+        if (jobs[i].state != JOB_FREE) pending++;
+    }
+    pthread_mutex_unlock(&lock);
+
+    return pending;
+}
+
+void LoaderShutdown(void) {
+    // Deixa terminar o que já foi enviado para não vazar recursos pela metade
+    pthread_mutex_lock(&lock);
+    for (;;) {
+        int busy = 0;
+        for (int i = 0; i < LOADER_MAX_JOBS; i++) {
+            if (jobs[i].state == JOB_QUEUED || jobs[i].state == JOB_RUNNING) busy = 1;
+        }
+        if (!busy || workerCount == 0) break;
+        pthread_cond_wait(&finished, &lock);
+    }
+    stopping = 1;
+    pthread_cond_broadcast(&wake);
+    pthread_mutex_unlock(&lock);
+
+    for (int i = 0; i < workerCount; i++) pthread_join(workers[i], NULL);
+    workerCount = 0;
+
+    LoaderPoll();
+}
@@ -0,0 +1,19 @@
+#ifndef LOADER_H
+#define LOADER_H
+
+// Carregamento assíncrono de recursos. Cada job tem duas partes:
+//   work - roda numa thread de trabalho (abrir arquivo, decodificar, iniciar áudio)
+//   done - roda na thread principal, dentro de LoaderPoll (publicar o resultado,
+//          subir texturas para a GPU, tocar a música)
+// Os callbacks `done` rodam na ordem em que os jobs foram enviados.
+#define LOADER_MAX_JOBS 16
+#define LOADER_WORKERS 2
+
+typedef void (*LoaderFn)(void *ctx);
+
+int LoaderInit(int workers);
+int LoaderSubmit(LoaderFn work, LoaderFn done, void *ctx);
+int LoaderPoll(void);       // Executa os `done` prontos; retorna quantos jobs faltam
+void LoaderShutdown(void);  // Espera os jobs em andamento e entrega os resultados
+
+#endif
@@ -1,44 +1,441 @@
 #include "raylib.h"
 #include "game.h"
+#include "hud.h"
+#include "input.h"
+#include "pipeline.h"
+#include "netplay.h"
+#include "loader.h"
+#include "pack.h"
+#include "quality.h"
+#include "replay.h"
+#include "leaderboard.h"
+#include "spectator.h"
+#include "ghost.h"
+#include "alloctrack.h"
+#include "telemetry.h"
+#include "bot.h"
+#include "screen.h"
 #include "utils.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define NET_DEFAULT_PORT 7777
+#define REPLAY_VIEWER_JUMP (10 * 60)    // ↑/↓ no visualizador: 10 s
+#define SPECTATE_RETRY_SECONDS 1.0
+#define SUBMIT_REPLAY_FILE "ultima-partida.hrep"   // --submit sem --record
+
+// O que a simulação precisa em cada frame do pipeline
+typedef struct {
+    Game *game;
+    Netplay *net;
+    int online;
+    int recording;
+    int bestScore;      // Maior pontuação dos frames gravados (o que o placar confere)
+} FrameContext;
+
+// Roda na thread de trabalho (ou inline com --serial)
+static void SimulateFrame(void *ctx, const GameInput *input, FramePacket *out) {
+    FrameContext *fc = ctx;
+    if (fc->online) {
+        // A partida é comandada pelas entradas dos dois lados
+        AllocPhase previous = AllocTrackEnter(ALLOC_PHASE_UPDATE);
+        NetplayAdvance(fc->net, fc->game, input);
+        AllocTrackLeave(previous);
+    } else {
+        if (fc->recording) fc->recording = ReplayRecordFrame(fc->game, input);
+        GameUpdate(fc->game, input);
+        if (fc->recording && fc->game->score > fc->bestScore) fc->bestScore = fc->game->score;
+        GhostStep(fc->game);
+    }
+    GameExtractFrame(fc->game, out);
+    GhostExtract(out);
+    HUDUpdate();
+}
+
+typedef struct {
+    NetplayConfig net;
+    int coop;
+    int serial;
+    int bot;
+    const char *recordPath;
+    const char *replayPath;
+    const char *submitName;
+    const char *ghostPath;
+    const char *allocCheckPath;
+    const char *telemetryPath;
+    int windowWidth, windowHeight;
+    int internalWidth, internalHeight;
+    ScreenScale scale;
+    int spectatorPort;          // 0 = sem transmissão
+    char spectateHost[64];      // Vazio = jogar normalmente
+    int spectatePort;
+} LaunchOptions;
+
+// Opções de linha de comando:
+//   cooperativo em rede: --coop 1|2  --port N --peer N --delay F --latency MS --jitter MS --loss PCT
+//   --serial (simulação e desenho na mesma thread) e --bot (o jogador automático joga)
+//   tela: --window LxA (janela inicial), --resolution LxA (interna), --scale integer|filtered
+//   --record ARQUIVO (grava um replay) e --replay ARQUIVO (abre o visualizador)
+//   --submit NOME (envia o replay da partida ao placar local ao sair)
+//   --ghost ARQUIVO (corre contra o coração de um replay)
+//   --spectators PORTA (transmite a partida) e --spectate HOST[:PORTA] (assiste)
+//   --telemetry ARQUIVO (grava a telemetria da partida; ver teledecode.c)
+//   --alloc-check ARQUIVO (toca o replay e falha se um frame alocar; make ALLOC_TRACK=1)
+static void ParseArgs(int argc, char **argv, LaunchOptions *opt) {
+    NetplayConfig *cfg = &opt->net;
+    cfg->playerIndex = 0;
+    cfg->localPort = cfg->remotePort = -1;
+    cfg->inputDelay = 2;
+    cfg->latencyMs = cfg->jitterMs = cfg->lossPercent = 0;
+    opt->coop = opt->serial = opt->bot = 0;
+    opt->recordPath = opt->replayPath = opt->submitName = opt->ghostPath = opt->allocCheckPath = opt->telemetryPath = NULL;
+    opt->windowWidth = opt->internalWidth = GAME_WIDTH;
+    opt->windowHeight = opt->internalHeight = GAME_HEIGHT;
+    opt->scale = SCREEN_SCALE_INTEGER;
+    opt->spectatorPort = 0;
+    opt->spectateHost[0] = '\0';
+    opt->spectatePort = SPECTATOR_DEFAULT_PORT;
+
+    for (int i = 1; i < argc; i++) {
+        const char *flag = argv[i];
+        if (strcmp(flag, "--serial") == 0) { opt->serial = 1; continue; }
+        if (strcmp(flag, "--bot") == 0) { opt->bot = 1; continue; }
+        if (i + 1 >= argc) break;
+        const char *arg = argv[++i];
+        int value = atoi(arg);
+        if (strcmp(flag, "--coop") == 0) { opt->coop = 1; cfg->playerIndex = value == 2 ? 1 : 0; }
+        else if (strcmp(flag, "--port") == 0) cfg->localPort = value;
+        else if (strcmp(flag, "--peer") == 0) cfg->remotePort = value;
+        else if (strcmp(flag, "--delay") == 0) cfg->inputDelay = value;
+        else if (strcmp(flag, "--latency") == 0) cfg->latencyMs = value;
+        else if (strcmp(flag, "--jitter") == 0) cfg->jitterMs = value;
+        else if (strcmp(flag, "--loss") == 0) cfg->lossPercent = value;
+        else if (strcmp(flag, "--record") == 0) opt->recordPath = arg;
+        else if (strcmp(flag, "--replay") == 0) opt->replayPath = arg;
+        else if (strcmp(flag, "--submit") == 0) opt->submitName = arg;
+        else if (strcmp(flag, "--ghost") == 0) opt->ghostPath = arg;
+        else if (strcmp(flag, "--alloc-check") == 0) opt->allocCheckPath = arg;
+        else if (strcmp(flag, "--telemetry") == 0) opt->telemetryPath = arg;
+        else if (strcmp(flag, "--window") == 0) sscanf(arg, "%dx%d", &opt->windowWidth, &opt->windowHeight);
+        else if (strcmp(flag, "--resolution") == 0) sscanf(arg, "%dx%d", &opt->internalWidth, &opt->internalHeight);
+        else if (strcmp(flag, "--scale") == 0) opt->scale = strcmp(arg, "filtered") == 0 ? SCREEN_SCALE_FILTERED : SCREEN_SCALE_INTEGER;
+        else if (strcmp(flag, "--spectators") == 0) opt->spectatorPort = value > 0 ? value : SPECTATOR_DEFAULT_PORT;
+        else if (strcmp(flag, "--spectate") == 0) {
+            snprintf(opt->spectateHost, sizeof(opt->spectateHost), "%s", arg);
+            char *colon = strchr(opt->spectateHost, ':');
+            if (colon) {
+                *colon = '\0';
+                opt->spectatePort = atoi(colon + 1);
+            }
+        }
+    }
+    if (opt->submitName && !opt->recordPath) opt->recordPath = SUBMIT_REPLAY_FILE;
+
+    // Portas padrão: cada jogador escuta na sua e envia para a do outro
+    if (cfg->localPort < 0) cfg->localPort = NET_DEFAULT_PORT + cfg->playerIndex;
+    if (cfg->remotePort < 0) cfg->remotePort = NET_DEFAULT_PORT + 1 - cfg->playerIndex;
+    if (cfg->inputDelay < 0) cfg->inputDelay = 0;
+}
+
+// Visualizador de replay: linha do tempo clicável, frame a frame e saltos.
+// ESPAÇO toca/pausa, ←/→ um frame, ↑/↓ 10 s, HOME/END início/fim.
+static void RunReplayViewer(Game *game) {
+    static FramePacket frame;
+    int count = ReplayFrameCount();
+    int current = 0, playing = 0;
+    double seekMs = 0.0, seekMsMax = 0.0;
+    Rectangle timeline = { 20, GAME_HEIGHT - 30, GAME_WIDTH - 40, 12 };
+
+    ReplaySeek(game, 0);
+    while (!WindowShouldClose()) {
+        int target = current;
+        if (IsKeyPressed(KEY_SPACE)) playing = !playing;
+        if (IsKeyPressed(KEY_RIGHT)) { target = current + 1; playing = 0; }
+        if (IsKeyPressed(KEY_LEFT)) { target = current - 1; playing = 0; }
+        if (IsKeyPressed(KEY_UP)) target = current + REPLAY_VIEWER_JUMP;
+        if (IsKeyPressed(KEY_DOWN)) target = current - REPLAY_VIEWER_JUMP;
+        if (IsKeyPressed(KEY_HOME)) target = 0;
+        if (IsKeyPressed(KEY_END)) target = count;
+        if (IsMouseButtonDown(MOUSE_BUTTON_LEFT) && CheckCollisionPointRec(GetMousePosition(), (Rectangle){ timeline.x, timeline.y - 8, timeline.width, timeline.height + 16 })) {
+            target = (int)((GetMousePosition().x - timeline.x) / timeline.width * count);
+        }
+        if (target < 0) target = 0;
+        if (target > count) target = count;
+
+        if (target == current + 1) {
+            // Um passo à frente não precisa de quadro-chave
+            ReplayStep(game, current);
+            HUDUpdate();
+            current = target;
+        } else if (target != current) {
+            double start = TimeNow();
+            ReplaySeek(game, target);
+            seekMs = (TimeNow() - start) * 1000.0;
+            if (seekMs > seekMsMax) seekMsMax = seekMs;
+            current = target;
+        } else if (playing && current < count) {
+            ReplayStep(game, current++);
+            HUDUpdate();
+        }
+        LoaderPoll();
+        GameUpdateAudio(game);
+        GameExtractFrame(game, &frame);
+
+        ScreenBeginFrame();
+        ClearBackground(BLACK);
+        GameDraw(&frame);
+
+        DrawRectangleRec(timeline, (Color){40, 0, 10, 220});
+        float progress = count > 0 ? (float)current / count : 0.0f;
+        DrawRectangle(timeline.x, timeline.y, timeline.width * progress, timeline.height, (Color){180, 0, 20, 255});
+        for (int k = 0; k < count; k += REPLAY_KEYFRAME_INTERVAL) {
+            DrawLine(timeline.x + timeline.width * k / count, timeline.y, timeline.x + timeline.width * k / count, timeline.y + 4, LIGHTGRAY);
+        }
+        DrawText(TextFormat("%s  frame %d/%d  (%.1f s)  busca %.2f ms", playing ? "TOCANDO" : "PAUSADO",
+                            current, count, current / 60.0f, seekMs),
+                 timeline.x, timeline.y - 20, 14, LIGHTGRAY);
+        ScreenEndFrame();
+    }
+    TraceLog(LOG_INFO, "REPLAY: busca mais lenta %.2f ms", seekMsMax);
+}
+
+// Verificação de alocações: toca o replay inteiro pelo mesmo caminho da
+// partida (tick, áudio, desenho e HUD), sem limite de FPS, e retorna quantos
+// frames depois do aquecimento alocaram memória
+static int RunAllocCheck(Game *game) {
+    static FramePacket frame;
+    int count = ReplayFrameCount();
+
+    SetTargetFPS(0);
+    ReplaySeek(game, 0);
+    AllocTrackArm(ALLOC_WARMUP_FRAMES);
+    for (int i = 0; i < count && !WindowShouldClose(); i++) {
+        ReplayStep(game, i);
+        HUDUpdate();
+        LoaderPoll();
+        GameUpdateAudio(game);
+        GameExtractFrame(game, &frame);
+
+        ScreenBeginFrame();
+        ClearBackground(BLACK);
+        GameDraw(&frame);
+        ScreenEndFrame();
+        AllocTrackFrameEnd();
+    }
+    if (count <= ALLOC_WARMUP_FRAMES) {
+        TraceLog(LOG_WARNING, "ALLOC: replay com %d frames não passa do aquecimento (%d)", count, ALLOC_WARMUP_FRAMES);
+    }
+    return AllocTrackReport();
+}
+
+// Telão: desenha o que chega da transmissão, sem simular nada
+static void RunSpectator(Game *game, const LaunchOptions *opt) {
+    static FramePacket frame;
+    double lastAttempt = -SPECTATE_RETRY_SECONDS;
 
-int main(void) {
-    InitWindow(800, 600, "HEART - Definitive Edition");
-    SetTargetFPS(60);
-    Game game;
-    GameInit(&game);
     while (!WindowShouldClose()) {
-        // Verificar tecla R para reiniciar diretamente no loop principal
-        if (IsKeyPressed(KEY_R)) {
-            // Reiniciar o jogo completamente
-            game.phase = PHASE_BATTLE;
-            game.running = 1;
-            game.player.isDead = 0;
-            game.frameCount = 0;
-            game.score = 0;
-            
-            // Reinicializar o jogador e ataques
-            PlayerInit(&game.player, (Vector2){game.battleBox.x + game.battleBox.width/2, game.battleBox.y + game.battleBox.height/2});
-            AttackManagerInit(&game.attacks, game.battleBox);
-            
-            // Configurar o primeiro nível
-            SetupLevel(&game, LEVEL_VOID);
+        // O telão costuma ser ligado antes da partida: tenta de novo até conectar
+        if (!SpectatorConnected() && TimeNow() - lastAttempt >= SPECTATE_RETRY_SECONDS) {
+            lastAttempt = TimeNow();
+            SpectatorConnect(opt->spectateHost, opt->spectatePort);
+        }
+        LoaderPoll();
+        GameUpdateAudio(game);
+        int ready = SpectatorConnected() && SpectatorReceive(&frame);
+
+        ScreenBeginFrame();
+        ClearBackground(BLACK);
+        if (ready) GameDraw(&frame);
+        if (!SpectatorConnected()) {
+            DrawText(TextFormat("Sem transmissão em %s:%d", opt->spectateHost, opt->spectatePort), 20, 20, 20, LIGHTGRAY);
+        } else if (!ready) {
+            DrawText("Aguardando a partida...", 20, 20, 20, LIGHTGRAY);
         }
+        ScreenEndFrame();
+    }
+    SpectatorDisconnect();
+}
+
+// Partida normal: simulação no pipeline, desenho nesta thread
+static void RunGame(Game *game, Netplay *net, int online, const LaunchOptions *opt, double startTime) {
+    int firstFrame = 1, interactive = 0;
+    int showOverlay = 0;
+    NetplayStats netStats = {0};
+    SpectatorStats spectatorStats = {0};
+    GhostStats ghostStats = {0};
+    static Bot bot;
+    int botActive = opt->bot && !online;
+    int broadcasting = opt->spectatorPort > 0 && SpectatorStart(opt->spectatorPort);
+    long frames = 0;
+    double drawSeconds = 0.0, frameSeconds = 0.0;
+
+    FrameContext frameCtx = { game, net, online, 0, 0 };
+    if (opt->recordPath) {
+        // Replays guardam só entradas locais: a rede tem rollback
+        if (online) TraceLog(LOG_WARNING, "REPLAY: gravação não disponível no cooperativo em rede");
+        else frameCtx.recording = ReplayRecordStart(opt->recordPath);
+    }
+    if (opt->ghostPath) {
+        if (online) TraceLog(LOG_WARNING, "GHOST: corrida contra replay não disponível no cooperativo em rede");
+        else GhostStart(opt->ghostPath);
+    }
+    if (opt->bot) {
+        // O bot lê o Game inteiro, e no cooperativo em rede o outro lado tem a cópia dele
+        if (online) TraceLog(LOG_WARNING, "BOT: jogador automático não disponível no cooperativo em rede");
+        else BotInit(&bot);
+    }
+    if (opt->telemetryPath) TelemetryStart(opt->telemetryPath);
+    PipelineStart(SimulateFrame, &frameCtx, game, !opt->serial);
+    AllocTrackArm(ALLOC_WARMUP_FRAMES);
+
+    while (!WindowShouldClose()) {
+        if (IsKeyPressed(KEY_F3)) showOverlay = !showOverlay;   // Overlay de depuração
+        
+        // Daqui até o Submit a simulação está parada: o Game é só nosso
+        PipelineSync();
+        double frameStart = TimeNow();
         
-        GameUpdate(&game);
-        BeginDrawing();
+        // Entregar os recursos que terminaram de carregar
+        if (LoaderPoll() == 0 && !interactive) {
+            interactive = 1;
+            TraceLog(LOG_INFO, "STARTUP: interativo com todos os recursos em %.1f ms", (TimeNow() - startTime) * 1000.0);
+        }
+        GameUpdateAudio(game);
+        if (online) NetplayGetStats(net, &netStats);
+        if (showOverlay && GhostActive()) GhostGetStats(&ghostStats);
+        
+        // Entrada lida o mais tarde possível, logo antes do tick começar
+        GameInput input = GameReadInput();
+        if (botActive) input = BotReadInput(&bot, game);
+        PipelineSubmit(&input);
+        const FramePacket *frame = PipelineFront();
+        if (broadcasting) {
+            SpectatorPublish(frame);    // Só copia; a codificação é na thread da transmissão
+            if (showOverlay) SpectatorGetStats(&spectatorStats);
+        }
+        
+        double drawStart = TimeNow();
+        ScreenBeginFrame();
         ClearBackground(BLACK);
-        GameDraw(&game);
-        EndDrawing();
+        GameDraw(frame);
+        if (online) NetplayDrawStats(&netStats);
+        if (showOverlay) QualityDrawOverlay();
+        if (showOverlay && broadcasting) SpectatorDrawStats(&spectatorStats);
+        if (showOverlay && GhostActive()) GhostDrawStats(&ghostStats);
+        
+        // Tempo de CPU do frame (sem a espera do vsync) ajusta o nível de efeitos
+        double drawEnd = TimeNow();
+        QualityUpdate((float)((drawEnd - frameStart) * 1000.0), GetFrameTime() * 1000.0f);
+        ScreenEndFrame();
+        drawSeconds += drawEnd - drawStart;
+        frameSeconds += TimeNow() - frameStart;
+        frames++;
+        TelemetryEmit(TELEMETRY_FRAME, QualityCurrent(), 0, 0, (int)((drawEnd - drawStart) * 1e6), (int)((drawEnd - frameStart) * 1e6));
+        AllocTrackFrameEnd();
+        
+        if (firstFrame) {
+            firstFrame = 0;
+            TraceLog(LOG_INFO, "STARTUP: primeiro frame em %.1f ms", (TimeNow() - startTime) * 1000.0);
+        }
     }
+    PipelineStop();
+    TelemetryStop();
+    GhostStop();
+    SpectatorStop();
+    ReplayRecordStop();
+    
+    // O serviço só grava o replay e responde; a verificação roda lá depois
+    if (opt->submitName && !online) {
+        unsigned int ticket;
+        if (LeaderboardSubmit(opt->recordPath, opt->submitName, frameCtx.bestScore, &ticket)) {
+            TraceLog(LOG_INFO, "PLACAR: %d pontos enviados (envio #%u)", frameCtx.bestScore, ticket);
+        } else {
+            TraceLog(LOG_WARNING, "PLACAR: serviço em %s indisponível", LEADERBOARD_SOCKET);
+        }
+    }
+    if (frames > 0) {
+        TraceLog(LOG_INFO, "PIPELINE: %ld frames, simulação %.3f ms, desenho %.3f ms, frame %.3f ms (%s)",
+                 frames, PipelineSimMs(), drawSeconds * 1000.0 / frames, frameSeconds * 1000.0 / frames,
+                 opt->serial ? "serial" : "thread");
+    }
+    if (botActive) {
+        TraceLog(LOG_INFO, "BOT: %ld decisões, média %.1f us, pior %.1f us (%.1f us de CPU)", bot.decisions, BotAvgUs(&bot), bot.maxUs, bot.maxCpuUs);
+    }
+    if (ALLOC_TRACK_ENABLED) AllocTrackReport();
+}
+
+int main(int argc, char **argv) {
+    double startTime = TimeNow();
+    static Netplay net;
+    LaunchOptions opt;
+    ParseArgs(argc, argv, &opt);
+    int online = opt.coop && !opt.replayPath && !opt.allocCheckPath && !opt.spectateHost[0];
+
+    // Janela redimensionável: a imagem interna é escalada para o tamanho dela
+    SetConfigFlags(FLAG_WINDOW_RESIZABLE);
+    InitWindow(opt.windowWidth, opt.windowHeight, "HEART - Definitive Edition");
+    SetWindowMinSize(SCREEN_MIN_WIDTH, SCREEN_MIN_HEIGHT);
+    ScreenInit(opt.internalWidth, opt.internalHeight, opt.scale);
+    SetTargetFPS(60);
+    PackOpen();
+    if (InputStart()) TraceLog(LOG_INFO, "INPUT: teclado cru via evdev");
+    else TraceLog(LOG_INFO, "INPUT: sem acesso a /dev/input, usando a raylib");
+    LoaderInit(LOADER_WORKERS);
+    Game game;
+    GameInit(&game);
+    GameLoadAudio(&game);
+
+    // Cooperativo: os dois processos começam juntos no primeiro nível
+    if (online) {
+        online = NetplayStart(&net, &opt.net);
+        if (online) {
+            game.coop = 1;
+            GameRestart(&game, LEVEL_VOID);
+        }
+    }
+
+    int status = 0;
+    if (opt.allocCheckPath) {
+        if (!ALLOC_TRACK_ENABLED) {
+            TraceLog(LOG_WARNING, "ALLOC: --alloc-check precisa de make ALLOC_TRACK=1");
+            status = 1;
+        } else if (ReplayOpen(opt.allocCheckPath)) {
+            status = RunAllocCheck(&game) > 0;
+        } else {
+            status = 1;
+        }
+        ReplayClose();
+    } else if (opt.replayPath) {
+        if (ReplayOpen(opt.replayPath)) RunReplayViewer(&game);
+        ReplayClose();
+    } else if (opt.spectateHost[0]) {
+        RunSpectator(&game, &opt);
+    } else {
+        RunGame(&game, &net, online, &opt, startTime);
+    }
+    
+    if (InputActive()) {
+        long events, lost;
+        double waitMs;
+        InputGetStats(&events, &lost, &waitMs);
+        TraceLog(LOG_INFO, "INPUT: %ld eventos (%ld perdidos), espera média até o tick %.2f ms", events, lost, waitMs);
+        InputStop();
+    }
+    if (online) NetplayStop(&net);
+    LoaderShutdown();
+
     // Liberar recursos de áudio corretamente
-    if (game.musicPlaying) {
+    if (game.musicLoaded) {
         StopMusicStream(game.bgMusic);
         UnloadMusicStream(game.bgMusic);
     }
     CloseAudioDevice();
+    PackClose();
     
     // Desligar
+    EntityUnloadResources();
+    ScreenShutdown();
     CloseWindow();
-    return 0;
+    return status;
 }
@@ -0,0 +1,250 @@
+#define _POSIX_C_SOURCE 200809L
+#include "netplay.h"
+#include "player.h"
+#include "utils.h"
+#include "telemetry.h"
+#include "raylib.h"
+#include <string.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+
+#define NET_MAGIC 0x48525431u   // "HRT1"
+
+// Os dois bits livres do byte de entrada levam o comando de menu do frame,
+// para que ENTER e R tenham efeito no mesmo tick nos dois processos.
+// ENTER (confirmar) também conta como começar; R tem prioridade.
+#define NET_CMD_SHIFT 6
+#define NET_BUTTONS_MASK ((1 << NET_CMD_SHIFT) - 1)
+enum { NET_CMD_NONE, NET_CMD_START, NET_CMD_CONFIRM, NET_CMD_RESTART };
+
+static unsigned char NetPackInput(const GameInput *in) {
+    int cmd = in->restart ? NET_CMD_RESTART : in->confirm ? NET_CMD_CONFIRM : in->start ? NET_CMD_START : NET_CMD_NONE;
+    return (unsigned char)((in->player.buttons & NET_BUTTONS_MASK) | cmd << NET_CMD_SHIFT);
+}
+
+// Junta os comandos dos dois lados (qualquer um dos jogadores pode reiniciar)
+static void NetUnpackCommand(unsigned char input, GameInput *commands) {
+    int cmd = input >> NET_CMD_SHIFT;
+    commands->restart |= cmd == NET_CMD_RESTART;
+    commands->confirm |= cmd == NET_CMD_CONFIRM;
+    commands->start |= cmd == NET_CMD_CONFIRM || cmd == NET_CMD_START;
+}
+
+// Cabeçalho fixo do pacote, seguido de `count` entradas a partir de `start`
+typedef struct {
+    unsigned int magic;
+    int ack;        // Último frame do destinatário que quem envia já recebeu
+    int start;
+    int count;
+} NetHeader;
+
+static struct sockaddr_in LoopbackAddress(int port) {
+    struct sockaddr_in addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons((unsigned short)port);
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    return addr;
+}
+
+int NetplayStart(Netplay *n, const NetplayConfig *config) {
+    memset(n, 0, sizeof(*n));
+    n->config = *config;
+    n->remoteConfirmed = -1;
+    n->remoteAck = -1;
+    n->rollbackFrom = -1;
+    n->lossRng = RAND_DEFAULT_SEED ^ (unsigned int)(config->playerIndex + 1);
+
+    n->socket = socket(AF_INET, SOCK_DGRAM, 0);
+    if (n->socket < 0) return 0;
+
+    struct sockaddr_in local = LoopbackAddress(config->localPort);
+    if (bind(n->socket, (struct sockaddr *)&local, sizeof(local)) < 0) {
+        TraceLog(LOG_WARNING, "NETPLAY: porta %d indisponível", config->localPort);
+        close(n->socket);
+        n->socket = -1;
+        return 0;
+    }
+    fcntl(n->socket, F_SETFL, fcntl(n->socket, F_GETFL, 0) | O_NONBLOCK);
+
+    TraceLog(LOG_INFO, "NETPLAY: jogador %d em %d -> %d (atraso %d, latência %d±%d ms, perda %d%%)",
+             config->playerIndex + 1, config->localPort, config->remotePort, config->inputDelay,
+             config->latencyMs, config->jitterMs, config->lossPercent);
+    return 1;
+}
+
+// Envia (ou retém, simulando latência e perda) as entradas locais ainda não
+// confirmadas. Reenviar a janela toda cobre pacotes perdidos sem retransmissão.
+static void NetplaySendInputs(Netplay *n) {
+    int last = n->frame + n->config.inputDelay - 1;
+    int first = n->remoteAck + 1;
+    if (last - first + 1 > NET_MAX_PACKET_INPUTS) last = first + NET_MAX_PACKET_INPUTS - 1;
+
+    NetDelayedPacket packet;
+    NetHeader header = { NET_MAGIC, n->remoteConfirmed, first, last - first + 1 };
+    if (header.count < 0) header.count = 0;
+    memcpy(packet.data, &header, sizeof(header));
+    for (int i = 0; i < header.count; i++) {
+        packet.data[sizeof(header) + i] = n->localInput[(first + i) % NET_INPUT_RING];
+    }
+    packet.size = (int)sizeof(header) + header.count;
+
+    if ((int)(RandNext(&n->lossRng) % 100) < n->config.lossPercent) return;
+    if (n->outCount == NET_MAX_DELAYED) return;   // Fila cheia conta como perda
+
+    int jitter = n->config.jitterMs > 0 ? (int)(RandNext(&n->lossRng) % (unsigned int)(n->config.jitterMs + 1)) : 0;
+    packet.releaseTime = GetTime() + (n->config.latencyMs + jitter) / 1000.0;
+    n->outQueue[n->outCount++] = packet;
+}
+
+// Libera os pacotes cuja latência simulada venceu
+static void NetplayFlush(Netplay *n) {
+    struct sockaddr_in remote = LoopbackAddress(n->config.remotePort);
+    double now = GetTime();
+    int kept = 0;
+
+    for (int i = 0; i < n->outCount; i++) {
+        NetDelayedPacket *p = &n->outQueue[i];
+        if (p->releaseTime <= now) {
+            sendto(n->socket, p->data, p->size, 0, (struct sockaddr *)&remote, sizeof(remote));
+        } else {
+            n->outQueue[kept++] = *p;
+        }
+    }
+    n->outCount = kept;
+}
+
+// Lê as entradas do parceiro e marca o primeiro frame previsto errado
+static void NetplayReceive(Netplay *n) {
+    unsigned char buffer[sizeof(NetHeader) + NET_MAX_PACKET_INPUTS];
+    ssize_t size;
+
+    while ((size = recv(n->socket, buffer, sizeof(buffer), 0)) >= (ssize_t)sizeof(NetHeader)) {
+        NetHeader header;
+        memcpy(&header, buffer, sizeof(header));
+        if (header.magic != NET_MAGIC || header.count < 0 ||
+            (ssize_t)sizeof(header) + header.count > size) continue;
+
+        if (header.ack > n->remoteAck) n->remoteAck = header.ack;
+
+        // Só aceita entradas contíguas; lacunas são cobertas por reenvios
+        for (int i = 0; i < header.count; i++) {
+            int f = header.start + i;
+            if (f <= n->remoteConfirmed) continue;
+            if (f != n->remoteConfirmed + 1) break;
+            if (f >= n->frame + NET_INPUT_RING - NET_MAX_ROLLBACK - 1) break;
+
+            unsigned char input = buffer[sizeof(header) + i];
+            n->remoteInput[f % NET_INPUT_RING] = input;
+            n->remoteConfirmed = f;
+
+            if (f < n->frame && n->predicted[f % NET_INPUT_RING] != input &&
+                (n->rollbackFrom < 0 || f < n->rollbackFrom)) {
+                n->rollbackFrom = f;
+            }
+        }
+    }
+}
+
+// Salva o estado e simula o tick f com a entrada local e a remota (real ou
+// prevista). A previsão repete os botões mas nunca um comando de menu.
+static void NetplayTick(Netplay *n, Game *g, int f) {
+    unsigned char local = n->localInput[f % NET_INPUT_RING];
+    unsigned char remote = 0;
+    if (f <= n->remoteConfirmed) remote = n->remoteInput[f % NET_INPUT_RING];
+    else if (n->remoteConfirmed >= 0) remote = n->remoteInput[n->remoteConfirmed % NET_INPUT_RING] & NET_BUTTONS_MASK;
+    n->predicted[f % NET_INPUT_RING] = remote;
+
+    PlayerInput inputs[2];
+    inputs[n->config.playerIndex].buttons = local & NET_BUTTONS_MASK;
+    inputs[1 - n->config.playerIndex].buttons = remote & NET_BUTTONS_MASK;
+    GameInput commands = { .practiceLevel = -1 };
+    NetUnpackCommand(local, &commands);
+    NetUnpackCommand(remote, &commands);
+
+    GameSnapshotCapture(g, &n->states[f % NET_STATE_RING]);
+    GameUpdateCoop(g, &commands, inputs);
+}
+
+// Um frame de jogo: recebe, corrige previsões erradas e avança um tick.
+// Retorna 0 se ficou parado esperando o parceiro.
+int NetplayAdvance(Netplay *n, Game *g, const GameInput *local) {
+    NetplayFlush(n);
+    NetplayReceive(n);
+
+    n->resimFrames = 0;
+    n->resimMs = 0.0;
+    if (n->rollbackFrom >= 0) {
+        double start = GetTime();
+
+        // Os ticks refeitos já foram contados na telemetria da primeira vez.
+        // O HUD fica mudo e é refeito à parte: volta à mensagem de antes do
+        // primeiro frame errado e aplica, frame a frame, o que a simulação
+        // corrigida pediu e a contagem que HUDUpdate faria
+        GameSnapshotRestore(g, &n->states[n->rollbackFrom % NET_STATE_RING]);
+        HUDState hud = n->hud[n->rollbackFrom % NET_STATE_RING];
+        TelemetryMute(1);
+        HUDMute(1);
+        for (int f = n->rollbackFrom; f < n->frame; f++) {
+            n->hud[f % NET_STATE_RING] = hud;
+            NetplayTick(n, g, f);
+            HUDTakeMuted(&hud);
+            if (hud.frames > 0) hud.frames--;
+            n->resimFrames++;
+        }
+        HUDMute(0);
+        TelemetryMute(0);
+        HUDSetState(&hud);
+
+        n->resimMs = (GetTime() - start) * 1000.0;
+        if (n->resimMs > n->resimMsMax) n->resimMsMax = n->resimMs;
+        n->resimFramesTotal += n->resimFrames;
+        n->rollbacks++;
+        n->rollbackFrom = -1;
+    }
+
+    // Muito à frente do parceiro: espera em vez de prever mais
+    if (n->frame - n->remoteConfirmed > NET_MAX_ROLLBACK) {
+        n->stalls++;
+        NetplaySendInputs(n);
+        return 0;
+    }
+
+    n->localInput[(n->frame + n->config.inputDelay) % NET_INPUT_RING] = NetPackInput(local);
+    HUDGetState(&n->hud[n->frame % NET_STATE_RING]);
+    NetplayTick(n, g, n->frame);
+    n->frame++;
+
+    NetplaySendInputs(n);
+    return 1;
+}
+
+void NetplayGetStats(const Netplay *n, NetplayStats *out) {
+    out->playerIndex = n->config.playerIndex;
+    out->frame = n->frame;
+    out->remoteConfirmed = n->remoteConfirmed;
+    out->resimFrames = n->resimFrames;
+    out->stalls = n->stalls;
+    out->resimMs = n->resimMs;
+    out->resimMsMax = n->resimMsMax;
+}
+
+void NetplayDrawStats(const NetplayStats *s) {
+    DrawText(TextFormat("NET P%d  tick %d  confirmado %d", s->playerIndex + 1, s->frame, s->remoteConfirmed),
+             10, GAME_HEIGHT - 44, 14, LIGHTGRAY);
+    DrawText(TextFormat("rollback %d ticks %.2f ms (máx %.2f)  paradas %d",
+                        s->resimFrames, s->resimMs, s->resimMsMax, s->stalls),
+             10, GAME_HEIGHT - 24, 14, LIGHTGRAY);
+}
+
+void NetplayStop(Netplay *n) {
+    if (n->socket < 0) return;
+    TraceLog(LOG_INFO, "NETPLAY: %d ticks, %d rollbacks, %ld ticks ressimulados (%.2f por rollback), pior %.2f ms, %d paradas",
+             n->frame, n->rollbacks, n->resimFramesTotal,
+             n->rollbacks ? (double)n->resimFramesTotal / n->rollbacks : 0.0, n->resimMsMax, n->stalls);
+    close(n->socket);
+    n->socket = -1;
+}
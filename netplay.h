@@ -0,0 +1,73 @@
+#ifndef NETPLAY_H
+#define NETPLAY_H
+#include "game.h"
+#include "hud.h"
+
+// Cooperativo em rede com rollback (estilo GGPO): cada processo controla um
+// coração, aplica a entrada local com atraso fixo e prevê a do parceiro
+// repetindo a última confirmada. Quando a entrada real chega e difere da
+// prevista, o estado volta ao snapshot daquele frame e é ressimulado.
+#define NET_MAX_ROLLBACK 8                      // Frames que podem rodar sem confirmação
+#define NET_STATE_RING (NET_MAX_ROLLBACK + 2)   // Snapshots guardados
+#define NET_INPUT_RING 64                       // Entradas guardadas (por lado)
+#define NET_MAX_PACKET_INPUTS 32                // Entradas reenviadas por pacote
+#define NET_MAX_DELAYED 256                     // Pacotes retidos pela latência simulada
+
+typedef struct {
+    int playerIndex;    // 0 = coração vermelho, 1 = parceiro
+    int localPort;      // Porta UDP local (127.0.0.1)
+    int remotePort;     // Porta do outro processo
+    int inputDelay;     // Atraso de entrada em frames (igual nos dois lados)
+    int latencyMs;      // Latência simulada de ida
+    int jitterMs;       // Variação aleatória somada à latência
+    int lossPercent;    // Perda simulada de pacotes (0-100)
+} NetplayConfig;
+
+typedef struct {
+    double releaseTime;
+    int size;
+    unsigned char data[16 + NET_MAX_PACKET_INPUTS];
+} NetDelayedPacket;
+
+typedef struct {
+    NetplayConfig config;
+    int socket;
+
+    int frame;              // Próximo tick a simular
+    int remoteConfirmed;    // Último frame com entrada remota recebida (-1 = nenhum)
+    int remoteAck;          // Último frame nosso que o outro lado confirmou
+    int rollbackFrom;       // Primeiro frame com previsão errada (-1 = nenhum)
+    unsigned char localInput[NET_INPUT_RING];
+    unsigned char remoteInput[NET_INPUT_RING];
+    unsigned char predicted[NET_INPUT_RING];   // Entrada remota usada em cada tick
+    GameSnapshot states[NET_STATE_RING];       // Estado antes de cada tick
+    HUDState hud[NET_STATE_RING];              // Mensagem na tela antes de cada tick
+
+    NetDelayedPacket outQueue[NET_MAX_DELAYED];
+    int outCount;
+    unsigned int lossRng;
+
+    // Custo da ressimulação
+    int resimFrames;        // Ticks ressimulados no último frame
+    double resimMs;         // Tempo gasto nisso
+    double resimMsMax;
+    long resimFramesTotal;
+    int rollbacks;
+    int stalls;             // Frames parados esperando o parceiro
+} Netplay;
+
+// Cópia das estatísticas para o desenho (que pode rodar em outra thread)
+typedef struct {
+    int playerIndex;
+    int frame, remoteConfirmed;
+    int resimFrames, stalls;
+    double resimMs, resimMsMax;
+} NetplayStats;
+
+int NetplayStart(Netplay *n, const NetplayConfig *config);
+int NetplayAdvance(Netplay *n, Game *g, const GameInput *local);
+void NetplayGetStats(const Netplay *n, NetplayStats *out);
+void NetplayDrawStats(const NetplayStats *s);
+void NetplayStop(Netplay *n);
+
+#endif
@@ -0,0 +1,103 @@
+#define _POSIX_C_SOURCE 200809L
+#include "pack.h"
+#include <stdio.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+// Pacote aberto (somente leitura depois de PackOpen, então pode ser
+// consultado pelas threads do carregador)
+static const unsigned char *packData = NULL;
+static size_t packSize = 0;
+static const PackEntry *packEntries = NULL;
+static int packCount = 0;
+static char appDir[512] = "";
+
+int PackOpen(void) {
+    // Tudo é relativo ao executável, não ao diretório de trabalho
+    snprintf(appDir, sizeof(appDir), "%s", GetApplicationDirectory());
+
+    char path[sizeof(appDir) + sizeof(PACK_FILE)];
+    snprintf(path, sizeof(path), "%s%s", appDir, PACK_FILE);
+
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) return 0;
+
+    struct stat st;
+    if (fstat(fd, &st) < 0 || (size_t)st.st_size < sizeof(PackHeader)) {
+        close(fd);
+        return 0;
+    }
+
+    void *map = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);   // O mapeamento continua válido sem o descritor
+    if (map == MAP_FAILED) return 0;
+
+    const PackHeader *header = map;
+    size_t indexEnd = sizeof(PackHeader) + (size_t)header->count * sizeof(PackEntry);
+    if (memcmp(header->magic, PACK_MAGIC, 4) != 0 || header->version != PACK_VERSION ||
+        indexEnd > (size_t)st.st_size) {
+        TraceLog(LOG_WARNING, "PACK: %s inválido", path);
+        munmap(map, st.st_size);
+        return 0;
+    }
+
+    packData = map;
+    packSize = st.st_size;
+    packEntries = (const PackEntry *)(packData + sizeof(PackHeader));
+    packCount = header->count;
+    TraceLog(LOG_INFO, "PACK: %s com %d recursos (%zu bytes)", path, packCount, packSize);
+    return 1;
+}
+
+// Busca binária no índice (ordenado pelo empacotador)
+const unsigned char *PackFind(const char *name, int *size) {
+    int lo = 0, hi = packCount - 1;
+    while (lo <= hi) {
+        int mid = (lo + hi) / 2;
+        int cmp = strncmp(name, packEntries[mid].name, PACK_NAME_MAX);
+        if (cmp == 0) {
+            const PackEntry *e = &packEntries[mid];
+            if ((size_t)e->offset + e->size > packSize) return NULL;
+            *size = (int)e->size;
+            return packData + e->offset;
+        }
+        if (cmp < 0) hi = mid - 1;
+        else lo = mid + 1;
+    }
+    return NULL;
+}
+
+// Caminho do arquivo solto em resources/, ao lado do executável
+static const char *LoosePath(const char *name, char *buffer, int size) {
+    snprintf(buffer, size, "%sresources/%s", appDir, name);
+    return buffer;
+}
+
+Music PackLoadMusic(const char *name) {
+    int size = 0;
+    const unsigned char *data = PackFind(name, &size);
+    if (data) return LoadMusicStreamFromMemory(GetFileExtension(name), data, size);
+
+    char path[1024];
+    return LoadMusicStream(LoosePath(name, path, sizeof(path)));
+}
+
+Wave PackLoadWave(const char *name) {
+    int size = 0;
+    const unsigned char *data = PackFind(name, &size);
+    if (data) return LoadWaveFromMemory(GetFileExtension(name), data, size);
+
+    char path[1024];
+    return LoadWave(LoosePath(name, path, sizeof(path)));
+}
+
+void PackClose(void) {
+    if (packData) munmap((void *)packData, packSize);
+    packData = NULL;
+    packSize = 0;
+    packEntries = NULL;
+    packCount = 0;
+}
@@ -0,0 +1,36 @@
+#ifndef PACK_H
+#define PACK_H
+#include "raylib.h"
+
+// Pacote de recursos: um único arquivo ao lado do executável, gerado por
+// `make pack` a partir de resources/. O jogo mapeia o arquivo com mmap uma
+// vez e entrega à raylib ponteiros direto para o mapeamento, sem cópia.
+//
+// Formato (inteiros na ordem de bytes da máquina que gerou):
+//   PackHeader | PackEntry[count] ordenado por nome | dados alinhados a PACK_ALIGN
+#define PACK_FILE "heart.pak"
+#define PACK_MAGIC "HPAK"
+#define PACK_VERSION 1
+#define PACK_ALIGN 64
+#define PACK_NAME_MAX 120
+
+typedef struct {
+    char magic[4];
+    unsigned int version;
+    unsigned int count;
+    unsigned int reserved;
+} PackHeader;
+
+typedef struct {
+    char name[PACK_NAME_MAX];   // Caminho relativo a resources/
+    unsigned int offset;        // Início dos dados, a partir do começo do arquivo
+    unsigned int size;
+} PackEntry;
+
+int PackOpen(void);     // Abre PACK_FILE ao lado do executável (0 se não houver)
+const unsigned char *PackFind(const char *name, int *size);
+Music PackLoadMusic(const char *name);  // Do pacote, ou de resources/ se faltar
+Wave PackLoadWave(const char *name);
+void PackClose(void);
+
+#endif
@@ -0,0 +1,100 @@
+// Empacotador de recursos: junta os arquivos de um diretório em um PACK_FILE
+// (ver pack.h). Uso: ./packer heart.pak resources
+#define _POSIX_C_SOURCE 200809L
+#include "pack.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <dirent.h>
+#include <sys/stat.h>
+
+#define PACKER_MAX_FILES 256
+
+static int CompareEntries(const void *a, const void *b) {
+    return strncmp(((const PackEntry *)a)->name, ((const PackEntry *)b)->name, PACK_NAME_MAX);
+}
+
+// Só empacota mídia: textos de apoio (README, requirements) ficam de fora
+static int ShouldPack(const char *name) {
+    const char *dot = strrchr(name, '.');
+    return name[0] != '.' && !(dot && strcmp(dot, ".txt") == 0);
+}
+
+int main(int argc, char **argv) {
+    if (argc != 3) {
+        fprintf(stderr, "uso: %s <saida.pak> <diretorio>\n", argv[0]);
+        return 1;
+    }
+
+    static PackEntry entries[PACKER_MAX_FILES];
+    int count = 0;
+
+    DIR *dir = opendir(argv[2]);
+    if (!dir) {
+        perror(argv[2]);
+        return 1;
+    }
+    struct dirent *de;
+    while ((de = readdir(dir)) != NULL) {
+        if (!ShouldPack(de->d_name)) continue;
+        if (strlen(de->d_name) >= PACK_NAME_MAX || count == PACKER_MAX_FILES) {
+            fprintf(stderr, "ignorado: %s\n", de->d_name);
+            continue;
+        }
+        memset(&entries[count], 0, sizeof(PackEntry));
+        strcpy(entries[count].name, de->d_name);
+        count++;
+    }
+    closedir(dir);
+
+    // Índice ordenado para a busca binária em PackFind
+    qsort(entries, count, sizeof(PackEntry), CompareEntries);
+
+    // Posições dos dados, cada arquivo alinhado a PACK_ALIGN
+    char path[4096];
+    unsigned long offset = sizeof(PackHeader) + (unsigned long)count * sizeof(PackEntry);
+    for (int i = 0; i < count; i++) {
+        struct stat st;
+        snprintf(path, sizeof(path), "%s/%s", argv[2], entries[i].name);
+        if (stat(path, &st) < 0) {
+            perror(path);
+            return 1;
+        }
+        offset = (offset + PACK_ALIGN - 1) / PACK_ALIGN * PACK_ALIGN;
+        entries[i].offset = (unsigned int)offset;
+        entries[i].size = (unsigned int)st.st_size;
+        offset += st.st_size;
+    }
+
+    FILE *out = fopen(argv[1], "wb");
+    if (!out) {
+        perror(argv[1]);
+        return 1;
+    }
+    PackHeader header = { {'H', 'P', 'A', 'K'}, PACK_VERSION, (unsigned int)count, 0 };
+    fwrite(&header, sizeof(header), 1, out);
+    fwrite(entries, sizeof(PackEntry), count, out);
+
+    static unsigned char buffer[1 << 16];
+    for (int i = 0; i < count; i++) {
+        // Preencher com zeros até o alinhamento
+        while ((unsigned long)ftell(out) < entries[i].offset) fputc(0, out);
+
+        snprintf(path, sizeof(path), "%s/%s", argv[2], entries[i].name);
+        FILE *in = fopen(path, "rb");
+        if (!in) {
+            perror(path);
+            fclose(out);
+            return 1;
+        }
+        size_t n;
+        while ((n = fread(buffer, 1, sizeof(buffer), in)) > 0) fwrite(buffer, 1, n, out);
+        fclose(in);
+
+        printf("%10u  %s\n", entries[i].size, entries[i].name);
+    }
+
+    printf("%d arquivos, %ld bytes -> %s\n", count, ftell(out), argv[1]);
+    fclose(out);
+    return 0;
+}
@@ -0,0 +1,128 @@
+#include "pattern.h"
+
+// Cache global: os modelos só dependem do padrão, não da partida
+static BulletPattern patternCache[PATTERN_COUNT];
+
+// Entrada temporária usada durante a construção (antes de agrupar por tipo)
+typedef struct {
+    SimVec2 offset, dir, wave;
+    AttackType type;
+} PatternEntry;
+
+// Agrupa as entradas por tipo (ordenação por contagem) e grava no modelo
+static void PatternStore(BulletPattern *bp, const PatternEntry *entries, int count, SimVec2 waveAmplitude) {
+    int counts[ATK_COUNT] = {0};
+    for (int i = 0; i < count; i++) counts[entries[i].type]++;
+    
+    bp->typeStart[0] = 0;
+    for (int t = 0; t < ATK_COUNT; t++) bp->typeStart[t + 1] = bp->typeStart[t] + counts[t];
+    
+    int next[ATK_COUNT];
+    for (int t = 0; t < ATK_COUNT; t++) next[t] = bp->typeStart[t];
+    for (int i = 0; i < count; i++) {
+        int slot = next[entries[i].type]++;
+        bp->offset[slot] = entries[i].offset;
+        bp->dir[slot] = entries[i].dir;
+        bp->wave[slot] = entries[i].wave;
+    }
+    
+    bp->count = count;
+    bp->waveAmplitude = waveAmplitude;
+    bp->built = 1;
+}
+
+// Espiral: direções unitárias igualmente espaçadas saindo da origem
+static void BuildSpiral(BulletPattern *bp, int bullets, AttackType evenType, AttackType oddType) {
+    PatternEntry entries[MAX_PATTERN_BULLETS];
+    for (int i = 0; i < bullets; i++) {
+        sim_t angle = i * SimDiv(SIM(2 * PI), SimFromInt(bullets));
+        entries[i] = (PatternEntry){ {0, 0}, {SimCos(angle), SimSin(angle)}, {0, 0}, i % 2 == 0 ? evenType : oddType };
+    }
+    PatternStore(bp, entries, bullets, (SimVec2){0, 0});
+}
+
+static void BuildPattern(PatternId id) {
+    BulletPattern *bp = &patternCache[id];
+    if (bp->built) return;
+    
+    PatternEntry entries[MAX_PATTERN_BULLETS];
+    switch (id) {
+        case PATTERN_MEMORY_ZIGZAG:
+            // Deslocamento e desvio em seno fixos por projétil
+            for (int i = 0; i < 8; i++) {
+                entries[i] = (PatternEntry){ {SimSin(i * SIM(0.5)) * 100, 0}, {SimSin(i * SIM(0.8)), SIM(1)}, {0, 0}, ATK_MAGENTA };
+            }
+            PatternStore(bp, entries, 8, (SimVec2){0, 0});
+            break;
+            
+        case PATTERN_REGRET_SPIRAL:
+            BuildSpiral(bp, 12, ATK_BONE_H, ATK_BONE_H);
+            break;
+            
+        case PATTERN_HOPE_SPIRAL:
+            BuildSpiral(bp, 16, ATK_BONE_H, ATK_YELLOW);
+            break;
+            
+        case PATTERN_HOPE_WAVE:
+            // x em fração da largura da caixa; y oscila com a fase da rajada
+            for (int i = 0; i < 10; i++) {
+                entries[i] = (PatternEntry){ {SimDiv(SimFromInt(i), SIM(10)), 0}, {0, SIM(1)}, {SimSin(i * SIM(0.5)), SimCos(i * SIM(0.5))}, i % 3 == 0 ? ATK_YELLOW : ATK_BONE_V };
+            }
+            PatternStore(bp, entries, 10, (SimVec2){0, SIM(30)});
+            break;
+            
+        default:
+            break;
+    }
+}
+
+// Pré-calcula os padrões usados pelo nível (chamado ao configurar o nível)
+void PatternCachePrepare(GameLevel level) {
+    switch (level) {
+        case LEVEL_MEMORY:
+            BuildPattern(PATTERN_MEMORY_ZIGZAG);
+            break;
+        case LEVEL_REGRET:
+            BuildPattern(PATTERN_REGRET_SPIRAL);
+            break;
+        case LEVEL_HOPE:
+            BuildPattern(PATTERN_HOPE_SPIRAL);
+            BuildPattern(PATTERN_HOPE_WAVE);
+            break;
+        default:
+            break;
+    }
+}
+
+// Dispara uma rajada: escala e translada o modelo e copia cada grupo de tipo
+// para o seu fluxo de uma vez
+void PatternBurst(AttackManager *am, PatternId id, Vector2 origin, Vector2 offsetScale, float speed, sim_t phase) {
+    const BulletPattern *bp = &patternCache[id];
+    if (!bp->built) BuildPattern(id);
+    
+    // Parâmetros em float viram escalar da simulação uma vez por rajada
+    SimVec2 base = SimVec2FromVector2(origin), scale = SimVec2FromVector2(offsetScale);
+    sim_t simSpeed = SimFromFloat(speed);
+    
+    // sen(fase + a) = sen(fase)cos(a) + cos(fase)sen(a): só um sen/cos por rajada
+    sim_t phaseSin = SimSin(phase), phaseCos = SimCos(phase);
+    SimVec2 ampSin = { SimMul(bp->waveAmplitude.x, phaseSin), SimMul(bp->waveAmplitude.y, phaseSin) };
+    SimVec2 ampCos = { SimMul(bp->waveAmplitude.x, phaseCos), SimMul(bp->waveAmplitude.y, phaseCos) };
+    
+    Projectile batch[MAX_PATTERN_BULLETS];
+    for (int t = 0; t < ATK_COUNT; t++) {
+        int first = bp->typeStart[t];
+        int count = bp->typeStart[t + 1] - first;
+        if (count == 0) continue;
+        
+        for (int i = 0; i < count; i++) {
+            int e = first + i;
+            batch[i].pos.x = base.x + SimMul(bp->offset[e].x, scale.x) + SimMul(ampSin.x, bp->wave[e].y) + SimMul(ampCos.x, bp->wave[e].x);
+            batch[i].pos.y = base.y + SimMul(bp->offset[e].y, scale.y) + SimMul(ampSin.y, bp->wave[e].y) + SimMul(ampCos.y, bp->wave[e].x);
+            batch[i].vel.x = SimMul(bp->dir[e].x, simSpeed);
+            batch[i].vel.y = SimMul(bp->dir[e].y, simSpeed);
+            batch[i].timer = 0;
+        }
+        SpawnProjectiles(am, batch, count, t);
+    }
+}
@@ -0,0 +1,33 @@
+#ifndef PATTERN_H
+#define PATTERN_H
+#include "raylib.h"
+#include "common.h"
+#include "attack.h"
+
+#define MAX_PATTERN_BULLETS 256
+
+// Padrões de disparo pré-calculados
+typedef enum {
+    PATTERN_MEMORY_ZIGZAG,  // Zigzag de fragmentos (LEVEL_MEMORY)
+    PATTERN_REGRET_SPIRAL,  // Espiral de 12 ossos (LEVEL_REGRET)
+    PATTERN_HOPE_SPIRAL,    // Espiral de 16 ossos/medos (LEVEL_HOPE)
+    PATTERN_HOPE_WAVE,      // Onda de 10 projéteis (LEVEL_HOPE)
+    PATTERN_COUNT
+} PatternId;
+
+// Modelo de uma rajada: as entradas ficam agrupadas por tipo para que cada
+// grupo seja copiado de uma vez para o fluxo correspondente
+typedef struct {
+    int count;
+    int typeStart[ATK_COUNT + 1];          // Entradas do tipo t: [typeStart[t], typeStart[t+1])
+    SimVec2 offset[MAX_PATTERN_BULLETS];   // Posição relativa à origem (multiplicada por offsetScale)
+    SimVec2 dir[MAX_PATTERN_BULLETS];      // Velocidade para speed = 1
+    SimVec2 wave[MAX_PATTERN_BULLETS];     // (sen, cos) da fase própria de cada entrada
+    SimVec2 waveAmplitude;                 // Deslocamento extra = amplitude * sen(fase + fase própria)
+    int built;
+} BulletPattern;
+
+void PatternCachePrepare(GameLevel level);
+void PatternBurst(AttackManager *am, PatternId id, Vector2 origin, Vector2 offsetScale, float speed, sim_t phase);  // phase em radianos
+
+#endif
@@ -0,0 +1,105 @@
+#include "pipeline.h"
+#include "utils.h"
+#include <pthread.h>
+
+static FramePacket packets[2];
+static int front = 0;                // Pacote que a thread principal desenha
+static PipelineFrameFn frameFn;
+static void *frameCtx;
+static int threaded = 0;
+
+static pthread_t worker;
+static pthread_mutex_t lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t wake = PTHREAD_COND_INITIALIZER;
+static GameInput pendingInput;
+static int busy = 0;                 // Há um frame simulando (ou pronto para trocar)
+static int ready = 0;                // O pacote de trás tem um frame novo
+static int stopping = 0;
+
+static double simSeconds = 0.0;
+static long simFrames = 0;
+
+// Um frame de simulação escrevendo no pacote de trás
+static void RunFrame(const GameInput *input) {
+    double start = TimeNow();
+    frameFn(frameCtx, input, &packets[1 - front]);
+    simSeconds += TimeNow() - start;
+    simFrames++;
+}
+
+static void *PipelineWorker(void *arg) {
+    (void)arg;
+    pthread_mutex_lock(&lock);
+    for (;;) {
+        while (!(busy && !ready) && !stopping) pthread_cond_wait(&wake, &lock);
+        if (stopping) break;
+
+        GameInput input = pendingInput;
+        pthread_mutex_unlock(&lock);
+        RunFrame(&input);
+        pthread_mutex_lock(&lock);
+
+        ready = 1;
+        pthread_cond_broadcast(&wake);
+    }
+    pthread_mutex_unlock(&lock);
+    return NULL;
+}
+
+int PipelineStart(PipelineFrameFn frame, void *ctx, const Game *initial, int useThread) {
+    frameFn = frame;
+    frameCtx = ctx;
+    front = 0;
+    busy = ready = stopping = 0;
+    GameExtractFrame(initial, &packets[front]);
+
+    threaded = useThread && pthread_create(&worker, NULL, PipelineWorker, NULL) == 0;
+    return threaded;
+}
+
+// Espera o frame em andamento e o coloca na frente
+void PipelineSync(void) {
+    if (!threaded) return;
+
+    pthread_mutex_lock(&lock);
+    while (busy && !ready) pthread_cond_wait(&wake, &lock);
+    if (ready) front = 1 - front;
+    busy = ready = 0;
+    pthread_mutex_unlock(&lock);
+}
+
+void PipelineSubmit(const GameInput *input) {
+    if (!threaded) {
+        // Sem thread: simula agora e já desenha o resultado
+        RunFrame(input);
+        front = 1 - front;
+        return;
+    }
+
+    pthread_mutex_lock(&lock);
+    pendingInput = *input;
+    busy = 1;
+    ready = 0;
+    pthread_cond_broadcast(&wake);
+    pthread_mutex_unlock(&lock);
+}
+
+const FramePacket *PipelineFront(void) {
+    return &packets[front];
+}
+
+double PipelineSimMs(void) {
+    return simFrames ? simSeconds * 1000.0 / simFrames : 0.0;
+}
+
+void PipelineStop(void) {
+    PipelineSync();
+    if (!threaded) return;
+
+    pthread_mutex_lock(&lock);
+    stopping = 1;
+    pthread_cond_broadcast(&wake);
+    pthread_mutex_unlock(&lock);
+    pthread_join(worker, NULL);
+    threaded = 0;
+}
@@ -0,0 +1,22 @@
+#ifndef PIPELINE_H
+#define PIPELINE_H
+#include "game.h"
+
+// Update e render em paralelo: enquanto a thread principal desenha o pacote
+// do tick N, uma thread de trabalho simula o tick N+1 e escreve no outro
+// pacote (buffer duplo). Entre PipelineSync e PipelineSubmit a simulação
+// está parada e a thread principal pode mexer no Game (áudio, carregador).
+//
+// Custo: a entrada lida num frame aparece na tela um frame depois.
+
+// Simula um frame com a entrada dada e preenche o pacote de desenho
+typedef void (*PipelineFrameFn)(void *ctx, const GameInput *input, FramePacket *out);
+
+int PipelineStart(PipelineFrameFn frame, void *ctx, const Game *initial, int threaded);
+void PipelineSync(void);
+void PipelineSubmit(const GameInput *input);
+const FramePacket *PipelineFront(void);     // Pacote completo mais recente
+double PipelineSimMs(void);                 // Média do tempo de simulação por frame
+void PipelineStop(void);
+
+#endif
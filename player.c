@@ -1,17 +1,18 @@
 #include "player.h"
+#include "telemetry.h"
 #include "raylib.h"
 #include <stdlib.h>
 #include <math.h>
 
 
 void PlayerInit(Player *p, Vector2 pos) {
-    p->size = 16.0f;  // Tamanho um pouco menor para facilitar desvios
-    p->speed = 5.0f;  // Velocidade maior para movimentação mais rápida
-    p->gravity = 0.6f;
-    p->jumpStrength = 10.0f;  // Pulo mais alto
-    p->maxFallSpeed = 14.0f;
-    p->pos = pos;
-    p->vel = (Vector2){0, 0};
+    p->size = SIM(16);  // Tamanho um pouco menor para facilitar desvios
+    p->speed = SIM(5);  // Velocidade maior para movimentação mais rápida
+    p->gravity = SIM(0.6);
+    p->jumpStrength = SIM(10);  // Pulo mais alto
+    p->maxFallSpeed = SIM(14);
+    p->pos = SimVec2FromVector2(pos);
+    p->vel = (SimVec2){0, 0};
     p->onGround = 0;
     p->hp = p->maxHp = 92;
     p->invulnerable = 0;
@@ -20,25 +21,42 @@ void PlayerInit(Player *p, Vector2 pos) {
     
     // Inicializar novas variáveis para os diferentes tipos de movimento
     p->moveType = MOVE_FREE; // Começa com movimento livre
-    p->velocityY = 0.0f;
+    p->velocityY = 0;
     p->isGrounded = false;
     p->isJumping = false;
-    p->jumpForce = 12.0f;
+    p->jumpForce = SIM(12);
     p->currentPlatform = -1; // Nenhuma plataforma inicialmente
+    p->slot = 0;
+    p->grazeTicks = p->grazeCount = p->grazeFlash = 0;
 }
 
-void PlayerUpdate(Player *p, Rectangle battleBox) {
-    float dt = GetFrameTime();
-    float move = 0;
+// Teclado local -> entrada do tick
+PlayerInput PlayerReadInput(void) {
+    PlayerInput in = {0};
+    // Teclado cru: eventos com horário da thread de entrada
+    if (InputRead(&in, IsWindowFocused())) return in;
+    
+    if (IsKeyDown(KEY_LEFT)  || IsKeyDown(KEY_A)) in.buttons |= INPUT_LEFT;
+    if (IsKeyDown(KEY_RIGHT) || IsKeyDown(KEY_D)) in.buttons |= INPUT_RIGHT;
+    if (IsKeyDown(KEY_UP)    || IsKeyDown(KEY_W)) in.buttons |= INPUT_UP;
+    if (IsKeyDown(KEY_DOWN)  || IsKeyDown(KEY_S)) in.buttons |= INPUT_DOWN;
+    if (IsKeyPressed(KEY_UP) || IsKeyPressed(KEY_W) || IsKeyPressed(KEY_SPACE)) in.buttons |= INPUT_JUMP;
+    if (IsKeyDown(KEY_LEFT_SHIFT) || IsKeyDown(KEY_RIGHT_SHIFT)) in.buttons |= INPUT_DASH;
+    return in;
+}
+
+void PlayerUpdate(Player *p, SimRect battleBox, PlayerInput input) {
+    // Velocidades em pixels por tick (o passo é fixo, SIM_DT)
+    sim_t move = 0;
     
     // Movimento horizontal (comum a todos os tipos de movimento)
-    if (IsKeyDown(KEY_RIGHT) || IsKeyDown(KEY_D)) move += 1.0f;
-    if (IsKeyDown(KEY_LEFT)  || IsKeyDown(KEY_A)) move -= 1.0f;
+    if (input.buttons & INPUT_RIGHT) move += SIM(1);
+    if (input.buttons & INPUT_LEFT)  move -= SIM(1);
     
     // Dash rápido para desviar (SHIFT + direção)
-    if (IsKeyDown(KEY_LEFT_SHIFT) || IsKeyDown(KEY_RIGHT_SHIFT)) {
+    if (input.buttons & INPUT_DASH) {
         if (move != 0) {
-            move *= 2.5f; // Dash mais rápido na direção do movimento
+            move = SimMul(move, SIM(2.5)); // Dash mais rápido na direção do movimento
         }
     }
     
@@ -46,13 +64,13 @@ void PlayerUpdate(Player *p, Rectangle battleBox) {
     switch (p->moveType) {
         case MOVE_FREE: // Movimento livre em todas as direções (original)
             // Movimento horizontal
-            p->pos.x += move * p->speed * dt * 60.0f;
+            p->pos.x += SimMul(move, p->speed);
             
             // Movimento vertical
-            float moveY = 0;
-            if (IsKeyDown(KEY_UP) || IsKeyDown(KEY_W)) moveY -= 1.0f;
-            if (IsKeyDown(KEY_DOWN) || IsKeyDown(KEY_S)) moveY += 1.0f;
-            p->pos.y += moveY * p->speed * dt * 60.0f;
+            sim_t moveY = 0;
+            if (input.buttons & INPUT_UP)   moveY -= SIM(1);
+            if (input.buttons & INPUT_DOWN) moveY += SIM(1);
+            p->pos.y += SimMul(moveY, p->speed);
             
             // Limites da caixa de batalha
             p->onGround = 0; // Sempre "no ar" neste modo
@@ -60,10 +78,10 @@ void PlayerUpdate(Player *p, Rectangle battleBox) {
             
         case MOVE_PLATFORMER: // Estilo Undertale - fixo ao chão com pulo
             // Movimento horizontal
-            p->pos.x += move * p->speed * dt * 60.0f;
+            p->pos.x += SimMul(move, p->speed);
             
             // Pulo (estilo Undertale)
-            if ((IsKeyPressed(KEY_UP) || IsKeyPressed(KEY_W) || IsKeyPressed(KEY_SPACE)) && p->isGrounded) {
+            if ((input.buttons & INPUT_JUMP) && p->isGrounded) {
                 p->velocityY = -p->jumpForce;
                 p->isGrounded = false;
                 p->isJumping = true;
@@ -71,12 +89,12 @@ void PlayerUpdate(Player *p, Rectangle battleBox) {
             
             // Aplicar gravidade
             if (!p->isGrounded) {
-                p->velocityY += p->gravity * dt * 60.0f;
+                p->velocityY += p->gravity;
                 if (p->velocityY > p->maxFallSpeed) p->velocityY = p->maxFallSpeed;
             }
             
             // Atualizar posição vertical
-            p->pos.y += p->velocityY * dt * 60.0f;
+            p->pos.y += p->velocityY;
             
             // Verificar se está no chão
             if (p->pos.y + p->size/2 >= battleBox.y + battleBox.height) {
@@ -92,11 +110,11 @@ void PlayerUpdate(Player *p, Rectangle battleBox) {
             
         case MOVE_PLATFORMS: // Movimento em plataformas flutuantes
             // Movimento horizontal
-            p->pos.x += move * p->speed * dt * 60.0f;
+            p->pos.x += SimMul(move, p->speed);
             
             // Pulo entre plataformas
-            if ((IsKeyPressed(KEY_UP) || IsKeyPressed(KEY_W) || IsKeyPressed(KEY_SPACE)) && p->isGrounded) {
-                p->velocityY = -p->jumpForce * 1.2f; // Pulo mais alto para alcançar plataformas
+            if ((input.buttons & INPUT_JUMP) && p->isGrounded) {
+                p->velocityY = -SimMul(p->jumpForce, SIM(1.2)); // Pulo mais alto para alcançar plataformas
                 p->isGrounded = false;
                 p->isJumping = true;
                 p->currentPlatform = -1; // Saiu da plataforma atual
@@ -104,12 +122,12 @@ void PlayerUpdate(Player *p, Rectangle battleBox) {
             
             // Aplicar gravidade
             if (!p->isGrounded) {
-                p->velocityY += p->gravity * dt * 60.0f;
+                p->velocityY += p->gravity;
                 if (p->velocityY > p->maxFallSpeed) p->velocityY = p->maxFallSpeed;
             }
             
             // Atualizar posição vertical
-            p->pos.y += p->velocityY * dt * 60.0f;
+            p->pos.y += p->velocityY;
             
             // A detecção de colisão com plataformas é feita externamente
             // em AttackManagerUpdate ou GameUpdate
@@ -132,43 +150,8 @@ void PlayerUpdate(Player *p, Rectangle battleBox) {
     }
 }
 
-void PlayerDraw(const Player *p) {
-    // Cor base do coração - vermelho escuro e pulsante
-    Color color;
-    
-    if (p->invulnerable && (p->invulFrames/4)%2) {
-        // Quando ferido, pisca em branco com efeito de "choque"
-        color = WHITE;
-    } else {
-        // Coração normal - vermelho escuro com pulsação sutil
-        float pulse = sinf(GetTime() * 3.0f) * 0.2f;
-        color = (Color){180 + (int)(20 * pulse), 0, 20, 255};
-    }
-    
-    // Efeito de desvanecimento ao morrer - a alma se dissipa
-    int alpha = 255;
-    if (p->isDead) {
-        alpha = 70 + (int)(sinf(GetTime() * 5.0f) * 30.0f); // Pulsação ao morrer
-    }
-    color.a = alpha;
-    
-    // Desenhar um coração pixel art fragmentado e pulsante
-    float heartbeat = 1.0f + sinf(GetTime() * 3.0f) * 0.1f; // Batimento cardíaco
-    float size = p->size * 1.5f * heartbeat; // Tamanho pulsante
-    float pixelSize = size / 8.0f;
-    
-    // Adicionar tremor sutil quando danificado
-    int tremor = 0;
-    if (p->hp < 50) {
-        tremor = GetRandomValue(-1, 1);
-    }
-    if (p->hp < 20) {
-        tremor = GetRandomValue(-2, 2);
-    }
-    
-    int x = p->pos.x + tremor;
-    int y = p->pos.y + tremor;
-    
+// Coração em pixel art centrado em (x, y)
+static void DrawHeartPixels(int x, int y, float pixelSize, Color color) {
     // Linha 1 (topo do coração)
     DrawRectangle(x - 3*pixelSize, y - 3*pixelSize, pixelSize, pixelSize, color);
     DrawRectangle(x - 2*pixelSize, y - 3*pixelSize, pixelSize, pixelSize, color);
@@ -212,6 +195,62 @@ void PlayerDraw(const Player *p) {
     // Linha 6
     DrawRectangle(x - 1*pixelSize, y + 2*pixelSize, pixelSize, pixelSize, color);
     DrawRectangle(x + 0*pixelSize, y + 2*pixelSize, pixelSize, pixelSize, color);
+}
+
+void PlayerDraw(const Player *p) {
+    Vector2 pos = SimVec2ToVector2(p->pos);
+    // Cor base do coração - vermelho escuro e pulsante
+    Color color;
+    
+    if (p->invulnerable && (p->invulFrames/4)%2) {
+        // Quando ferido, pisca em branco com efeito de "choque"
+        color = WHITE;
+    } else {
+        // Coração normal - vermelho escuro com pulsação sutil
+        float pulse = sinf(GetTime() * 3.0f) * 0.2f;
+        color = (Color){180 + (int)(20 * pulse), 0, 20, 255};
+        
+        // Parceiro do modo cooperativo em ciano para diferenciar
+        if (p->slot == 1) color = (Color){20, 160 + (int)(20 * pulse), 200, 255};
+    }
+    
+    // Efeito de desvanecimento ao morrer - a alma se dissipa
+    int alpha = 255;
+    if (p->isDead) {
+        alpha = 70 + (int)(sinf(GetTime() * 5.0f) * 30.0f); // Pulsação ao morrer
+    }
+    color.a = alpha;
+    
+    // Desenhar um coração pixel art fragmentado e pulsante
+    float heartbeat = 1.0f + sinf(GetTime() * 3.0f) * 0.1f; // Batimento cardíaco
+    float size = SimToFloat(p->size) * 1.5f * heartbeat; // Tamanho pulsante
+    float pixelSize = size / 8.0f;
+    
+    // Adicionar tremor sutil quando danificado
+    int tremor = 0;
+    if (p->hp < 50) {
+        tremor = GetRandomValue(-1, 1);
+    }
+    if (p->hp < 20) {
+        tremor = GetRandomValue(-2, 2);
+    }
+    
+    int x = pos.x + tremor;
+    int y = pos.y + tremor;
+    
+    DrawHeartPixels(x, y, pixelSize, color);
+    
+    // Faíscas de raspão: um anel que gira e se recolhe até o coração
+    if (p->grazeFlash > 0 && !p->isDead) {
+        float spin = p->grazeCount * 0.7f + p->grazeFlash * 0.25f;
+        float dist = size * 0.6f + p->grazeFlash * 1.5f;
+        unsigned char sparkAlpha = (unsigned char)(p->grazeFlash * 20 > 255 ? 255 : p->grazeFlash * 20);
+        for (int i = 0; i < 6; i++) {
+            float angle = spin + i * (2.0f * PI / 6.0f);
+            Vector2 spark = { pos.x + cosf(angle) * dist, pos.y + sinf(angle) * dist };
+            DrawRectangleV((Vector2){spark.x - 1, spark.y - 1}, (Vector2){2, 2}, (Color){230, 230, 255, sparkAlpha});
+        }
+    }
     
     // Efeitos visuais de dano - fragmentos de emoções perdidas
     if (p->invulnerable) {
@@ -219,8 +258,8 @@ void PlayerDraw(const Player *p) {
         for (int i = 0; i < 8; i++) {
             float angle = GetRandomValue(0, 360) * DEG2RAD;
             float dist = GetRandomValue(10, 30);
-            float px = p->pos.x + cosf(angle) * dist;
-            float py = p->pos.y + sinf(angle) * dist;
+            float px = pos.x + cosf(angle) * dist;
+            float py = pos.y + sinf(angle) * dist;
             float size = GetRandomValue(1, 4);
             
             // Cores alternando entre vermelho escuro e preto (sangue e vazio)
@@ -239,7 +278,7 @@ void PlayerDraw(const Player *p) {
             const char* fragments[] = {"dor", "medo", "perda", "vazio", "fim"};
             int idx = GetRandomValue(0, 4);
             int textWidth = MeasureText(fragments[idx], 12);
-            DrawText(fragments[idx], p->pos.x - textWidth/2, p->pos.y - 30, 12, 
+            DrawText(fragments[idx], pos.x - textWidth/2, pos.y - 30, 12, 
                    (Color){180, 180, 180, (unsigned char)(100 + sinf(GetTime() * 10.0f) * 50.0f)});
         }
     }
@@ -249,19 +288,27 @@ void PlayerDraw(const Player *p) {
         for (int i = 0; i < 3; i++) {
             float angle = GetRandomValue(0, 360) * DEG2RAD;
             float dist = GetRandomValue(5, 15);
-            float px = p->pos.x + cosf(angle) * dist;
-            float py = p->pos.y + sinf(angle) * dist;
+            float px = pos.x + cosf(angle) * dist;
+            float py = pos.y + sinf(angle) * dist;
             float fragSize = GetRandomValue(1, 3);
             DrawRectangle(px, py, fragSize, fragSize, (Color){180, 0, 20, 150});
         }
     }
 }
 
-void PlayerTakeDamage(Player *p, int dmg) {
+// Coração-fantasma (corrida contra um replay): só a silhueta translúcida
+void PlayerDrawGhost(const Player *p) {
+    Vector2 pos = SimVec2ToVector2(p->pos);
+    Color color = p->isDead ? (Color){200, 200, 255, 40} : (Color){200, 200, 255, 110};
+    DrawHeartPixels(pos.x, pos.y, SimToFloat(p->size) * 1.5f / 8.0f, color);
+}
+
+void PlayerTakeDamage(Player *p, int dmg, int source) {
     if (!p->invulnerable && !p->isDead) {
         p->hp -= dmg;
         p->invulnerable = 1;
         p->invulFrames = 30;
         if (p->hp < 0) p->hp = 0;
+        TelemetryEmit(TELEMETRY_HIT, source, SimToInt(p->pos.x), SimToInt(p->pos.y), dmg, p->hp);
     }
 }
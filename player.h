@@ -2,11 +2,13 @@
 #define PLAYER_H
 #include "raylib.h"
 #include "common.h" // Definições compartilhadas
+#include "input.h"
+#include "fixed.h"
 
 struct Player {
-    Vector2 pos, vel;
-    float size, speed;
-    float gravity, jumpStrength, maxFallSpeed;
+    SimVec2 pos, vel;
+    sim_t size, speed;
+    sim_t gravity, jumpStrength, maxFallSpeed;
     int onGround;
     int hp, maxHp;
     int invulnerable, invulFrames;
@@ -14,19 +16,27 @@ struct Player {
     
     // Variáveis para controle de pulo e gravidade
     PlayerMoveType moveType;
-    float velocityY;
+    sim_t velocityY;
     bool isGrounded;
     bool isJumping;
-    float jumpForce;
+    sim_t jumpForce;
     
-    // Plataforma atual (para MOVE_PLATFORMS)
+    // Id da entidade-plataforma atual (para MOVE_PLATFORMS, -1 se nenhuma)
     int currentPlatform;
+    
+    int slot;   // 0 = primeiro coração, 1 = parceiro no modo cooperativo
+    
+    // Raspão: ticks seguidos perto de uma ameaça, total da partida e
+    // frames restantes das faíscas
+    int grazeTicks, grazeCount, grazeFlash;
 };
 typedef struct Player Player;
 
+PlayerInput PlayerReadInput(void);
 void PlayerInit(Player *p, Vector2 pos);
-void PlayerUpdate(Player *p, Rectangle battleBox);
+void PlayerUpdate(Player *p, SimRect battleBox, PlayerInput input);
 void PlayerDraw(const Player *p);
-void PlayerTakeDamage(Player *p, int dmg);
+void PlayerDrawGhost(const Player *p);
+void PlayerTakeDamage(Player *p, int dmg, int source);   // source: AttackType (ATK_COUNT = obstáculo ou laser)
 
 #endif
@@ -0,0 +1,61 @@
+#include "quality.h"
+#include "common.h"
+#include "raylib.h"
+
+static QualityTier tier = QUALITY_HIGH;
+static float workSum = 0.0f, frameSum = 0.0f;
+static int samples = 0;
+static int relaxedWindows = 0;
+static float lastWorkMs = 0.0f, lastFrameMs = 0.0f;   // Médias da última janela
+
+static const char *tierNames[QUALITY_TIER_COUNT] = { "ALTA", "MÉDIA", "BAIXA", "MÍNIMA" };
+
+// workMs: CPU gasta em update + desenho; frameMs: intervalo real entre frames
+// (inclui a espera do vsync, então só passa do orçamento quando há atraso)
+void QualityUpdate(float workMs, float frameMs) {
+    workSum += workMs;
+    frameSum += frameMs;
+    if (++samples < QUALITY_WINDOW) return;
+
+    lastWorkMs = workSum / samples;
+    lastFrameMs = frameSum / samples;
+    workSum = frameSum = 0.0f;
+    samples = 0;
+
+    // Estourou o orçamento: desce um nível de uma vez
+    if (lastFrameMs > QUALITY_BUDGET_MS * 1.1f || lastWorkMs > QUALITY_BUDGET_MS * 0.9f) {
+        if (tier < QUALITY_MINIMAL) tier++;
+        relaxedWindows = 0;
+        return;
+    }
+
+    // Folga sustentada: sobe um nível (histerese evita oscilar)
+    if (lastWorkMs < QUALITY_BUDGET_MS * 0.5f) {
+        if (++relaxedWindows >= QUALITY_RECOVER_WINDOWS && tier > QUALITY_HIGH) {
+            tier--;
+            relaxedWindows = 0;
+        }
+    } else {
+        relaxedWindows = 0;
+    }
+}
+
+QualityTier QualityCurrent(void) {
+    return tier;
+}
+
+int QualityScaleCount(int full) {
+    switch (tier) {
+        case QUALITY_HIGH:   return full;
+        case QUALITY_MEDIUM: return full / 2;
+        case QUALITY_LOW:    return full / 4;
+        default:             return 0;
+    }
+}
+
+void QualityDrawOverlay(void) {
+    DrawRectangle(GAME_WIDTH - 230, 64, 220, 70, (Color){0, 0, 0, 160});
+    DrawFPS(GAME_WIDTH - 220, 70);
+    DrawText(TextFormat("Qualidade: %s", tierNames[tier]), GAME_WIDTH - 220, 92, 16, LIGHTGRAY);
+    DrawText(TextFormat("CPU %.2f ms  frame %.2f ms", lastWorkMs, lastFrameMs), GAME_WIDTH - 220, 112, 14, LIGHTGRAY);
+}
@@ -0,0 +1,24 @@
+#ifndef QUALITY_H
+#define QUALITY_H
+
+// Governador de qualidade: mede o tempo dos frames numa janela e troca de
+// nível de efeitos para caber no orçamento de 60 FPS. Só afeta o desenho;
+// nenhum estado de jogo depende dele.
+typedef enum {
+    QUALITY_HIGH,       // Tudo ligado
+    QUALITY_MEDIUM,     // Metade das partículas de fundo, sem palavras nos projéteis
+    QUALITY_LOW,        // Um quarto das partículas, ossos sem articulações, borda simples
+    QUALITY_MINIMAL,    // Sem partículas de fundo, borda só com linhas
+    QUALITY_TIER_COUNT
+} QualityTier;
+
+#define QUALITY_WINDOW 30                   // Frames por medição
+#define QUALITY_BUDGET_MS (1000.0f / 60.0f)
+#define QUALITY_RECOVER_WINDOWS 4           // Janelas folgadas seguidas antes de subir
+
+void QualityUpdate(float workMs, float frameMs);   // Uma vez por frame
+QualityTier QualityCurrent(void);
+int QualityScaleCount(int full);                   // Quantidade de partículas no nível atual
+void QualityDrawOverlay(void);
+
+#endif
@@ -0,0 +1,251 @@
+#define _POSIX_C_SOURCE 200809L
+#include "replay.h"
+#include <stdio.h>
+#include <stddef.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#define REPLAY_MAX_KEYFRAMES 4096       // ~5,7 h de partida
+
+#ifdef SIM_FIXED
+#define REPLAY_FIXED_POINT 1
+#else
+#define REPLAY_FIXED_POINT 0
+#endif
+
+// Gravação (só a thread que roda a simulação mexe nisso)
+static FILE *recordFile = NULL;
+static unsigned int recordFrame = 0;
+static ReplayIndexEntry recordIndex[REPLAY_MAX_KEYFRAMES];
+static int recordKeyframes = 0;
+static GameSnapshot recordSnapshot;
+static unsigned int recordCheckpointSerial[LEVEL_COUNT];
+static unsigned int recordCheckpointOffset[LEVEL_COUNT];
+
+// Replay aberto para leitura
+static const unsigned char *replayData = NULL;
+static size_t replaySize = 0;
+static const ReplayIndexEntry *replayIndex = NULL;
+static ReplayFooter replayFooter;
+static unsigned int replayInterval = 0;
+
+// Completa com zeros até o próximo múltiplo de REPLAY_ALIGN
+static void PadFile(FILE *f) {
+    static const unsigned char zeros[REPLAY_ALIGN];
+    long pos = ftell(f);
+    long padding = (REPLAY_ALIGN - pos % REPLAY_ALIGN) % REPLAY_ALIGN;
+    fwrite(zeros, 1, padding, f);
+}
+
+int ReplayRecordStart(const char *path) {
+    recordFile = fopen(path, "wb");
+    if (!recordFile) {
+        TraceLog(LOG_WARNING, "REPLAY: não foi possível criar %s", path);
+        return 0;
+    }
+
+    ReplayHeader header = { REPLAY_MAGIC, REPLAY_VERSION, GAME_SNAPSHOT_VERSION, sizeof(GameSnapshot),
+                            REPLAY_FIXED_POINT, REPLAY_KEYFRAME_INTERVAL };
+    fwrite(&header, sizeof(header), 1, recordFile);
+    recordFrame = 0;
+    recordKeyframes = 0;
+    memset(recordCheckpointSerial, 0, sizeof(recordCheckpointSerial));
+    memset(recordCheckpointOffset, 0, sizeof(recordCheckpointOffset));
+    TraceLog(LOG_INFO, "REPLAY: gravando em %s", path);
+    return 1;
+}
+
+int ReplayRecordFrame(const Game *g, const GameInput *in) {
+    if (!recordFile) return 0;
+
+    // Começo de bloco: quadro-chave com o estado antes deste frame
+    if (recordFrame % REPLAY_KEYFRAME_INTERVAL == 0) {
+        if (recordKeyframes == REPLAY_MAX_KEYFRAMES) {
+            TraceLog(LOG_WARNING, "REPLAY: limite de %d quadros-chave, gravação encerrada", REPLAY_MAX_KEYFRAMES);
+            ReplayRecordStop();
+            return 0;
+        }
+        ReplayIndexEntry *entry = &recordIndex[recordKeyframes++];
+        entry->frame = recordFrame;
+        
+        // Checkpoints novos desde o último bloco (um reinício depois de
+        // uma busca precisa dos mesmos que a partida original tinha)
+        for (int level = 0; level < LEVEL_COUNT; level++) {
+            unsigned int serial;
+            const GameSnapshot *checkpoint = GameCheckpointGet(level, &serial);
+            if (serial != recordCheckpointSerial[level]) {
+                recordCheckpointSerial[level] = serial;
+                recordCheckpointOffset[level] = 0;
+                if (checkpoint) {
+                    PadFile(recordFile);
+                    recordCheckpointOffset[level] = (unsigned int)ftell(recordFile);
+                    fwrite(checkpoint, GameSnapshotBytes(checkpoint), 1, recordFile);
+                }
+            }
+            entry->checkpoints[level] = recordCheckpointOffset[level];
+        }
+        
+        PadFile(recordFile);
+        entry->offset = (unsigned int)ftell(recordFile);
+        GameSnapshotCapture(g, &recordSnapshot);
+        fwrite(&recordSnapshot, GameSnapshotBytes(&recordSnapshot), 1, recordFile);
+    }
+
+    ReplayFrame frame = { in->player.buttons, 0, (signed char)in->practiceLevel, 0 };
+    if (in->confirm) frame.flags |= REPLAY_CONFIRM;
+    if (in->start) frame.flags |= REPLAY_START;
+    if (in->restart) frame.flags |= REPLAY_RESTART;
+    fwrite(&frame, sizeof(frame), 1, recordFile);
+    recordFrame++;
+    return 1;
+}
+
+void ReplayRecordStop(void) {
+    if (!recordFile) return;
+
+    PadFile(recordFile);
+    ReplayFooter footer = { recordKeyframes, recordFrame, (unsigned int)ftell(recordFile), REPLAY_INDEX_MAGIC };
+    fwrite(recordIndex, sizeof(ReplayIndexEntry), recordKeyframes, recordFile);
+    fwrite(&footer, sizeof(footer), 1, recordFile);
+    fclose(recordFile);
+    recordFile = NULL;
+    TraceLog(LOG_INFO, "REPLAY: %u frames, %d quadros-chave gravados", footer.frameCount, footer.keyframeCount);
+}
+
+// Tamanho do snapshot gravado em "offset" (0 se não cabe antes de "end")
+static size_t StoredSnapshotBytes(const unsigned char *data, size_t offset, size_t end) {
+    if (offset % REPLAY_ALIGN != 0 || offset + offsetof(GameSnapshot, game.attacks.projectiles) > end) return 0;
+    size_t bytes = GameSnapshotBytes((const GameSnapshot *)(data + offset));
+    return bytes > 0 && offset + bytes <= end ? bytes : 0;
+}
+
+// As entradas do bloco vêm logo depois do seu quadro-chave
+static const ReplayFrame *BlockFrames(const ReplayIndexEntry *block) {
+    const GameSnapshot *keyframe = (const GameSnapshot *)(replayData + block->offset);
+    return (const ReplayFrame *)(replayData + block->offset + GameSnapshotBytes(keyframe));
+}
+
+// Confere cabeçalho, rodapé e que cada bloco cabe no arquivo
+static int ReplayValidate(const unsigned char *data, size_t size) {
+    if (size < sizeof(ReplayHeader) + sizeof(ReplayFooter)) return 0;
+
+    const ReplayHeader *header = (const ReplayHeader *)data;
+    if (memcmp(header->magic, REPLAY_MAGIC, 4) != 0 || header->version != REPLAY_VERSION) return 0;
+    if (header->snapshotVersion != GAME_SNAPSHOT_VERSION || header->snapshotSize != sizeof(GameSnapshot) ||
+        header->fixedPoint != REPLAY_FIXED_POINT || header->keyframeInterval == 0) {
+        TraceLog(LOG_WARNING, "REPLAY: gravado por outro build do jogo");
+        return 0;
+    }
+
+    ReplayFooter footer;
+    memcpy(&footer, data + size - sizeof(footer), sizeof(footer));
+    size_t indexEnd = (size_t)footer.indexOffset + (size_t)footer.keyframeCount * sizeof(ReplayIndexEntry);
+    if (memcmp(footer.magic, REPLAY_INDEX_MAGIC, 4) != 0 || footer.keyframeCount == 0 ||
+        footer.indexOffset % sizeof(unsigned int) != 0 || indexEnd != size - sizeof(footer)) return 0;
+
+    const ReplayIndexEntry *index = (const ReplayIndexEntry *)(data + footer.indexOffset);
+    for (unsigned int k = 0; k < footer.keyframeCount; k++) {
+        unsigned int first = k * header->keyframeInterval;
+        unsigned int frames = footer.frameCount - first;
+        if (frames > header->keyframeInterval) frames = header->keyframeInterval;
+        size_t keyframeBytes = StoredSnapshotBytes(data, index[k].offset, footer.indexOffset);
+        if (index[k].frame != first || first >= footer.frameCount || keyframeBytes == 0 ||
+            (size_t)index[k].offset + keyframeBytes + frames * sizeof(ReplayFrame) > footer.indexOffset) {
+            return 0;
+        }
+        for (int level = 0; level < LEVEL_COUNT; level++) {
+            unsigned int offset = index[k].checkpoints[level];
+            if (offset != 0 && StoredSnapshotBytes(data, offset, footer.indexOffset) == 0) return 0;
+        }
+    }
+
+    replayFooter = footer;
+    replayIndex = index;
+    replayInterval = header->keyframeInterval;
+    return 1;
+}
+
+int ReplayOpen(const char *path) {
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) {
+        TraceLog(LOG_WARNING, "REPLAY: %s não encontrado", path);
+        return 0;
+    }
+
+    struct stat st;
+    if (fstat(fd, &st) < 0 || st.st_size == 0) {
+        close(fd);
+        return 0;
+    }
+
+    void *map = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);   // O mapeamento continua válido sem o descritor
+    if (map == MAP_FAILED) return 0;
+
+    if (!ReplayValidate(map, st.st_size)) {
+        TraceLog(LOG_WARNING, "REPLAY: %s inválido", path);
+        munmap(map, st.st_size);
+        return 0;
+    }
+
+    replayData = map;
+    replaySize = st.st_size;
+    TraceLog(LOG_INFO, "REPLAY: %s com %u frames e %u quadros-chave (%zu bytes)",
+             path, replayFooter.frameCount, replayFooter.keyframeCount, replaySize);
+    return 1;
+}
+
+int ReplayFrameCount(void) {
+    return replayData ? (int)replayFooter.frameCount : 0;
+}
+
+int ReplayStep(Game *g, int frame) {
+    if (!replayData || frame < 0 || frame >= (int)replayFooter.frameCount) return 0;
+
+    const ReplayIndexEntry *block = &replayIndex[frame / replayInterval];
+    const ReplayFrame *rf = BlockFrames(block) + (frame - block->frame);
+
+    GameInput in = {0};
+    in.player.buttons = rf->buttons;
+    in.confirm = (rf->flags & REPLAY_CONFIRM) != 0;
+    in.start = (rf->flags & REPLAY_START) != 0;
+    in.restart = (rf->flags & REPLAY_RESTART) != 0;
+    in.practiceLevel = rf->practiceLevel;
+    GameUpdate(g, &in);
+    return 1;
+}
+
+const GameSnapshot *ReplayKeyframe(int frame) {
+    if (!replayData || frame < 0 || frame % replayInterval != 0) return NULL;
+    unsigned int k = frame / replayInterval;
+    if (k >= replayFooter.keyframeCount) return NULL;
+    return (const GameSnapshot *)(replayData + replayIndex[k].offset);
+}
+
+int ReplaySeek(Game *g, int frame) {
+    if (!replayData) return 0;
+    if (frame < 0) frame = 0;
+    if (frame > (int)replayFooter.frameCount) frame = replayFooter.frameCount;
+
+    // Quadro-chave anterior e ressimulação só do resto do bloco
+    unsigned int k = frame / replayInterval;
+    if (k >= replayFooter.keyframeCount) k = replayFooter.keyframeCount - 1;
+    if (!GameSnapshotRestore(g, (const GameSnapshot *)(replayData + replayIndex[k].offset))) return 0;
+    for (int level = 0; level < LEVEL_COUNT; level++) {
+        unsigned int offset = replayIndex[k].checkpoints[level];
+        GameCheckpointSet(level, offset ? (const GameSnapshot *)(replayData + offset) : NULL);
+    }
+
+    for (int f = replayIndex[k].frame; f < frame; f++) ReplayStep(g, f);
+    return 1;
+}
+
+void ReplayClose(void) {
+    if (replayData) munmap((void *)replayData, replaySize);
+    replayData = NULL;
+    replaySize = 0;
+    replayIndex = NULL;
+}
@@ -0,0 +1,77 @@
+#ifndef REPLAY_H
+#define REPLAY_H
+#include "game.h"
+
+// Replay com quadros-chave: as entradas de cada frame mais um snapshot
+// completo da partida a cada REPLAY_KEYFRAME_INTERVAL frames. Para ir ao
+// frame N basta restaurar o quadro-chave anterior e ressimular no máximo
+// REPLAY_KEYFRAME_INTERVAL - 1 frames, sem voltar ao início da partida.
+//
+// Formato (inteiros na ordem de bytes da máquina que gravou):
+//   ReplayHeader
+//   blocos, cada um alinhado a REPLAY_ALIGN:
+//     GameSnapshot[] dos checkpoints de nível que mudaram desde o bloco anterior
+//     GameSnapshot (estado antes do primeiro frame do bloco)
+//   cada GameSnapshot com só GameSnapshotBytes bytes (até o último projétil vivo)
+//     ReplayFrame[REPLAY_KEYFRAME_INTERVAL] (o último bloco pode ter menos)
+//   ReplayIndexEntry[keyframeCount] | ReplayFooter (no fim do arquivo)
+//
+// Só vale para o mesmo build: o cabeçalho guarda a versão e o tamanho do
+// snapshot e se a simulação é em ponto fixo.
+#define REPLAY_MAGIC "HREP"
+#define REPLAY_INDEX_MAGIC "HRIX"
+#define REPLAY_VERSION 2
+#define REPLAY_ALIGN 64
+#define REPLAY_KEYFRAME_INTERVAL 300    // 5 s a 60 FPS
+
+typedef struct {
+    char magic[4];
+    unsigned int version;
+    unsigned int snapshotVersion;   // GAME_SNAPSHOT_VERSION
+    unsigned int snapshotSize;      // sizeof(GameSnapshot)
+    unsigned int fixedPoint;        // 1 se gravado com SIM_FIXED
+    unsigned int keyframeInterval;
+} ReplayHeader;
+
+// Entrada de um frame (o que GameUpdate recebeu)
+enum {
+    REPLAY_CONFIRM = 1 << 0,
+    REPLAY_START   = 1 << 1,
+    REPLAY_RESTART = 1 << 2
+};
+
+typedef struct {
+    unsigned char buttons;
+    unsigned char flags;
+    signed char practiceLevel;      // -1 se nenhum
+    unsigned char reserved;
+} ReplayFrame;
+
+typedef struct {
+    unsigned int frame;             // Primeiro frame do bloco
+    unsigned int offset;            // Início do GameSnapshot do bloco
+    unsigned int checkpoints[LEVEL_COUNT];  // Checkpoint de cada nível nesse momento (0 = nenhum)
+} ReplayIndexEntry;
+
+typedef struct {
+    unsigned int keyframeCount;
+    unsigned int frameCount;
+    unsigned int indexOffset;
+    char magic[4];
+} ReplayFooter;
+
+// Gravação (chamar ReplayRecordFrame antes de GameUpdate com a mesma entrada;
+// retorna 0 quando a gravação já terminou)
+int ReplayRecordStart(const char *path);
+int ReplayRecordFrame(const Game *g, const GameInput *in);
+void ReplayRecordStop(void);
+
+// Leitura via mmap
+int ReplayOpen(const char *path);
+int ReplayFrameCount(void);
+int ReplaySeek(Game *g, int frame);     // Estado antes do frame (0..ReplayFrameCount())
+int ReplayStep(Game *g, int frame);     // Aplica a entrada do frame (leva ao estado frame + 1)
+const GameSnapshot *ReplayKeyframe(int frame);  // Quadro-chave gravado antes do frame (NULL se não houver; ler só GameSnapshotBytes)
+void ReplayClose(void);
+
+#endif
@@ -0,0 +1,93 @@
+#include "screen.h"
+#include "raylib.h"
+#include <math.h>
+
+static RenderTexture2D target;
+static int ready = 0;               // Sem textura: desenha direto na janela
+static int internalWidth = GAME_WIDTH, internalHeight = GAME_HEIGHT;
+static ScreenScale scaleMode = SCREEN_SCALE_INTEGER;
+static Camera2D camera;             // Coordenadas lógicas -> pixels da textura (ou da janela)
+
+static const char *scaleNames[] = { "inteira", "filtrada" };
+
+// Encaixa a área lógica em w x h mantendo a proporção (a sobra vira tarja)
+static Camera2D FitCamera(int w, int h) {
+    float zoom = fminf((float)w / GAME_WIDTH, (float)h / GAME_HEIGHT);
+    Vector2 offset = { floorf((w - GAME_WIDTH * zoom) / 2), floorf((h - GAME_HEIGHT * zoom) / 2) };
+    return (Camera2D){ offset, (Vector2){ 0, 0 }, 0.0f, zoom };
+}
+
+// Onde a imagem interna fica na janela. Na escala inteira, uma janela menor
+// que a resolução interna cai para a redução fracionária (sem filtro)
+static Rectangle OutputRect(void) {
+    int w = GetScreenWidth(), h = GetScreenHeight();
+    float scale = fminf((float)w / internalWidth, (float)h / internalHeight);
+    if (scaleMode == SCREEN_SCALE_INTEGER && scale >= 1.0f) scale = floorf(scale);
+    float outWidth = internalWidth * scale, outHeight = internalHeight * scale;
+    return (Rectangle){ floorf((w - outWidth) / 2), floorf((h - outHeight) / 2), outWidth, outHeight };
+}
+
+// O mouse da raylib devolve (posição + offset) * scale: leva a janela de
+// volta às coordenadas lógicas. "out" é onde os w x h pixels da câmera estão
+static void MapMouse(Rectangle out, int w, int h) {
+    float sx = out.width / w, sy = out.height / h;
+    SetMouseOffset((int)-(out.x + camera.offset.x * sx), (int)-(out.y + camera.offset.y * sy));
+    SetMouseScale(1.0f / (camera.zoom * sx), 1.0f / (camera.zoom * sy));
+}
+
+int ScreenInit(int width, int height, ScreenScale scale) {
+    if (width < SCREEN_MIN_WIDTH || height < SCREEN_MIN_HEIGHT) {
+        TraceLog(LOG_WARNING, "SCREEN: resolução interna %dx%d abaixo do mínimo, usando %dx%d", width, height, GAME_WIDTH, GAME_HEIGHT);
+        width = GAME_WIDTH;
+        height = GAME_HEIGHT;
+    }
+    internalWidth = width;
+    internalHeight = height;
+    scaleMode = scale;
+
+    target = LoadRenderTexture(width, height);
+    ready = target.id != 0;
+    if (!ready) {
+        TraceLog(LOG_WARNING, "SCREEN: sem RenderTexture, desenhando direto na janela");
+        return 0;
+    }
+    SetTextureFilter(target.texture, scale == SCREEN_SCALE_FILTERED ? TEXTURE_FILTER_BILINEAR : TEXTURE_FILTER_POINT);
+    camera = FitCamera(width, height);
+    MapMouse(OutputRect(), width, height);
+    TraceLog(LOG_INFO, "SCREEN: resolução interna %dx%d, escala %s", width, height, scaleNames[scale]);
+    return 1;
+}
+
+void ScreenBeginFrame(void) {
+    if (ready) {
+        BeginTextureMode(target);
+    } else {
+        camera = FitCamera(GetScreenWidth(), GetScreenHeight());
+        BeginDrawing();
+    }
+    BeginMode2D(camera);
+}
+
+void ScreenEndFrame(void) {
+    EndMode2D();
+    if (!ready) {
+        int w = GetScreenWidth(), h = GetScreenHeight();
+        EndDrawing();
+        MapMouse((Rectangle){ 0, 0, w, h }, w, h);
+        return;
+    }
+    EndTextureMode();
+
+    // Um quad só na janela; a textura do OpenGL vem de cabeça para baixo
+    Rectangle out = OutputRect();
+    BeginDrawing();
+    ClearBackground(BLACK);
+    DrawTexturePro(target.texture, (Rectangle){ 0, 0, internalWidth, -internalHeight }, out, (Vector2){ 0, 0 }, 0.0f, WHITE);
+    EndDrawing();
+    MapMouse(out, internalWidth, internalHeight);   // Janela pode ter mudado de tamanho
+}
+
+void ScreenShutdown(void) {
+    if (ready) UnloadRenderTexture(target);
+    ready = 0;
+}
@@ -0,0 +1,25 @@
+#ifndef SCREEN_H
+#define SCREEN_H
+#include "common.h"
+
+// Resolução interna fixa: o jogo inteiro desenha em coordenadas lógicas
+// (GAME_WIDTH x GAME_HEIGHT) numa RenderTexture do tamanho interno, e só o
+// quad final ocupa a janela. O custo de preenchimento depende da resolução
+// interna (800x600, ou 400x300 nas máquinas fracas), não da tela.
+//
+// Uso: ScreenBeginFrame no lugar do BeginDrawing e ScreenEndFrame no lugar
+// do EndDrawing. O mouse já chega em coordenadas lógicas.
+#define SCREEN_MIN_WIDTH 160
+#define SCREEN_MIN_HEIGHT 120
+
+typedef enum {
+    SCREEN_SCALE_INTEGER,       // Maior múltiplo inteiro que cabe na janela, sem filtro
+    SCREEN_SCALE_FILTERED       // Ocupa a janela mantendo a proporção, com filtro bilinear
+} ScreenScale;
+
+int ScreenInit(int width, int height, ScreenScale scale);   // Depois do InitWindow
+void ScreenBeginFrame(void);
+void ScreenEndFrame(void);          // Escala a imagem interna para a janela
+void ScreenShutdown(void);          // Antes do CloseWindow
+
+#endif
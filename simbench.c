@@ -0,0 +1,465 @@
+// Benchmark da simulação sem janela: roda GameTick em todos os níveis com
+// entradas sorteadas (sempre as mesmas) e mede o tempo por tick.
+//   ./simbench          tempo por tick e hash encadeado de todos os ticks
+//   ./simbench --trace  hash do estado a cada tick (para comparar builds)
+//   ./simbench --us     só o tempo por tick (make bench compara float x ponto fixo)
+//   ./simbench --ghost  custo do tick do fantasma ao lado de uma partida ao vivo
+//   ./simbench --graze  grade de ameaças x varredura de tudo (1k e 10k projéteis;
+//                       make simbench-big compila com MAX_PROJECTILES maior)
+//   ./simbench --steer  custo do tick com centenas/milhares de teleguiados
+//   ./simbench --lasers custo por feixe (giro e teste de colisão) com o máximo de feixes
+//   ./simbench --boss   o chefe do início ao fim: tick completo com milhares de projéteis
+//   ./simbench --bot    o jogador automático joga do menu até a vitória (mortes por nível)
+// make bench compara float x ponto fixo; make determinism compila o ponto
+// fixo com flags bem diferentes e confere que os hashes batem tick a tick.
+#include "game.h"
+#include "ghost.h"
+#include "bot.h"
+#include "replay.h"
+#include "spatial.h"
+#include "utils.h"
+#include <stdio.h>
+#include <string.h>
+
+#define BENCH_TICKS_PER_LEVEL 6000
+#define BENCH_ROUNDS 20
+#define BENCH_INPUT_HOLD 8          // Ticks com a mesma entrada
+#define BENCH_GHOST_FILE "simbench-ghost.hrep"
+#define BENCH_GRAZE_TICKS 2000
+#define BENCH_GRAZE_RADIUS SIM(12)  // O mesmo raio de raspão do jogo
+#define BENCH_GRAZE_TRIES 256
+#define BENCH_STEER_TICKS 2000
+#define BENCH_LASER_TICKS 20000
+#define BENCH_BOSS_MIN_LIVE 2000        // O padrão mais denso tem que passar disso
+#define BENCH_BOSS_BUDGET_FRACTION 0.25 // Pior tick do chefe cabe num quarto do frame a 60 FPS
+#define BENCH_BOT_MAX_TICKS (60 * 60 * 30)  // Desiste depois de 30 minutos de jogo
+#define BENCH_BOT_BUDGET_FRACTION 0.25  // Decisão cabe num quarto do frame a 60 FPS
+#define BENCH_BOT_LATE_FRACTION 0.005   // Decisões fora do prazo em tempo real toleradas (preempção)
+
+#ifdef SIM_FIXED
+#define BENCH_MODE "ponto fixo"
+#else
+#define BENCH_MODE "float"
+#endif
+
+// Uma passada por todos os níveis; devolve o hash encadeado (0 se hash == 0)
+static unsigned int RunLevels(Game *g, int hash, int trace, long *ticks) {
+    unsigned int inputRng = RAND_DEFAULT_SEED, chain = HASH_SEED;
+    PlayerInput inputs[2] = {0};
+
+    for (int level = LEVEL_VOID; level < LEVEL_COUNT; level++) {
+        GameRestart(g, level);
+        for (int i = 0; i < BENCH_TICKS_PER_LEVEL; i++) {
+            if (i % BENCH_INPUT_HOLD == 0) {
+                inputs[0].buttons = RandNext(&inputRng) & 0x3F;
+                inputs[1].buttons = RandNext(&inputRng) & 0x3F;
+            }
+            // Morte ou nível vencido: recomeça o mesmo nível, para que float e
+            // ponto fixo meçam o mesmo trabalho mesmo com partidas diferentes
+            if (!g->running || g->currentLevel != (GameLevel)level) GameRestart(g, level);
+            GameTick(g, inputs);
+            (*ticks)++;
+
+            if (!hash) continue;
+            unsigned int h = GameStateHash(g);
+            chain = HashBytes(chain, &h, sizeof(h));
+            if (trace) printf("%ld %08x\n", *ticks, h);
+        }
+    }
+    return hash ? chain : 0;
+}
+
+// Partida pelo menu com entradas sorteadas: ENTER a cada segundo (começar e
+// tentar de novo) e troca de nível a cada BENCH_TICKS_PER_LEVEL
+static GameInput ScriptedInput(int tick, unsigned int *rng, GameInput *held) {
+    if (tick % BENCH_INPUT_HOLD == 0) held->player.buttons = RandNext(rng) & 0x3F;
+    GameInput in = *held;
+    in.confirm = in.start = tick % 60 == 3;
+    in.practiceLevel = tick % BENCH_TICKS_PER_LEVEL == 30 ? (tick / BENCH_TICKS_PER_LEVEL) % LEVEL_COUNT : -1;
+    return in;
+}
+
+// Grava uma partida e a usa de fantasma numa segunda, com entradas
+// diferentes; o pior tick do fantasma tem que caber em GHOST_BUDGET_FRACTION
+static int RunGhost(void) {
+    static Game live;
+    int ticks = BENCH_TICKS_PER_LEVEL * LEVEL_COUNT;
+    unsigned int rng = RAND_DEFAULT_SEED;
+    GameInput held = {0};
+
+    GameInit(&live);
+    if (!ReplayRecordStart(BENCH_GHOST_FILE)) return 1;
+    for (int i = 0; i < ticks; i++) {
+        GameInput in = ScriptedInput(i, &rng, &held);
+        ReplayRecordFrame(&live, &in);
+        GameUpdate(&live, &in);
+    }
+    ReplayRecordStop();
+
+    // Partida nova (sem os checkpoints da gravação) contra o fantasma
+    GameInit(&live);
+    for (int level = 0; level < LEVEL_COUNT; level++) GameCheckpointSet(level, NULL);
+    if (!GhostStart(BENCH_GHOST_FILE)) return 1;
+    rng = RAND_DEFAULT_SEED ^ 0x9E3779B9u;
+    for (int i = 0; i < ticks; i++) {
+        GameInput in = ScriptedInput(i, &rng, &held);
+        GameUpdate(&live, &in);
+        GhostStep(&live);
+    }
+
+    GhostStats s;
+    GhostGetStats(&s);
+    GhostStop();
+    remove(BENCH_GHOST_FILE);
+    double budgetUs = GHOST_BUDGET_FRACTION * 1e6 / 60.0;
+    printf("%s: fantasma %ld ticks, média %.3f us, pior %.1f us com %d projéteis (limite %.0f us)\n",
+           BENCH_MODE, s.steps, s.avgUs, s.maxUs, s.maxProjectiles, budgetUs);
+    return s.maxUs <= budgetUs ? 0 : 1;
+}
+
+// Referência de força bruta: a hitbox contra todos os projéteis e obstáculos,
+// como o jogo fazia antes da grade
+static int ScanHit(const AttackManager *am, const SimRect *hitbox) {
+    for (int t = 0; t < ATK_COUNT; t++) {
+        const AttackTypeInfo *info = &attackTypeInfo[t];
+        sim_t width = SimFromFloat(info->width), height = SimFromFloat(info->height);
+        sim_t offsetX = SimFromFloat(info->offset.x), offsetY = SimFromFloat(info->offset.y);
+        sim_t minX = hitbox->x - offsetX - width;
+        sim_t maxX = hitbox->x + hitbox->width - offsetX;
+        sim_t minY = hitbox->y - offsetY - height;
+        sim_t maxY = hitbox->y + hitbox->height - offsetY;
+
+        int hit = 0;
+        for (int i = am->streamStart[t]; i < am->streamStart[t + 1]; i++) {
+            const Projectile *p = &am->projectiles[i];
+            hit |= (p->pos.x > minX) & (p->pos.x < maxX) & (p->pos.y > minY) & (p->pos.y < maxY);
+        }
+        if (hit) return 1;
+    }
+    return EntityDamageSystem(&am->entities, hitbox) > 0;
+}
+
+static ThreatQuery NaiveQuery(const AttackManager *am, const SimRect *hitbox, sim_t radius) {
+    ThreatQuery q = { ScanHit(am, hitbox), 0, 0, ATK_COUNT };
+    if (q.hit) return q;
+    for (int t = 0; t < ATK_COUNT; t++) {
+        const AttackTypeInfo *info = &attackTypeInfo[t];
+        for (int i = am->streamStart[t]; i < am->streamStart[t + 1]; i++) {
+            const Projectile *p = &am->projectiles[i];
+            SimRect r = { p->pos.x + SimFromFloat(info->offset.x), p->pos.y + SimFromFloat(info->offset.y),
+                          SimFromFloat(info->width), SimFromFloat(info->height) };
+            sim_t dx = r.x - (hitbox->x + hitbox->width), dxl = hitbox->x - (r.x + r.width);
+            sim_t dy = r.y - (hitbox->y + hitbox->height), dyt = hitbox->y - (r.y + r.height);
+            sim_t gap = dx > dxl ? dx : dxl;
+            if (dy > gap) gap = dy;
+            if (dyt > gap) gap = dyt;
+            if (gap <= radius && (!q.near || gap < q.gap)) {
+                q.near = 1;
+                q.gap = gap;
+            }
+        }
+    }
+    return q;
+}
+
+static int SameQuery(const ThreatQuery *a, const ThreatQuery *b) {
+    return a->hit == b->hit && (a->hit || (a->near == b->near && (!a->near || a->gap == b->gap)));
+}
+
+// Montagem e duas consultas num arranjo; devolve o tempo gasto
+static double LayoutTick(ThreatGrid *grid, const AttackManager *am, ThreatLayout layout, const SimRect hearts[2], ThreatQuery q[2]) {
+    double start = TimeNow();
+    ThreatGridBuildLayout(grid, am, layout);
+    for (int h = 0; h < 2; h++) q[h] = ThreatGridQuery(grid, &hearts[h], BENCH_GRAZE_RADIUS);
+    return TimeNow() - start;
+}
+
+// Projéteis sorteados na tela inteira andando em linha reta (dando a volta
+// nas bordas); por tick, monta a grade e a lista e consulta dois corações
+// sorteados em cada uma, e compara com a varredura de tudo. Mostra a partir
+// de quantos projéteis a grade compensa (THREAT_GRID_MIN_PROJECTILES)
+static int RunGraze(void) {
+    static AttackManager am;
+    static ThreatGrid grid;
+    static const int counts[] = { 16, 32, 64, 128, 256, 512, 1000, 10000 };
+    int mismatches = 0, crossover = 0;
+
+    for (unsigned int c = 0; c < sizeof(counts) / sizeof(counts[0]); c++) {
+        int n = counts[c];
+        if (n > MAX_PROJECTILES) {
+            printf("%s: %d projéteis não cabem em MAX_PROJECTILES = %d (use make simbench-big)\n",
+                   BENCH_MODE, n, MAX_PROJECTILES);
+            continue;
+        }
+
+        unsigned int rng = RAND_DEFAULT_SEED;
+        AttackManagerInit(&am, (Rectangle){0, 0, GAME_WIDTH, GAME_HEIGHT});
+        for (int t = 0; t <= ATK_COUNT; t++) am.streamStart[t] = n * t / ATK_COUNT;
+        for (int i = 0; i < n; i++) {
+            Projectile *p = &am.projectiles[i];
+            p->pos = (SimVec2){ SimFromInt(RandNext(&rng) % GAME_WIDTH), SimFromInt(RandNext(&rng) % GAME_HEIGHT) };
+            p->vel = (SimVec2){ SimFromInt((int)(RandNext(&rng) % 7) - 3), SimFromInt((int)(RandNext(&rng) % 7) - 3) };
+        }
+
+        double gridTime = 0, listTime = 0, naiveTime = 0;
+        int hits = 0, grazes = 0;
+        for (int tick = 0; tick < BENCH_GRAZE_TICKS; tick++) {
+            for (int i = 0; i < n; i++) {
+                Projectile *p = &am.projectiles[i];
+                p->pos.x += p->vel.x;
+                p->pos.y += p->vel.y;
+                if (p->pos.x < 0) p->pos.x += SimFromInt(GAME_WIDTH);
+                if (p->pos.x >= SimFromInt(GAME_WIDTH)) p->pos.x -= SimFromInt(GAME_WIDTH);
+                if (p->pos.y < 0) p->pos.y += SimFromInt(GAME_HEIGHT);
+                if (p->pos.y >= SimFromInt(GAME_HEIGHT)) p->pos.y -= SimFromInt(GAME_HEIGHT);
+            }
+
+            // Corações sorteados, de preferência num vão (com 10k a tela fica
+            // quase toda coberta, e uma consulta que acerta para cedo)
+            ThreatGridBuildLayout(&grid, &am, THREAT_LAYOUT_GRID);
+            SimRect hearts[2];
+            for (int h = 0; h < 2; h++) {
+                for (int tries = 0; tries < BENCH_GRAZE_TRIES; tries++) {
+                    hearts[h] = (SimRect){ SimFromInt(RandNext(&rng) % GAME_WIDTH), SimFromInt(RandNext(&rng) % GAME_HEIGHT),
+                                           SIM(9.6), SIM(9.6) };
+                    if (!ThreatGridQuery(&grid, &hearts[h], 0).hit) break;
+                }
+            }
+
+            ThreatQuery q[2], list[2], ref[2];
+            gridTime += LayoutTick(&grid, &am, THREAT_LAYOUT_GRID, hearts, q);
+            listTime += LayoutTick(&grid, &am, THREAT_LAYOUT_LIST, hearts, list);
+            double t0 = TimeNow();
+            for (int h = 0; h < 2; h++) ref[h] = NaiveQuery(&am, &hearts[h], BENCH_GRAZE_RADIUS);
+            naiveTime += TimeNow() - t0;
+
+            for (int h = 0; h < 2; h++) {
+                hits += q[h].hit;
+                grazes += !q[h].hit && q[h].near;
+                mismatches += !SameQuery(&q[h], &ref[h]) + !SameQuery(&list[h], &ref[h]);
+            }
+        }
+
+        double perTick = 1e6 / BENCH_GRAZE_TICKS;
+        printf("%s: %5d projéteis, grade %.2f us, lista %.2f us (montar + 2 consultas por tick); varrer tudo %.2f us (%d acertos, %d raspões)\n",
+               BENCH_MODE, n, gridTime * perTick, listTime * perTick, naiveTime * perTick, hits, grazes);
+        if (!crossover && gridTime < listTime) crossover = n;
+    }
+
+    if (crossover) {
+        printf("%s: a grade compensa a partir de %d projéteis (THREAT_GRID_MIN_PROJECTILES = %d)\n",
+               BENCH_MODE, crossover, THREAT_GRID_MIN_PROJECTILES);
+    } else {
+        printf("%s: a lista ganhou em todas as quantidades (THREAT_GRID_MIN_PROJECTILES = %d)\n",
+               BENCH_MODE, THREAT_GRID_MIN_PROJECTILES);
+    }
+    if (mismatches > 0) printf("%s: %d consultas divergem da varredura\n", BENCH_MODE, mismatches);
+    return mismatches > 0;
+}
+
+// Tick dos ataques com n projéteis do tipo, todos em volta de um coração
+// parado no centro (os teleguiados ficam orbitando e não saem da tela)
+static double SteerTick(AttackManager *am, int n, AttackType type) {
+    SimVec2 target = { SIM(GAME_WIDTH / 2), SIM(GAME_HEIGHT / 2) };
+    unsigned int rng = RAND_DEFAULT_SEED;
+    Rectangle box = { 0, 0, GAME_WIDTH, GAME_HEIGHT };
+    double elapsed = 0;
+    int ticks = 0;
+
+    while (ticks < BENCH_STEER_TICKS) {
+        AttackManagerInit(am, box);
+        for (int t = 0; t <= ATK_COUNT; t++) am->streamStart[t] = t > (int)type ? n : 0;
+        for (int i = 0; i < n; i++) {
+            Projectile *p = &am->projectiles[i];
+            p->pos = (SimVec2){ SimFromInt(200 + RandNext(&rng) % 400), SimFromInt(150 + RandNext(&rng) % 300) };
+            p->vel = (SimVec2){ SimFromInt((int)(RandNext(&rng) % 5) - 2), SIM(1.5) };
+            p->timer = 1 << 30;
+        }
+        // Ticks sem disparo novo (frameCount fora do intervalo de spawn)
+        for (int frame = 1; frame < 40 && ticks < BENCH_STEER_TICKS; frame++, ticks++) {
+            double t0 = TimeNow();
+            AttackManagerUpdate(am, box, frame, LEVEL_VOID, MOVE_FREE, target);
+            elapsed += TimeNow() - t0;
+        }
+    }
+    return elapsed * 1e6 / ticks;
+}
+
+// Teleguiados x projéteis comuns: a diferença é o passo de direção em lote
+static int RunSteer(void) {
+    static AttackManager am;
+    static const int counts[] = { 256, 4096 };
+    for (unsigned int c = 0; c < sizeof(counts) / sizeof(counts[0]); c++) {
+        int n = counts[c];
+        if (n > MAX_PROJECTILES) {
+            printf("%s: %d projéteis não cabem em MAX_PROJECTILES = %d (use make simbench-big)\n",
+                   BENCH_MODE, n, MAX_PROJECTILES);
+            continue;
+        }
+        double plain = SteerTick(&am, n, ATK_MAGENTA);
+        double homing = SteerTick(&am, n, ATK_HOMING);
+        double lock = SteerTick(&am, n, ATK_LOCK);
+        printf("%s: %4d projéteis, tick %.2f us comuns, %.2f us teleguiados, %.2f us de trava\n",
+               BENCH_MODE, n, plain, homing, lock);
+    }
+    return 0;
+}
+
+// Enche o armazenamento de feixes girando e mede, por tick, o giro (seno e
+// cosseno uma vez por feixe) e a consulta de um coração contra todos eles
+static int RunLasers(void) {
+    static AttackManager am;
+    static ThreatGrid grid;
+    Rectangle box = { 0, 0, GAME_WIDTH, GAME_HEIGHT };
+    unsigned int rng = RAND_DEFAULT_SEED;
+    AttackManagerInit(&am, box);
+    for (int i = 0; i < MAX_ENTITIES; i++) {
+        BeamDesc beam = { {RandNext(&rng) % GAME_WIDTH, RandNext(&rng) % GAME_HEIGHT}, (RandNext(&rng) % 628) / 100.0f,
+                          0.01f + (RandNext(&rng) % 10) / 500.0f, -100, 200, 3, 0 };
+        SpawnLaser(&am, &beam, (Vector2){0, 0}, 10, 1 << 20);
+    }
+
+    double systemTime = 0, queryTime = 0;
+    int hits = 0;
+    for (int tick = 0; tick < BENCH_LASER_TICKS; tick++) {
+        double t0 = TimeNow();
+        EntityBeamSystem(&am.entities);
+        double t1 = TimeNow();
+        ThreatGridBuild(&grid, &am);
+        SimRect heart = { SimFromInt(RandNext(&rng) % GAME_WIDTH), SimFromInt(RandNext(&rng) % GAME_HEIGHT), SIM(9.6), SIM(9.6) };
+        double t2 = TimeNow();
+        ThreatQuery q = ThreatGridQuery(&grid, &heart, BENCH_GRAZE_RADIUS);
+        double t3 = TimeNow();
+        systemTime += t1 - t0;
+        queryTime += t3 - t2;
+        hits += q.hit;
+    }
+
+    double perBeam = 1e9 / ((double)BENCH_LASER_TICKS * am.entities.count);
+    printf("%s: %d feixes, giro %.1f ns e consulta %.1f ns por feixe (%d acertos em %d ticks)\n",
+           BENCH_MODE, am.entities.count, systemTime * perBeam, queryTime * perBeam, hits, BENCH_LASER_TICKS);
+    return 0;
+}
+
+// Luta inteira contra o chefe com o coração parado no centro e a vida
+// sempre cheia: mede o tick completo (emissores, movimento, grade e
+// colisão) e o pico de projéteis vivos em cada fase
+static int RunBoss(void) {
+    static Game g;
+    PlayerInput inputs[2] = {0};
+    GameInit(&g);
+    GameRestart(&g, LEVEL_BOSS);
+
+    double total = 0, worst = 0;
+    int ticks = 0, peak[BOSS_PHASES] = {0}, worstLive = 0;
+    long live = 0;
+    while (g.phase == PHASE_BOSS && g.running) {
+        g.player.hp = g.player.maxHp;
+        int phase = g.boss.phase;
+        double t0 = TimeNow();
+        GameTick(&g, inputs);
+        double elapsed = TimeNow() - t0;
+
+        int n = g.attacks.streamStart[ATK_COUNT];
+        total += elapsed;
+        live += n;
+        ticks++;
+        if (n > peak[phase]) peak[phase] = n;
+        if (elapsed > worst) {
+            worst = elapsed;
+            worstLive = n;
+        }
+    }
+
+    int maxLive = 0;
+    for (int p = 0; p < BOSS_PHASES; p++) {
+        printf("%s: chefe fase %d, pico de %d projéteis\n", BENCH_MODE, p + 1, peak[p]);
+        if (peak[p] > maxLive) maxLive = peak[p];
+    }
+    double budgetUs = BENCH_BOSS_BUDGET_FRACTION * 1e6 / 60.0;
+    printf("%s: chefe %d ticks, média %.1f us com %ld projéteis, pior %.1f us com %d (limite %.0f us)\n",
+           BENCH_MODE, ticks, total * 1e6 / ticks, live / ticks, worst * 1e6, worstLive, budgetUs);
+    if (maxLive < BENCH_BOSS_MIN_LIVE) printf("%s: o chefe não chegou a %d projéteis\n", BENCH_MODE, BENCH_BOSS_MIN_LIVE);
+    return maxLive >= BENCH_BOSS_MIN_LIVE && worst * 1e6 <= budgetUs ? 0 : 1;
+}
+
+// O jogador automático do menu até a vitória: ticks, mortes e vida perdida
+// por nível, tempo de decisão e quantas vezes mais rápido que o tempo real
+static int RunBot(void) {
+    static Game g;
+    static Bot bot;
+    GameInit(&g);
+    BotInit(&bot);
+
+    int ticks[LEVEL_COUNT] = {0}, deaths[LEVEL_COUNT] = {0}, hpLost[LEVEL_COUNT] = {0};
+    int total = 0, started = 0, wasDead = 0, hp = g.player.hp, late = 0;
+    double budgetUs = BENCH_BOT_BUDGET_FRACTION * 1e6 / 60.0;
+    double start = TimeNow();
+    while (total < BENCH_BOT_MAX_TICKS && !(started && g.phase == PHASE_WIN)) {
+        double decideStart = TimeNow();
+        GameInput in = BotReadInput(&bot, &g);
+        if ((TimeNow() - decideStart) * 1e6 > budgetUs) late++;
+        GameUpdate(&g, &in);
+        total++;
+        if (g.phase == PHASE_MENU) continue;
+        started = 1;
+
+        GameLevel level = g.currentLevel;
+        ticks[level]++;
+        if (g.player.hp < hp) hpLost[level] += hp - g.player.hp;
+        if (g.player.isDead && !wasDead) deaths[level]++;
+        hp = g.player.hp;
+        wasDead = g.player.isDead;
+    }
+    double elapsed = TimeNow() - start;
+
+    for (int level = 0; level < LEVEL_COUNT; level++) {
+        printf("%s: bot nível %d, %d ticks, %d mortes, %d de vida perdida\n",
+               BENCH_MODE, level + 1, ticks[level], deaths[level], hpLost[level]);
+    }
+    int won = g.phase == PHASE_WIN;
+    printf("%s: bot %s em %d ticks, %.1fx o tempo real, decisão média %.1f us, pior %.1f us (%.1f us de CPU, limite %.0f us), "
+           "%d fora do prazo, %ld cortadas no prazo\n",
+           BENCH_MODE, won ? "venceu" : "não venceu", total, total / 60.0 / elapsed, BotAvgUs(&bot), bot.maxUs, bot.maxCpuUs,
+           budgetUs, late, bot.cutoffs);
+    // Uma decisão só passa do prazo em tempo real se a thread perdeu a CPU
+    // no meio dela; o custo próprio (CPU) tem que caber sempre
+    return won && bot.maxCpuUs <= budgetUs && late <= BENCH_BOT_LATE_FRACTION * total ? 0 : 1;
+}
+
+int main(int argc, char **argv) {
+    int trace = argc > 1 && strcmp(argv[1], "--trace") == 0;
+    int usOnly = argc > 1 && strcmp(argv[1], "--us") == 0;
+    SetTraceLogLevel(LOG_WARNING);
+    if (argc > 1 && strcmp(argv[1], "--ghost") == 0) return RunGhost();
+    if (argc > 1 && strcmp(argv[1], "--graze") == 0) return RunGraze();
+    if (argc > 1 && strcmp(argv[1], "--steer") == 0) return RunSteer();
+    if (argc > 1 && strcmp(argv[1], "--lasers") == 0) return RunLasers();
+    if (argc > 1 && strcmp(argv[1], "--boss") == 0) return RunBoss();
+    if (argc > 1 && strcmp(argv[1], "--bot") == 0) return RunBot();
+
+    static Game game;
+    GameInit(&game);
+    game.coop = 1;
+
+    // Passada com hash (fora da medição)
+    long ticks = 0;
+    unsigned int chain = RunLevels(&game, 1, trace, &ticks);
+    if (trace) return 0;
+
+    // A melhor rodada: a máquina pode estar ocupada com outra coisa
+    ticks = 0;
+    double best = 0;
+    for (int round = 0; round < BENCH_ROUNDS; round++) {
+        long roundTicks = 0;
+        double start = TimeNow();
+        RunLevels(&game, 0, 0, &roundTicks);
+        double us = (TimeNow() - start) * 1e6 / roundTicks;
+        if (round == 0 || us < best) best = us;
+        ticks += roundTicks;
+    }
+
+    if (usOnly) printf("%.3f\n", best);
+    else printf("%s: %ld ticks, %.3f us/tick (melhor rodada), hash %08x\n", BENCH_MODE, ticks, best, chain);
+    return 0;
+}
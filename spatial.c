@@ -0,0 +1,206 @@
+#include "spatial.h"
+
+static int CellOf(sim_t v, int cells) {
+    int c = SimToInt(v) / THREAT_CELL;
+    if (c < 0) return 0;
+    if (c >= cells) return cells - 1;
+    return c;
+}
+
+static int CellIndex(const SimRect *r) {
+    return CellOf(r->y, THREAT_ROWS) * THREAT_COLS + CellOf(r->x, THREAT_COLS);
+}
+
+// Deslocamento e tamanho de cada fluxo, convertidos uma vez por montagem
+static void StreamShapes(SimRect shapes[ATK_COUNT]) {
+    for (int t = 0; t < ATK_COUNT; t++) {
+        const AttackTypeInfo *info = &attackTypeInfo[t];
+        shapes[t] = (SimRect){ SimFromFloat(info->offset.x), SimFromFloat(info->offset.y),
+                               SimFromFloat(info->width), SimFromFloat(info->height) };
+    }
+}
+
+static SimRect ProjectileRect(const Projectile *p, const SimRect *shape) {
+    return (SimRect){ p->pos.x + shape->x, p->pos.y + shape->y, shape->width, shape->height };
+}
+
+static int IsThreat(const EntityStore *es, int i) {
+    return (es->mask[i] & COMP_DAMAGE) && es->damage[i] > 0 && EntityIsSolid(es, i);
+}
+
+// Poucos projéteis: todas as ameaças (menos os feixes) numa lista só
+static void BuildList(ThreatGrid *grid, const AttackManager *am) {
+    const EntityStore *es = &am->entities;
+    SimRect shapes[ATK_COUNT];
+    StreamShapes(shapes);
+    grid->largeCount = grid->beamCount = 0;
+
+    int n = 0;
+    for (int t = 0; t < ATK_COUNT; t++) {
+        for (int i = am->streamStart[t]; i < am->streamStart[t + 1]; i++) {
+            grid->rect[n] = ProjectileRect(&am->projectiles[i], &shapes[t]);
+            grid->source[n++] = (unsigned char)t;
+        }
+    }
+    for (int i = 0; i < es->count; i++) {
+        if (!IsThreat(es, i)) continue;
+        if (es->mask[i] & COMP_BEAM) {
+            grid->beams[grid->beamCount++] = es->beam[i];
+            continue;
+        }
+        grid->rect[n] = es->rect[i];
+        grid->source[n++] = ATK_COUNT;
+    }
+    grid->count = n;
+}
+
+void ThreatGridBuild(ThreatGrid *grid, const AttackManager *am) {
+    ThreatGridBuildLayout(grid, am, THREAT_LAYOUT_AUTO);
+}
+
+void ThreatGridBuildLayout(ThreatGrid *grid, const AttackManager *am, ThreatLayout layout) {
+    if (layout == THREAT_LAYOUT_AUTO) {
+        layout = am->streamStart[ATK_COUNT] < THREAT_GRID_MIN_PROJECTILES ? THREAT_LAYOUT_LIST : THREAT_LAYOUT_GRID;
+    }
+    grid->layout = layout;
+    if (layout == THREAT_LAYOUT_LIST) {
+        BuildList(grid, am);
+        return;
+    }
+
+    const EntityStore *es = &am->entities;
+    SimRect shapes[ATK_COUNT];
+    StreamShapes(shapes);
+    for (int c = 0; c <= THREAT_CELLS; c++) grid->cellStart[c] = 0;
+    grid->largeCount = grid->beamCount = 0;
+
+    // Célula de cada ameaça e contagem por célula. Obstáculos maiores que
+    // uma célula vão direto para a lista large.
+    int n = 0;
+    for (int t = 0; t < ATK_COUNT; t++) {
+        for (int i = am->streamStart[t]; i < am->streamStart[t + 1]; i++) {
+            SimRect r = ProjectileRect(&am->projectiles[i], &shapes[t]);
+            int cell = CellIndex(&r);
+            grid->cellOf[n++] = (unsigned short)cell;
+            grid->cellStart[cell + 1]++;
+        }
+    }
+    for (int i = 0; i < es->count; i++) {
+        if (!IsThreat(es, i)) continue;
+        if (es->mask[i] & COMP_BEAM) {
+            grid->beams[grid->beamCount++] = es->beam[i];
+            continue;
+        }
+        const SimRect *r = &es->rect[i];
+        if (r->width > SIM(THREAT_CELL) || r->height > SIM(THREAT_CELL)) {
+            grid->large[grid->largeCount++] = *r;
+            continue;
+        }
+        int cell = CellIndex(r);
+        grid->cellOf[n++] = (unsigned short)cell;
+        grid->cellStart[cell + 1]++;
+    }
+    grid->count = n;
+
+    // Soma prefixada e cópia dos retângulos em ordem de célula
+    int cursor[THREAT_CELLS];
+    for (int c = 0; c < THREAT_CELLS; c++) {
+        cursor[c] = grid->cellStart[c];
+        grid->cellStart[c + 1] += grid->cellStart[c];
+    }
+    n = 0;
+    for (int t = 0; t < ATK_COUNT; t++) {
+        for (int i = am->streamStart[t]; i < am->streamStart[t + 1]; i++) {
+            int slot = cursor[grid->cellOf[n++]]++;
+            grid->rect[slot] = ProjectileRect(&am->projectiles[i], &shapes[t]);
+            grid->source[slot] = (unsigned char)t;
+        }
+    }
+    for (int i = 0; i < es->count; i++) {
+        const SimRect *r = &es->rect[i];
+        if (!IsThreat(es, i) || (es->mask[i] & COMP_BEAM) || r->width > SIM(THREAT_CELL) || r->height > SIM(THREAT_CELL)) continue;
+        int slot = cursor[grid->cellOf[n++]]++;
+        grid->rect[slot] = *r;
+        grid->source[slot] = ATK_COUNT;
+    }
+}
+
+// Folga entre a hitbox e um retângulo no eixo em que estão mais afastados:
+// negativa só quando se sobrepõem (nos dois eixos), zero quando encostam
+static sim_t Gap(const SimRect *a, const SimRect *b) {
+    sim_t dx = b->x - (a->x + a->width);
+    sim_t dxl = a->x - (b->x + b->width);
+    sim_t dy = b->y - (a->y + a->height);
+    sim_t dyt = a->y - (b->y + b->height);
+    if (dxl > dx) dx = dxl;
+    if (dyt > dy) dy = dyt;
+    return dx > dy ? dx : dy;
+}
+
+// Acumula a folga até uma ameaça; retorna 1 se acertou (a consulta acaba aí)
+static int Visit(ThreatQuery *q, sim_t gap, sim_t radius) {
+    if (gap < 0) {
+        q->hit = 1;
+        return 1;
+    }
+    if (gap <= radius && (!q->near || gap < q->gap)) {
+        q->near = 1;
+        q->gap = gap;
+    }
+    return 0;
+}
+
+// Varre as ameaças de rect[first .. last); retorna 1 se alguma acertou.
+// Em blocos de THREAT_SCAN_BLOCK o laço só guarda a menor folga, sem desvio
+// por ameaça; um bloco com folga negativa é percorrido de novo para achar o
+// primeiro acerto
+#define THREAT_SCAN_BLOCK 32
+static int VisitRange(ThreatQuery *q, const ThreatGrid *grid, int first, int last, const SimRect *hitbox, sim_t radius) {
+    for (int start = first; start < last; start += THREAT_SCAN_BLOCK) {
+        int end = start + THREAT_SCAN_BLOCK < last ? start + THREAT_SCAN_BLOCK : last;
+        sim_t nearest = Gap(hitbox, &grid->rect[start]);
+        for (int k = start + 1; k < end; k++) {
+            sim_t gap = Gap(hitbox, &grid->rect[k]);
+            nearest = gap < nearest ? gap : nearest;
+        }
+        if (nearest >= 0) {
+            Visit(q, nearest, radius);
+            continue;
+        }
+        int k = start;
+        while (Gap(hitbox, &grid->rect[k]) >= 0) k++;
+        q->hit = 1;
+        q->source = grid->source[k];
+        return 1;
+    }
+    return 0;
+}
+
+ThreatQuery ThreatGridQuery(const ThreatGrid *grid, const SimRect *hitbox, sim_t radius) {
+    ThreatQuery q = { 0, 0, 0, ATK_COUNT };
+
+    if (grid->layout == THREAT_LAYOUT_LIST) {
+        if (VisitRange(&q, grid, 0, grid->count, hitbox, radius)) return q;
+    } else {
+        // Hitbox aumentada pelo raio; uma ameaça que chega nela começa no
+        // máximo THREAT_CELL antes (nenhuma é maior que isso)
+        sim_t left = hitbox->x - radius, top = hitbox->y - radius;
+        int c0 = CellOf(left - SIM(THREAT_CELL), THREAT_COLS);
+        int c1 = CellOf(hitbox->x + hitbox->width + radius, THREAT_COLS);
+        int r0 = CellOf(top - SIM(THREAT_CELL), THREAT_ROWS);
+        int r1 = CellOf(hitbox->y + hitbox->height + radius, THREAT_ROWS);
+        for (int r = r0; r <= r1; r++) {
+            // As células de uma linha são contíguas em rect
+            int first = grid->cellStart[r * THREAT_COLS + c0];
+            int last = grid->cellStart[r * THREAT_COLS + c1 + 1];
+            if (VisitRange(&q, grid, first, last, hitbox, radius)) return q;
+        }
+    }
+    for (int k = 0; k < grid->largeCount; k++) {
+        if (Visit(&q, Gap(hitbox, &grid->large[k]), radius)) return q;
+    }
+    for (int k = 0; k < grid->beamCount; k++) {
+        if (Visit(&q, SimBeamGap(&grid->beams[k], hitbox), radius)) return q;
+    }
+    return q;
+}
@@ -0,0 +1,68 @@
+#ifndef SPATIAL_H
+#define SPATIAL_H
+#include "attack.h"
+#include "fixed.h"
+
+// Grade uniforme das ameaças (projéteis e obstáculos que ferem), refeita a
+// cada tick depois que os ataques se movem. Uma consulta responde ao mesmo
+// tempo se a hitbox foi atingida e a que distância está a ameaça mais
+// próxima, olhando só as células em volta do coração.
+//
+// Cada ameaça entra numa célula só, a do canto superior esquerdo, e as
+// ameaças ficam copiadas em ordem de célula (counting sort): as da célula c
+// estão em rect[cellStart[c] .. cellStart[c+1]). Como nenhuma passa de
+// THREAT_CELL, a consulta só precisa olhar uma célula a mais para a
+// esquerda e para cima. Obstáculos maiores vão para a lista large e os
+// feixes de laser para a lista beams (teste orientado), ambas testadas em
+// toda consulta.
+//
+// O jogo faz só uma ou duas consultas por tick, então a grade precisa que a
+// montagem saia mais barata que varrer tudo. Abaixo de
+// THREAT_GRID_MIN_PROJECTILES as ameaças ficam só numa lista em ordem de
+// fluxo e a consulta olha todas. Com corações sempre num vão (./simbench
+// --graze) a grade só passa a lista no ponto fixo, a partir de 128 a 256
+// projéteis; na partida de verdade, em que a consulta para no primeiro
+// acerto, a lista ganhou nos dois modos até no chefe (./simbench --boss:
+// 5,8 x 10,0 us por tick no float, 5,1-7,7 x 13,5 no ponto fixo). Por isso o
+// limite fica acima do pool: a grade sobra para quem compilar com
+// -DTHREAT_GRID_MIN_PROJECTILES=N e para as medições.
+#define THREAT_CELL 40
+#define THREAT_COLS ((GAME_WIDTH + THREAT_CELL - 1) / THREAT_CELL)
+#define THREAT_ROWS ((GAME_HEIGHT + THREAT_CELL - 1) / THREAT_CELL)
+#define THREAT_CELLS (THREAT_COLS * THREAT_ROWS)
+#define THREAT_MAX (MAX_PROJECTILES + MAX_ENTITIES)
+#ifndef THREAT_GRID_MIN_PROJECTILES
+#define THREAT_GRID_MIN_PROJECTILES (MAX_PROJECTILES + 1)
+#endif
+
+typedef enum {
+    THREAT_LAYOUT_AUTO,         // Pela quantidade de projéteis
+    THREAT_LAYOUT_LIST,         // Varredura de tudo
+    THREAT_LAYOUT_GRID          // Células
+} ThreatLayout;
+
+typedef struct {
+    ThreatLayout layout;                    // LIST ou GRID (a montagem resolve o AUTO)
+    int count;
+    int cellStart[THREAT_CELLS + 1];
+    SimRect rect[THREAT_MAX];               // Em ordem de célula (ou de fluxo, na lista)
+    unsigned char source[THREAT_MAX];       // AttackType de cada rect (ATK_COUNT = obstáculo)
+    int largeCount;
+    SimRect large[MAX_ENTITIES];
+    int beamCount;
+    SimBeam beams[MAX_ENTITIES];
+    unsigned short cellOf[THREAT_MAX];      // Rascunho da montagem
+} ThreatGrid;
+
+typedef struct {
+    int hit;            // A hitbox encosta (estritamente) em alguma ameaça
+    int near;           // Alguma ameaça a até radius da hitbox (sem acertar)
+    sim_t gap;          // Folga até a mais próxima (maior eixo; válida se near)
+    int source;         // O que acertou (válido se hit): AttackType, ou ATK_COUNT para obstáculos e lasers
+} ThreatQuery;
+
+void ThreatGridBuild(ThreatGrid *grid, const AttackManager *am);
+void ThreatGridBuildLayout(ThreatGrid *grid, const AttackManager *am, ThreatLayout layout);
+ThreatQuery ThreatGridQuery(const ThreatGrid *grid, const SimRect *hitbox, sim_t radius);
+
+#endif
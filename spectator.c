@@ -0,0 +1,736 @@
+#define _POSIX_C_SOURCE 200809L
+#include "spectator.h"
+#include "utils.h"
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <unistd.h>
+#include <netdb.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+
+// Quantização
+#define POS_SCALE 8.0f          // Posições e tamanhos em 1/8 de pixel
+#define VEL_SCALE 64.0f
+#define FADE_SCALE 255.0f
+#define EFFECT_SCALE 1000.0f
+#define SNAP_DISTANCE 64.0f     // Saltos maiores que isso não são interpolados
+
+// Disposição dos campos: cabeçalho, corações, entidades e projéteis (os de
+// tamanho variável no fim, para que mudar a contagem desloque pouca coisa)
+enum {
+    H_PHASE, H_LEVEL, H_PROGRESS, H_FRAME, H_SCORE, H_RUNNING, H_COOP,
+    H_BOX_X, H_BOX_Y, H_BOX_W, H_BOX_H, H_BG_TOP, H_BG_BOTTOM, H_EFFECT,
+    H_HUD_FRAMES, H_BOSS_ACTIVE, H_BOSS_X, H_BOSS_Y, H_BOSS_HP, H_BOSS_PHASE, H_BOSS_FLASH, H_BOSS_EMITTERS,
+    H_ENTITIES, H_STREAMS,                      // ATK_COUNT contagens a partir daqui
+    H_EMITTERS_AT = H_STREAMS + ATK_COUNT,      // x, y de BOSS_MAX_EMITTERS emissores
+    HEADER_FIELDS = H_EMITTERS_AT + 2 * BOSS_MAX_EMITTERS
+};
+enum { P_X, P_Y, P_SIZE, P_HP, P_MAX_HP, P_INVUL_FRAMES, P_FLAGS, P_GRAZE_COUNT, P_GRAZE_FLASH, HEART_FIELDS };
+enum { E_X, E_Y, E_W, E_H, E_VX, E_VY, E_LOOK, E_FLAGS, E_FADE, E_BEAM_X0, E_BEAM_Y0, E_BEAM_X1, E_BEAM_Y1, E_BEAM_W, ENTITY_FIELDS };
+
+#define HEARTS_AT HEADER_FIELDS
+#define ENTITIES_AT (HEARTS_AT + 2 * HEART_FIELDS)
+#define MAX_FIELDS (ENTITIES_AT + ENTITY_FIELDS * MAX_ENTITIES + 2 * MAX_PROJECTILES)
+#define MAX_PACKET (4 + 8 + 5 + 1 + 1 + HUD_MSG_MAX + (MAX_FIELDS + 7) / 8 + 5 * MAX_FIELDS)
+
+typedef struct {
+    unsigned int seq;
+    int fieldCount;
+    char hudMsg[HUD_MSG_MAX];
+    int fields[MAX_FIELDS];
+} SpectatorState;
+
+typedef struct {
+    int fd;                         // -1 = livre
+    unsigned int acked;             // SPECTATOR_NO_BASE até a primeira confirmação
+    unsigned char ackBuf[4];
+    int ackBytes;
+    unsigned char out[MAX_PACKET];  // Pacote em envio (só um por vez)
+    int outSize, outSent;
+} SpectatorClient;
+
+// Servidor: a thread principal só mexe na caixa de correio
+static pthread_mutex_t mailboxLock = PTHREAD_MUTEX_INITIALIZER;
+static FramePacket mailbox;
+static int mailboxFull = 0;
+static long mailboxSkipped = 0;
+static int wakePipe[2] = { -1, -1 };
+
+static pthread_t thread;
+static int serverRunning = 0;
+static atomic_int stopping;
+static int listenFd = -1;
+static SpectatorClient clients[SPECTATOR_MAX_CLIENTS];
+static SpectatorState history[SPECTATOR_HISTORY];
+static unsigned int serverSeq = 0;
+static FramePacket working;
+
+static pthread_mutex_t statsLock = PTHREAD_MUTEX_INITIALIZER;
+static SpectatorStats stats;
+static long statsBytes = 0;
+static double statsEncodeSeconds = 0.0;
+
+// Cliente
+static int clientFd = -1;
+static unsigned char recvBuf[MAX_PACKET];
+static int recvBytes = 0;
+static SpectatorState received[SPECTATOR_HISTORY];
+static SpectatorState decoding;
+static FramePacket previous, current;
+static int framesReceived = 0;
+static double currentTime = 0.0;
+
+static int Quant(float v, float scale) {
+    return (int)lroundf(v * scale);
+}
+
+static int PackColor(Color c) {
+    return (int)((unsigned int)c.r | (unsigned int)c.g << 8 | (unsigned int)c.b << 16 | (unsigned int)c.a << 24);
+}
+
+static Color UnpackColor(int v) {
+    unsigned int u = (unsigned int)v;
+    return (Color){ u & 0xFF, (u >> 8) & 0xFF, (u >> 16) & 0xFF, u >> 24 };
+}
+
+static void Quantize(const FramePacket *f, SpectatorState *s) {
+    int *q = s->fields;
+    q[H_PHASE] = f->phase;
+    q[H_LEVEL] = f->currentLevel;
+    q[H_PROGRESS] = f->levelProgress;
+    q[H_FRAME] = f->frameCount;
+    q[H_SCORE] = f->score;
+    q[H_RUNNING] = f->running;
+    q[H_COOP] = f->coop;
+    q[H_BOX_X] = Quant(f->battleBox.x, POS_SCALE);
+    q[H_BOX_Y] = Quant(f->battleBox.y, POS_SCALE);
+    q[H_BOX_W] = Quant(f->battleBox.width, POS_SCALE);
+    q[H_BOX_H] = Quant(f->battleBox.height, POS_SCALE);
+    q[H_BG_TOP] = PackColor(f->bgColorTop);
+    q[H_BG_BOTTOM] = PackColor(f->bgColorBottom);
+    q[H_EFFECT] = Quant(f->effectIntensity, EFFECT_SCALE);
+    q[H_HUD_FRAMES] = f->hudMsgFrames;
+    q[H_ENTITIES] = f->attacks.entityCount;
+    for (int t = 0; t < ATK_COUNT; t++) q[H_STREAMS + t] = f->attacks.streamStart[t + 1] - f->attacks.streamStart[t];
+
+    // Chefe: bloco fixo (zerado fora do chefe, então não custa nada)
+    q[H_BOSS_ACTIVE] = f->boss.active;
+    q[H_BOSS_X] = Quant(f->boss.pos.x, POS_SCALE);
+    q[H_BOSS_Y] = Quant(f->boss.pos.y, POS_SCALE);
+    q[H_BOSS_HP] = f->boss.hp;
+    q[H_BOSS_PHASE] = f->boss.phase;
+    q[H_BOSS_FLASH] = f->boss.hurtFlash;
+    q[H_BOSS_EMITTERS] = f->boss.emitterCount;
+    for (int i = 0; i < BOSS_MAX_EMITTERS; i++) {
+        Vector2 e = i < f->boss.emitterCount ? f->boss.emitters[i] : (Vector2){0, 0};
+        q[H_EMITTERS_AT + 2 * i] = Quant(e.x, POS_SCALE);
+        q[H_EMITTERS_AT + 2 * i + 1] = Quant(e.y, POS_SCALE);
+    }
+
+    const Player *hearts[2] = { &f->player, &f->partner };
+    for (int i = 0; i < 2; i++) {
+        const Player *p = hearts[i];
+        int *h = q + HEARTS_AT + i * HEART_FIELDS;
+        h[P_X] = Quant(SimToFloat(p->pos.x), POS_SCALE);
+        h[P_Y] = Quant(SimToFloat(p->pos.y), POS_SCALE);
+        h[P_SIZE] = Quant(SimToFloat(p->size), POS_SCALE);
+        h[P_HP] = p->hp;
+        h[P_MAX_HP] = p->maxHp;
+        h[P_INVUL_FRAMES] = p->invulFrames;
+        h[P_FLAGS] = p->isDead | p->invulnerable << 1 | p->slot << 2;
+        h[P_GRAZE_COUNT] = p->grazeCount;
+        h[P_GRAZE_FLASH] = p->grazeFlash;
+    }
+
+    int n = ENTITIES_AT;
+    for (int i = 0; i < f->attacks.entityCount; i++) {
+        const EntityDrawItem *e = &f->attacks.entities[i];
+        q[n + E_X] = Quant(e->rect.x, POS_SCALE);
+        q[n + E_Y] = Quant(e->rect.y, POS_SCALE);
+        q[n + E_W] = Quant(e->rect.width, POS_SCALE);
+        q[n + E_H] = Quant(e->rect.height, POS_SCALE);
+        q[n + E_VX] = Quant(e->velocity.x, VEL_SCALE);
+        q[n + E_VY] = Quant(e->velocity.y, VEL_SCALE);
+        q[n + E_LOOK] = e->look;
+        q[n + E_FLAGS] = e->platform | e->moving << 1 | e->expiring << 2 | e->beam << 3 | e->warning << 4;
+        q[n + E_FADE] = Quant(e->fade, FADE_SCALE);
+        q[n + E_BEAM_X0] = Quant(e->beamFrom.x, POS_SCALE);
+        q[n + E_BEAM_Y0] = Quant(e->beamFrom.y, POS_SCALE);
+        q[n + E_BEAM_X1] = Quant(e->beamTo.x, POS_SCALE);
+        q[n + E_BEAM_Y1] = Quant(e->beamTo.y, POS_SCALE);
+        q[n + E_BEAM_W] = Quant(e->beamHalfWidth, POS_SCALE);
+        n += ENTITY_FIELDS;
+    }
+    for (int i = 0; i < f->attacks.streamStart[ATK_COUNT]; i++) {
+        q[n++] = Quant(f->attacks.positions[i].x, POS_SCALE);
+        q[n++] = Quant(f->attacks.positions[i].y, POS_SCALE);
+    }
+    s->fieldCount = n;
+    memcpy(s->hudMsg, f->hudMsg, HUD_MSG_MAX);
+}
+
+// Confere as contagens e os índices de um estado recebido antes de usá-lo
+// (o servidor aceita qualquer um na rede local)
+static int StateValid(const SpectatorState *s) {
+    if (s->fieldCount < ENTITIES_AT) return 0;
+    const int *q = s->fields;
+    // Nível e fase indexam tabelas do desenho (nomes dos níveis no HUD)
+    if (q[H_LEVEL] < 0 || q[H_LEVEL] >= LEVEL_COUNT) return 0;
+    if (q[H_PHASE] < PHASE_MENU || q[H_PHASE] > PHASE_TRANSITION) return 0;
+    if (q[H_ENTITIES] < 0 || q[H_ENTITIES] > MAX_ENTITIES) return 0;
+    if (q[H_BOSS_EMITTERS] < 0 || q[H_BOSS_EMITTERS] > BOSS_MAX_EMITTERS) return 0;
+    if (q[H_BOSS_PHASE] < 0 || q[H_BOSS_PHASE] >= BOSS_PHASES) return 0;
+    int projectiles = 0;
+    for (int t = 0; t < ATK_COUNT; t++) {
+        if (q[H_STREAMS + t] < 0) return 0;
+        projectiles += q[H_STREAMS + t];
+    }
+    return projectiles <= MAX_PROJECTILES &&
+           s->fieldCount == ENTITIES_AT + ENTITY_FIELDS * q[H_ENTITIES] + 2 * projectiles;
+}
+
+// Só o que GameDraw e HUDDraw leem; o resto do pacote fica zerado
+static void Dequantize(const SpectatorState *s, FramePacket *f) {
+    const int *q = s->fields;
+    memset(f, 0, sizeof(*f));
+    f->phase = q[H_PHASE];
+    f->currentLevel = q[H_LEVEL];
+    f->levelProgress = q[H_PROGRESS] < 0 ? 0 : q[H_PROGRESS] > 100 ? 100 : q[H_PROGRESS];
+    f->frameCount = q[H_FRAME];
+    f->score = q[H_SCORE];
+    f->running = q[H_RUNNING];
+    f->coop = q[H_COOP];
+    f->battleBox = (Rectangle){ q[H_BOX_X] / POS_SCALE, q[H_BOX_Y] / POS_SCALE, q[H_BOX_W] / POS_SCALE, q[H_BOX_H] / POS_SCALE };
+    f->bgColorTop = UnpackColor(q[H_BG_TOP]);
+    f->bgColorBottom = UnpackColor(q[H_BG_BOTTOM]);
+    f->effectIntensity = q[H_EFFECT] / EFFECT_SCALE;
+    f->hudMsgFrames = q[H_HUD_FRAMES];
+    memcpy(f->hudMsg, s->hudMsg, HUD_MSG_MAX);
+
+    f->boss.active = q[H_BOSS_ACTIVE];
+    f->boss.pos = (Vector2){ q[H_BOSS_X] / POS_SCALE, q[H_BOSS_Y] / POS_SCALE };
+    f->boss.hp = q[H_BOSS_HP];
+    f->boss.phase = q[H_BOSS_PHASE];
+    f->boss.hurtFlash = q[H_BOSS_FLASH];
+    f->boss.emitterCount = q[H_BOSS_EMITTERS];
+    for (int i = 0; i < f->boss.emitterCount; i++) {
+        f->boss.emitters[i] = (Vector2){ q[H_EMITTERS_AT + 2 * i] / POS_SCALE, q[H_EMITTERS_AT + 2 * i + 1] / POS_SCALE };
+    }
+
+    Player *hearts[2] = { &f->player, &f->partner };
+    for (int i = 0; i < 2; i++) {
+        Player *p = hearts[i];
+        const int *h = q + HEARTS_AT + i * HEART_FIELDS;
+        p->pos = (SimVec2){ SimFromFloat(h[P_X] / POS_SCALE), SimFromFloat(h[P_Y] / POS_SCALE) };
+        p->size = SimFromFloat(h[P_SIZE] / POS_SCALE);
+        p->hp = h[P_HP];
+        p->maxHp = h[P_MAX_HP];
+        p->invulFrames = h[P_INVUL_FRAMES];
+        p->isDead = h[P_FLAGS] & 1;
+        p->invulnerable = (h[P_FLAGS] >> 1) & 1;
+        p->slot = (h[P_FLAGS] >> 2) & 1;
+        p->grazeCount = h[P_GRAZE_COUNT];
+        p->grazeFlash = h[P_GRAZE_FLASH];
+    }
+
+    AttackDrawState *ds = &f->attacks;
+    int n = ENTITIES_AT;
+    ds->entityCount = q[H_ENTITIES];
+    for (int i = 0; i < ds->entityCount; i++) {
+        EntityDrawItem *e = &ds->entities[i];
+        e->rect = (Rectangle){ q[n + E_X] / POS_SCALE, q[n + E_Y] / POS_SCALE, q[n + E_W] / POS_SCALE, q[n + E_H] / POS_SCALE };
+        e->velocity = (Vector2){ q[n + E_VX] / VEL_SCALE, q[n + E_VY] / VEL_SCALE };
+        e->look = q[n + E_LOOK];
+        e->platform = q[n + E_FLAGS] & 1;
+        e->moving = (q[n + E_FLAGS] >> 1) & 1;
+        e->expiring = (q[n + E_FLAGS] >> 2) & 1;
+        e->beam = (q[n + E_FLAGS] >> 3) & 1;
+        e->warning = (q[n + E_FLAGS] >> 4) & 1;
+        e->fade = q[n + E_FADE] / FADE_SCALE;
+        e->beamFrom = (Vector2){ q[n + E_BEAM_X0] / POS_SCALE, q[n + E_BEAM_Y0] / POS_SCALE };
+        e->beamTo = (Vector2){ q[n + E_BEAM_X1] / POS_SCALE, q[n + E_BEAM_Y1] / POS_SCALE };
+        e->beamHalfWidth = q[n + E_BEAM_W] / POS_SCALE;
+        n += ENTITY_FIELDS;
+    }
+    ds->streamStart[0] = 0;
+    for (int t = 0; t < ATK_COUNT; t++) ds->streamStart[t + 1] = ds->streamStart[t] + q[H_STREAMS + t];
+    for (int i = 0; i < ds->streamStart[ATK_COUNT]; i++) {
+        ds->positions[i] = (Vector2){ q[n] / POS_SCALE, q[n + 1] / POS_SCALE };
+        n += 2;
+    }
+}
+
+static unsigned char *PutVarint(unsigned char *p, unsigned int v) {
+    while (v >= 0x80) {
+        *p++ = (unsigned char)(v | 0x80);
+        v >>= 7;
+    }
+    *p++ = (unsigned char)v;
+    return p;
+}
+
+static const unsigned char *GetVarint(const unsigned char *p, const unsigned char *end, unsigned int *v) {
+    unsigned int value = 0;
+    for (int shift = 0; p < end && shift < 35; shift += 7) {
+        unsigned char b = *p++;
+        value |= (unsigned int)(b & 0x7F) << shift;
+        if (!(b & 0x80)) {
+            *v = value;
+            return p;
+        }
+    }
+    return NULL;
+}
+
+// Diferenças pequenas (positivas ou negativas) viram poucos bytes
+static unsigned int ZigZag(int v) {
+    return ((unsigned int)v << 1) ^ (unsigned int)(v >> 31);
+}
+
+static int UnZigZag(unsigned int v) {
+    return (int)(v >> 1) ^ -(int)(v & 1);
+}
+
+static int BaseField(const SpectatorState *base, int i) {
+    return base && i < base->fieldCount ? base->fields[i] : 0;
+}
+
+// Pacote de s em relação a base (NULL = estado inteiro); retorna o tamanho
+static int Encode(const SpectatorState *s, const SpectatorState *base, unsigned char *out) {
+    unsigned char *p = out + 4;
+    unsigned int baseSeq = base ? base->seq : SPECTATOR_NO_BASE;
+    memcpy(p, &s->seq, 4);
+    memcpy(p + 4, &baseSeq, 4);
+    p = PutVarint(p + 8, (unsigned int)s->fieldCount);
+
+    int hud = !base || strcmp(s->hudMsg, base->hudMsg) != 0;
+    *p++ = (unsigned char)hud;
+    if (hud) {
+        size_t len = strnlen(s->hudMsg, HUD_MSG_MAX - 1);
+        *p++ = (unsigned char)len;
+        memcpy(p, s->hudMsg, len);
+        p += len;
+    }
+
+    unsigned char *mask = p;
+    int maskBytes = (s->fieldCount + 7) / 8;
+    memset(mask, 0, maskBytes);
+    p += maskBytes;
+    for (int i = 0; i < s->fieldCount; i++) {
+        int diff = (int)((unsigned int)s->fields[i] - (unsigned int)BaseField(base, i));
+        if (diff == 0) continue;
+        mask[i >> 3] |= (unsigned char)(1 << (i & 7));
+        p = PutVarint(p, ZigZag(diff));
+    }
+
+    unsigned int length = (unsigned int)(p - out - 4);
+    memcpy(out, &length, 4);
+    return (int)(p - out);
+}
+
+// Aplica um pacote (sem o tamanho) sobre a base que ele referencia
+static int Decode(const unsigned char *data, int size, SpectatorState *s) {
+    const unsigned char *p = data, *end = data + size;
+    if (size < 8) return 0;
+    unsigned int seq, baseSeq, count;
+    memcpy(&seq, p, 4);
+    memcpy(&baseSeq, p + 4, 4);
+    p += 8;
+
+    const SpectatorState *base = NULL;
+    if (baseSeq != SPECTATOR_NO_BASE) {
+        base = &received[baseSeq & (SPECTATOR_HISTORY - 1)];
+        if (base->seq != baseSeq || seq - baseSeq >= SPECTATOR_HISTORY) return 0;
+    }
+
+    p = GetVarint(p, end, &count);
+    if (!p || count > MAX_FIELDS || p >= end) return 0;
+    if (*p++) {
+        if (p >= end) return 0;
+        int len = *p++;
+        if (len >= HUD_MSG_MAX || end - p < len) return 0;
+        memcpy(s->hudMsg, p, len);
+        s->hudMsg[len] = '\0';
+        p += len;
+    } else {
+        if (!base) return 0;
+        memcpy(s->hudMsg, base->hudMsg, HUD_MSG_MAX);
+    }
+
+    int maskBytes = (count + 7) / 8;
+    if (end - p < maskBytes) return 0;
+    const unsigned char *mask = p;
+    p += maskBytes;
+    for (unsigned int i = 0; i < count; i++) {
+        int value = BaseField(base, i);
+        if (mask[i >> 3] & (1 << (i & 7))) {
+            unsigned int v;
+            if (!(p = GetVarint(p, end, &v))) return 0;
+            value = (int)((unsigned int)value + (unsigned int)UnZigZag(v));
+        }
+        s->fields[i] = value;
+    }
+    s->fieldCount = count;
+    s->seq = seq;
+    return p == end && StateValid(s);
+}
+
+// ---------------------------------------------------------------------------
+// Servidor
+
+static void CloseClient(SpectatorClient *c) {
+    close(c->fd);
+    c->fd = -1;
+}
+
+static void Flush(SpectatorClient *c) {
+    while (c->outSent < c->outSize) {
+        ssize_t sent = send(c->fd, c->out + c->outSent, c->outSize - c->outSent, MSG_NOSIGNAL | MSG_DONTWAIT);
+        if (sent < 0) {
+            if (errno != EAGAIN && errno != EWOULDBLOCK) CloseClient(c);
+            return;
+        }
+        c->outSent += sent;
+    }
+    c->outSize = c->outSent = 0;
+}
+
+static void ReadAcks(SpectatorClient *c) {
+    unsigned char buffer[256];
+    ssize_t got = recv(c->fd, buffer, sizeof(buffer), MSG_DONTWAIT);
+    if (got == 0 || (got < 0 && errno != EAGAIN && errno != EWOULDBLOCK)) {
+        CloseClient(c);
+        return;
+    }
+    for (ssize_t i = 0; i < got; i++) {
+        c->ackBuf[c->ackBytes++] = buffer[i];
+        if (c->ackBytes < 4) continue;
+        unsigned int ack;
+        memcpy(&ack, c->ackBuf, 4);
+        c->ackBytes = 0;
+        if (c->acked == SPECTATOR_NO_BASE || (int)(ack - c->acked) > 0) c->acked = ack;
+    }
+}
+
+static void AcceptClients(void) {
+    int fd;
+    while ((fd = accept(listenFd, NULL, NULL)) >= 0) {
+        int slot = -1;
+        for (int i = 0; i < SPECTATOR_MAX_CLIENTS && slot < 0; i++) {
+            if (clients[i].fd < 0) slot = i;
+        }
+        if (slot < 0) {
+            close(fd);
+            continue;
+        }
+        int one = 1;
+        setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+        fcntl(fd, F_SETFL, fcntl(fd, F_GETFL, 0) | O_NONBLOCK);
+        SpectatorClient *c = &clients[slot];
+        c->fd = fd;
+        c->acked = SPECTATOR_NO_BASE;
+        c->ackBytes = 0;
+        c->outSize = c->outSent = 0;
+        TraceLog(LOG_INFO, "SPECTATOR: espectador conectado (%d)", slot);
+    }
+}
+
+// Um tick publicado: quantiza uma vez e codifica para cada cliente livre.
+// Quem ainda está enviando o pacote anterior pula este tick; o próximo
+// delta sai em relação ao último estado que ele confirmou.
+static void EncodeTick(void) {
+    double start = TimeNow();
+    SpectatorState *s = &history[++serverSeq & (SPECTATOR_HISTORY - 1)];
+    Quantize(&working, s);
+    s->seq = serverSeq;
+
+    long bytes = 0;
+    int packets = 0, full = 0, connected = 0;
+    for (int i = 0; i < SPECTATOR_MAX_CLIENTS; i++) {
+        SpectatorClient *c = &clients[i];
+        if (c->fd < 0) continue;
+        connected++;
+        if (c->outSize > 0) continue;
+
+        const SpectatorState *base = NULL;
+        if (c->acked != SPECTATOR_NO_BASE && serverSeq - c->acked < SPECTATOR_HISTORY &&
+            history[c->acked & (SPECTATOR_HISTORY - 1)].seq == c->acked) {
+            base = &history[c->acked & (SPECTATOR_HISTORY - 1)];
+        }
+        c->outSize = Encode(s, base, c->out);
+        c->outSent = 0;
+        bytes += c->outSize;
+        packets++;
+        full += !base;
+        Flush(c);
+    }
+
+    pthread_mutex_lock(&statsLock);
+    stats.ticks++;
+    stats.packets += packets;
+    stats.fullStates += full;
+    stats.clients = connected;
+    statsBytes += bytes;
+    statsEncodeSeconds += TimeNow() - start;
+    pthread_mutex_unlock(&statsLock);
+}
+
+static void *SpectatorThread(void *arg) {
+    (void)arg;
+    while (!atomic_load(&stopping)) {
+        struct pollfd fds[2 + SPECTATOR_MAX_CLIENTS];
+        SpectatorClient *owner[2 + SPECTATOR_MAX_CLIENTS];
+        int n = 0;
+        fds[n++] = (struct pollfd){ wakePipe[0], POLLIN, 0 };
+        fds[n++] = (struct pollfd){ listenFd, POLLIN, 0 };
+        for (int i = 0; i < SPECTATOR_MAX_CLIENTS; i++) {
+            if (clients[i].fd < 0) continue;
+            owner[n] = &clients[i];
+            fds[n++] = (struct pollfd){ clients[i].fd, POLLIN | (clients[i].outSize > 0 ? POLLOUT : 0), 0 };
+        }
+        // Timeout curto só para perceber o SpectatorStop
+        if (poll(fds, n, 100) <= 0) continue;
+
+        for (int i = 2; i < n; i++) {
+            if (fds[i].revents & (POLLIN | POLLHUP | POLLERR)) ReadAcks(owner[i]);
+            if (owner[i]->fd >= 0 && (fds[i].revents & POLLOUT)) Flush(owner[i]);
+        }
+        if (fds[1].revents & POLLIN) AcceptClients();
+
+        if (fds[0].revents & POLLIN) {
+            char drain[64];
+            while (read(wakePipe[0], drain, sizeof(drain)) > 0) {}
+
+            pthread_mutex_lock(&mailboxLock);
+            int ready = mailboxFull;
+            if (ready) memcpy(&working, &mailbox, sizeof(working));
+            mailboxFull = 0;
+            pthread_mutex_unlock(&mailboxLock);
+            if (ready) EncodeTick();
+        }
+    }
+    return NULL;
+}
+
+int SpectatorStart(int port) {
+    listenFd = socket(AF_INET, SOCK_STREAM, 0);
+    if (listenFd < 0) return 0;
+
+    // Aberto para a rede local: o telão costuma ser outra máquina
+    int one = 1;
+    setsockopt(listenFd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+    struct sockaddr_in addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons((unsigned short)port);
+    addr.sin_addr.s_addr = htonl(INADDR_ANY);
+    if (bind(listenFd, (struct sockaddr *)&addr, sizeof(addr)) < 0 || listen(listenFd, 8) < 0 || pipe(wakePipe) < 0) {
+        TraceLog(LOG_WARNING, "SPECTATOR: porta %d indisponível", port);
+        close(listenFd);
+        listenFd = -1;
+        return 0;
+    }
+    fcntl(listenFd, F_SETFL, fcntl(listenFd, F_GETFL, 0) | O_NONBLOCK);
+    for (int i = 0; i < 2; i++) fcntl(wakePipe[i], F_SETFL, fcntl(wakePipe[i], F_GETFL, 0) | O_NONBLOCK);
+
+    for (int i = 0; i < SPECTATOR_MAX_CLIENTS; i++) clients[i].fd = -1;
+    memset(&stats, 0, sizeof(stats));
+    atomic_store(&stopping, 0);
+    if (pthread_create(&thread, NULL, SpectatorThread, NULL) != 0) {
+        close(listenFd);
+        listenFd = -1;
+        return 0;
+    }
+    serverRunning = 1;
+    TraceLog(LOG_INFO, "SPECTATOR: transmitindo na porta %d", port);
+    return 1;
+}
+
+void SpectatorPublish(const FramePacket *f) {
+    if (!serverRunning) return;
+
+    // Se a thread está copiando o pacote anterior, este tick fica de fora
+    if (pthread_mutex_trylock(&mailboxLock) != 0) {
+        mailboxSkipped++;
+        return;
+    }
+    if (mailboxFull) mailboxSkipped++;     // O anterior nem chegou a ser codificado
+    memcpy(&mailbox, f, sizeof(mailbox));
+    mailboxFull = 1;
+    pthread_mutex_unlock(&mailboxLock);
+
+    char wake = 1;
+    if (write(wakePipe[1], &wake, 1) < 0) {}   // Pipe cheio: a thread já vai acordar
+}
+
+void SpectatorGetStats(SpectatorStats *s) {
+    pthread_mutex_lock(&statsLock);
+    *s = stats;
+    s->bytesPerTick = stats.ticks ? (double)statsBytes / stats.ticks : 0.0;
+    s->bytesPerPacket = stats.packets ? (double)statsBytes / stats.packets : 0.0;
+    s->encodeUs = stats.ticks ? statsEncodeSeconds * 1e6 / stats.ticks : 0.0;
+    pthread_mutex_unlock(&statsLock);
+    s->skipped = mailboxSkipped;
+}
+
+void SpectatorDrawStats(const SpectatorStats *s) {
+    DrawText(TextFormat("SPECTATOR %d clientes  %.0f B/tick (%.0f B/pacote, %ld inteiros)  codificação %.1f us",
+                        s->clients, s->bytesPerTick, s->bytesPerPacket, s->fullStates, s->encodeUs),
+             10, GAME_HEIGHT - 64, 14, LIGHTGRAY);
+}
+
+void SpectatorStop(void) {
+    if (!serverRunning) return;
+    atomic_store(&stopping, 1);
+    pthread_join(thread, NULL);
+    serverRunning = 0;
+
+    SpectatorStats s;
+    SpectatorGetStats(&s);
+    TraceLog(LOG_INFO, "SPECTATOR: %ld ticks (%ld pulados), %ld pacotes (%ld inteiros), %.0f bytes por tick, %.0f por pacote, codificação %.1f us por tick",
+             s.ticks, s.skipped, s.packets, s.fullStates, s.bytesPerTick, s.bytesPerPacket, s.encodeUs);
+
+    for (int i = 0; i < SPECTATOR_MAX_CLIENTS; i++) {
+        if (clients[i].fd >= 0) CloseClient(&clients[i]);
+    }
+    close(listenFd);
+    close(wakePipe[0]);
+    close(wakePipe[1]);
+    listenFd = wakePipe[0] = wakePipe[1] = -1;
+}
+
+// ---------------------------------------------------------------------------
+// Cliente
+
+int SpectatorConnect(const char *host, int port) {
+    char service[16];
+    snprintf(service, sizeof(service), "%d", port);
+    struct addrinfo hints, *res;
+    memset(&hints, 0, sizeof(hints));
+    hints.ai_family = AF_INET;
+    hints.ai_socktype = SOCK_STREAM;
+    if (getaddrinfo(host, service, &hints, &res) != 0) return 0;
+
+    clientFd = socket(AF_INET, SOCK_STREAM, 0);
+    if (clientFd >= 0 && connect(clientFd, res->ai_addr, res->ai_addrlen) < 0) {
+        close(clientFd);
+        clientFd = -1;
+    }
+    freeaddrinfo(res);
+    if (clientFd < 0) return 0;
+
+    int one = 1;
+    setsockopt(clientFd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+    fcntl(clientFd, F_SETFL, fcntl(clientFd, F_GETFL, 0) | O_NONBLOCK);
+    recvBytes = 0;
+    framesReceived = 0;
+    for (int i = 0; i < SPECTATOR_HISTORY; i++) received[i].seq = SPECTATOR_NO_BASE;
+    TraceLog(LOG_INFO, "SPECTATOR: assistindo %s:%d", host, port);
+    return 1;
+}
+
+int SpectatorConnected(void) {
+    return clientFd >= 0;
+}
+
+// Leva os pacotes completos do buffer para o histórico e confirma cada um
+static void ReceivePackets(void) {
+    ssize_t got = -1;
+    while (clientFd >= 0 && (got = recv(clientFd, recvBuf + recvBytes, sizeof(recvBuf) - recvBytes, 0)) > 0) {
+        recvBytes += got;
+
+        int used = 0;
+        while (recvBytes - used >= 4) {
+            unsigned int length;
+            memcpy(&length, recvBuf + used, 4);
+            if (length > MAX_PACKET - 4) {
+                SpectatorDisconnect();
+                return;
+            }
+            if ((unsigned int)(recvBytes - used - 4) < length) break;
+
+            // Um pacote que não decodifica não é confirmado; o servidor
+            // continua mandando deltas da última base boa
+            if (Decode(recvBuf + used + 4, length, &decoding)) {
+                received[decoding.seq & (SPECTATOR_HISTORY - 1)] = decoding;
+                send(clientFd, &decoding.seq, 4, MSG_NOSIGNAL);
+                previous = current;
+                Dequantize(&decoding, &current);
+                currentTime = TimeNow();
+                framesReceived++;
+            }
+            used += 4 + length;
+        }
+        memmove(recvBuf, recvBuf + used, recvBytes - used);
+        recvBytes -= used;
+    }
+    if (clientFd >= 0 && (got == 0 || (errno != EAGAIN && errno != EWOULDBLOCK))) {
+        TraceLog(LOG_INFO, "SPECTATOR: transmissão encerrada");
+        SpectatorDisconnect();
+    }
+}
+
+static float Lerp(float a, float b, float t) {
+    return fabsf(b - a) > SNAP_DISTANCE ? b : a + (b - a) * t;
+}
+
+static Vector2 LerpVector(Vector2 a, Vector2 b, float t) {
+    return (Vector2){ Lerp(a.x, b.x, t), Lerp(a.y, b.y, t) };
+}
+
+int SpectatorReceive(FramePacket *out) {
+    ReceivePackets();
+    if (framesReceived == 0) return 0;
+
+    *out = current;
+    if (framesReceived < 2 || previous.phase != current.phase || previous.currentLevel != current.currentLevel) return 1;
+
+    // Desenha entre os dois últimos ticks: no máximo um tick de atraso e
+    // sem os trancos de quando dois pacotes chegam juntos
+    float t = (float)((TimeNow() - currentTime) / SIM_DT);
+    if (t > 1.0f) t = 1.0f;
+    Player *hearts[2] = { &out->player, &out->partner };
+    const Player *from[2] = { &previous.player, &previous.partner };
+    for (int i = 0; i < 2; i++) {
+        Vector2 pos = LerpVector(SimVec2ToVector2(from[i]->pos), SimVec2ToVector2(hearts[i]->pos), t);
+        hearts[i]->pos = SimVec2FromVector2(pos);
+    }
+
+    // Só interpola quando a contagem bate (mesmos índices, mesmos objetos)
+    const AttackDrawState *a = &previous.attacks;
+    AttackDrawState *b = &out->attacks;
+    for (int s = 0; s < ATK_COUNT; s++) {
+        if (a->streamStart[s] != b->streamStart[s] || a->streamStart[s + 1] != b->streamStart[s + 1]) continue;
+        for (int i = b->streamStart[s]; i < b->streamStart[s + 1]; i++) {
+            b->positions[i] = LerpVector(a->positions[i], b->positions[i], t);
+        }
+    }
+    if (previous.boss.active && out->boss.active && previous.boss.phase == out->boss.phase) {
+        out->boss.pos = LerpVector(previous.boss.pos, out->boss.pos, t);
+        for (int i = 0; i < out->boss.emitterCount; i++) {
+            out->boss.emitters[i] = LerpVector(previous.boss.emitters[i], out->boss.emitters[i], t);
+        }
+    }
+    if (a->entityCount == b->entityCount) {
+        for (int i = 0; i < b->entityCount; i++) {
+            b->entities[i].rect.x = Lerp(a->entities[i].rect.x, b->entities[i].rect.x, t);
+            b->entities[i].rect.y = Lerp(a->entities[i].rect.y, b->entities[i].rect.y, t);
+            b->entities[i].beamFrom = LerpVector(a->entities[i].beamFrom, b->entities[i].beamFrom, t);
+            b->entities[i].beamTo = LerpVector(a->entities[i].beamTo, b->entities[i].beamTo, t);
+        }
+    }
+    return 1;
+}
+
+void SpectatorDisconnect(void) {
+    if (clientFd < 0) return;
+    close(clientFd);
+    clientFd = -1;
+}
@@ -0,0 +1,45 @@
+#ifndef SPECTATOR_H
+#define SPECTATOR_H
+#include "game.h"
+
+// Transmissão para espectadores: o jogo publica o pacote de desenho de cada
+// tick e uma thread própria o quantiza (posições em 1/8 de pixel), compara
+// com o último estado que cada cliente confirmou e envia só os campos que
+// mudaram. A thread principal só copia o pacote, sem esperar ninguém.
+//
+// Pacote (TCP, inteiros na ordem da máquina):
+//   u32 tamanho | u32 seq | u32 base (SPECTATOR_NO_BASE = estado inteiro)
+//   varint campos | u8 flags | [u8 n, mensagem do HUD] | máscara de bits dos
+//   campos alterados | varint zigzag (novo - base) de cada campo alterado
+// O cliente responde com o u32 seq de cada pacote que aplicou.
+#define SPECTATOR_DEFAULT_PORT 7790
+#define SPECTATOR_MAX_CLIENTS 16
+#define SPECTATOR_HISTORY 64        // Estados guardados para servir de base (potência de 2)
+#define SPECTATOR_NO_BASE 0xFFFFFFFFu
+
+typedef struct {
+    long ticks;                     // Pacotes publicados pelo jogo e codificados
+    long skipped;                   // Publicações perdidas porque a thread estava ocupada
+    long packets;                   // Pacotes enviados (somando os clientes)
+    long fullStates;                // Dos quais sem base (cliente novo ou atrasado)
+    double bytesPerTick;            // Média por tick, somando os clientes
+    double bytesPerPacket;
+    double encodeUs;                // Média por tick (quantizar + codificar para todos)
+    int clients;
+} SpectatorStats;
+
+// Servidor (no jogo)
+int SpectatorStart(int port);
+void SpectatorPublish(const FramePacket *f);
+void SpectatorGetStats(SpectatorStats *s);
+void SpectatorDrawStats(const SpectatorStats *s);
+void SpectatorStop(void);
+
+// Cliente (--spectate): recebe, aplica os deltas e interpola entre os dois
+// últimos ticks. SpectatorReceive retorna 0 enquanto não há o que desenhar.
+int SpectatorConnect(const char *host, int port);   // 0 se ninguém está transmitindo
+int SpectatorReceive(FramePacket *out);
+int SpectatorConnected(void);
+void SpectatorDisconnect(void);
+
+#endif
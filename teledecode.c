@@ -0,0 +1,167 @@
+// Leitor da telemetria gravada com --telemetry (ver telemetry.h).
+// Uso: ./teledecode partida.htel          resumo
+//      ./teledecode --dump partida.htel   um registro por linha
+#include "telemetry.h"
+#include "attack.h"
+#include "raylib.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define TYPE_NAME(name, w, h, dmg, ox, oy, draw) #name,
+static const char *attackNames[ATK_COUNT + 1] = { ATTACK_TYPE_LIST(TYPE_NAME) "obstáculo/laser" };
+#undef TYPE_NAME
+
+static const char *eventNames[TELEMETRY_TYPE_COUNT] = { "hit", "death", "level", "frame", "dropped", "lost" };
+
+typedef struct {
+    long hits[ATK_COUNT + 1], damage[ATK_COUNT + 1];
+    long dropEvents[ATK_COUNT], dropped[ATK_COUNT];
+    long lost;
+    int *frameUs;               // Tempos de frame, para os percentis
+    long frames, frameCap;
+    double frameUsTotal, drawUs;
+    int level;                  // Nível em andamento (-1 = nenhum)
+    uint32_t levelStart;
+} Summary;
+
+static const char *AttackName(int type) {
+    return type >= 0 && type <= ATK_COUNT ? attackNames[type] : "?";
+}
+
+static void Dump(const TelemetryRecord *r) {
+    printf("%9.3f %-8s arg %3d  pos %4d,%4d  aux %5u  valor %d\n", r->timeMs / 1000.0,
+           r->type < TELEMETRY_TYPE_COUNT ? eventNames[r->type] : "?", r->arg, r->x, r->y, r->aux, r->value);
+}
+
+static void EndLevel(Summary *s, uint32_t now, const char *how) {
+    if (s->level < 0) return;
+    printf("  nível %d: %.1f s (%s)\n", s->level + 1, (now - s->levelStart) / 1000.0, how);
+    s->level = -1;
+}
+
+static void Accumulate(Summary *s, const TelemetryRecord *r) {
+    switch (r->type) {
+        case TELEMETRY_HIT:
+            if (r->arg <= ATK_COUNT) {
+                s->hits[r->arg]++;
+                s->damage[r->arg] += r->aux;
+            }
+            break;
+        case TELEMETRY_DEATH:
+            EndLevel(s, r->timeMs, "morte");
+            printf("  morte no nível %d em (%d, %d) com %d pontos, %.1f s\n", r->arg + 1, r->x, r->y, r->value, r->timeMs / 1000.0);
+            break;
+        case TELEMETRY_LEVEL_START:
+            EndLevel(s, r->timeMs, "passou");
+            s->level = r->arg;
+            s->levelStart = r->timeMs;
+            break;
+        case TELEMETRY_FRAME:
+            if (s->frames == s->frameCap) {
+                s->frameCap = s->frameCap ? s->frameCap * 2 : 4096;
+                s->frameUs = realloc(s->frameUs, s->frameCap * sizeof(int));
+            }
+            s->frameUs[s->frames++] = r->value;
+            s->frameUsTotal += r->value;
+            s->drawUs += r->aux;
+            break;
+        case TELEMETRY_SPAWN_DROPPED:
+            if (r->arg < ATK_COUNT) {
+                s->dropEvents[r->arg]++;
+                s->dropped[r->arg] += r->value;
+            }
+            break;
+        case TELEMETRY_LOST:
+            s->lost += r->value;
+            break;
+    }
+}
+
+static int CompareInts(const void *a, const void *b) {
+    int x = *(const int *)a, y = *(const int *)b;
+    return (x > y) - (x < y);
+}
+
+static void PrintSummary(Summary *s, uint32_t lastMs) {
+    EndLevel(s, lastMs, "fim da gravação");
+
+    printf("acertos por tipo:\n");
+    for (int t = 0; t <= ATK_COUNT; t++) {
+        if (s->hits[t]) printf("  %-16s %6ld acertos, %6ld de dano\n", AttackName(t), s->hits[t], s->damage[t]);
+    }
+    printf("projéteis perdidos (pool cheio):\n");
+    for (int t = 0; t < ATK_COUNT; t++) {
+        if (s->dropEvents[t]) printf("  %-16s %6ld vezes, %8ld projéteis\n", AttackName(t), s->dropEvents[t], s->dropped[t]);
+    }
+    if (s->frames > 0) {
+        qsort(s->frameUs, s->frames, sizeof(int), CompareInts);
+        printf("frames: %ld, trabalho médio %.0f us (desenho %.0f us), p50 %d us, p99 %d us, máximo %d us\n",
+               s->frames, s->frameUsTotal / s->frames, s->drawUs / s->frames, s->frameUs[s->frames / 2],
+               s->frameUs[s->frames * 99 / 100], s->frameUs[s->frames - 1]);
+    }
+    printf("registros descartados pela telemetria: %ld\n", s->lost);
+}
+
+int main(int argc, char **argv) {
+    int dump = argc == 3 && strcmp(argv[1], "--dump") == 0;
+    if (argc != 2 && !dump) {
+        fprintf(stderr, "uso: %s [--dump] <arquivo.htel>\n", argv[0]);
+        return 1;
+    }
+    const char *path = argv[argc - 1];
+    FILE *f = fopen(path, "rb");
+    if (!f) {
+        perror(path);
+        return 1;
+    }
+
+    char magic[4];
+    uint32_t header[2];
+    if (fread(magic, 1, 4, f) != 4 || memcmp(magic, TELEMETRY_MAGIC, 4) != 0 || fread(header, sizeof(header), 1, f) != 1 ||
+        header[0] != TELEMETRY_VERSION || header[1] != sizeof(TelemetryRecord)) {
+        fprintf(stderr, "%s: não é telemetria da versão %d\n", path, TELEMETRY_VERSION);
+        fclose(f);
+        return 1;
+    }
+
+    Summary s;
+    memset(&s, 0, sizeof(s));
+    s.level = -1;
+    long blocks = 0, records = 0;
+    uint32_t lastMs = 0;
+    uint32_t block[2];
+    if (!dump) printf("níveis e mortes:\n");
+    while (fread(block, sizeof(block), 1, f) == 1) {
+        unsigned char *compressed = malloc(block[1]);
+        if (!compressed || fread(compressed, 1, block[1], f) != block[1]) {
+            fprintf(stderr, "%s: bloco %ld cortado\n", path, blocks);
+            free(compressed);
+            break;
+        }
+        int size = 0;
+        TelemetryRecord *r = (TelemetryRecord *)DecompressData(compressed, (int)block[1], &size);
+        free(compressed);
+        if (!r || size != (int)(block[0] * sizeof(TelemetryRecord))) {
+            fprintf(stderr, "%s: bloco %ld inválido\n", path, blocks);
+            MemFree(r);
+            break;
+        }
+        for (uint32_t i = 0; i < block[0]; i++) {
+            if (dump) Dump(&r[i]);
+            else Accumulate(&s, &r[i]);
+            if (r[i].timeMs > lastMs) lastMs = r[i].timeMs;
+        }
+        MemFree(r);
+        blocks++;
+        records += block[0];
+    }
+    fclose(f);
+
+    if (!dump) {
+        PrintSummary(&s, lastMs);
+        printf("%s: %ld registros em %ld blocos, %.1f s\n", path, records, blocks, lastMs / 1000.0);
+    }
+    free(s.frameUs);
+    return 0;
+}
@@ -0,0 +1,150 @@
+#define _POSIX_C_SOURCE 200809L
+#include "telemetry.h"
+#include "raylib.h"
+#include "utils.h"
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <time.h>
+
+#define RING_MASK (TELEMETRY_RING_SIZE - 1)
+#define NO_RING -1
+#define RING_DENIED -2          // Mais threads que anéis: essa thread só descarta
+
+_Static_assert(sizeof(TelemetryRecord) == 16, "registro de telemetria com preenchimento");
+_Static_assert((TELEMETRY_RING_SIZE & RING_MASK) == 0, "TELEMETRY_RING_SIZE precisa ser potência de 2");
+
+// Anel de uma thread: ela escreve em head, a thread de fundo lê em tail
+typedef struct {
+    TelemetryRecord records[TELEMETRY_RING_SIZE];
+    atomic_uint head, tail;
+    atomic_long dropped;
+} TelemetryRing;
+
+static TelemetryRing rings[TELEMETRY_MAX_THREADS];
+static atomic_int ringCount;
+static atomic_long deniedDropped;       // Registros de threads sem anel
+static _Thread_local int ownRing = NO_RING;
+static _Thread_local int muted;
+
+static atomic_int active, stopping;
+static double startTime;
+static FILE *file;
+static pthread_t flusher;
+
+// Só a thread de fundo mexe daqui para baixo
+static TelemetryRecord batch[TELEMETRY_MAX_THREADS * TELEMETRY_RING_SIZE + 1];
+static long droppedSeen, recordsWritten, blocksWritten, bytesWritten;
+
+static int ClaimRing(void) {
+    int index = atomic_fetch_add(&ringCount, 1);
+    if (index < TELEMETRY_MAX_THREADS) return index;
+    atomic_fetch_sub(&ringCount, 1);
+    return RING_DENIED;
+}
+
+void TelemetryEmit(TelemetryType type, int arg, int x, int y, int aux, int value) {
+    if (!atomic_load_explicit(&active, memory_order_relaxed) || muted) return;
+    if (ownRing == NO_RING) ownRing = ClaimRing();
+    if (ownRing == RING_DENIED) {
+        atomic_fetch_add_explicit(&deniedDropped, 1, memory_order_relaxed);
+        return;
+    }
+
+    TelemetryRing *ring = &rings[ownRing];
+    unsigned int head = atomic_load_explicit(&ring->head, memory_order_relaxed);
+    unsigned int tail = atomic_load_explicit(&ring->tail, memory_order_acquire);
+    if (head - tail >= TELEMETRY_RING_SIZE) {
+        atomic_fetch_add_explicit(&ring->dropped, 1, memory_order_relaxed);
+        return;
+    }
+    ring->records[head & RING_MASK] = (TelemetryRecord){
+        (uint32_t)((TimeNow() - startTime) * 1000.0), (uint8_t)type, (uint8_t)arg,
+        (int16_t)x, (int16_t)y, (uint16_t)(aux > 0xFFFF ? 0xFFFF : aux), (int32_t)value
+    };
+    atomic_store_explicit(&ring->head, head + 1, memory_order_release);
+}
+
+void TelemetryMute(int mute) {
+    muted = mute;
+}
+
+// Esvazia os anéis num lote, comprime e grava um bloco
+static void FlushBatch(void) {
+    int count = 0;
+    long dropped = atomic_load(&deniedDropped);
+    int inUse = atomic_load(&ringCount);
+    for (int r = 0; r < inUse; r++) {
+        TelemetryRing *ring = &rings[r];
+        unsigned int tail = atomic_load_explicit(&ring->tail, memory_order_relaxed);
+        unsigned int head = atomic_load_explicit(&ring->head, memory_order_acquire);
+        for (; tail != head; tail++) batch[count++] = ring->records[tail & RING_MASK];
+        atomic_store_explicit(&ring->tail, tail, memory_order_release);
+        dropped += atomic_load_explicit(&ring->dropped, memory_order_relaxed);
+    }
+
+    // Descartes desde o último bloco viram um registro
+    if (dropped != droppedSeen) {
+        batch[count++] = (TelemetryRecord){ (uint32_t)((TimeNow() - startTime) * 1000.0), TELEMETRY_LOST, 0, 0, 0, 0,
+                                            (int32_t)(dropped - droppedSeen) };
+        droppedSeen = dropped;
+    }
+    if (count == 0) return;
+
+    int compressedSize = 0;
+    unsigned char *compressed = CompressData((const unsigned char *)batch, count * (int)sizeof(TelemetryRecord), &compressedSize);
+    if (!compressed) return;
+    uint32_t header[2] = { (uint32_t)count, (uint32_t)compressedSize };
+    fwrite(header, sizeof(header), 1, file);
+    fwrite(compressed, 1, compressedSize, file);
+    MemFree(compressed);
+    recordsWritten += count;
+    blocksWritten++;
+    bytesWritten += sizeof(header) + compressedSize;
+}
+
+static void *TelemetryThread(void *arg) {
+    (void)arg;
+    struct timespec wait = { 0, TELEMETRY_FLUSH_MS * 1000000L };
+    while (!atomic_load(&stopping)) {
+        nanosleep(&wait, NULL);
+        FlushBatch();
+    }
+    return NULL;
+}
+
+int TelemetryStart(const char *path) {
+    file = fopen(path, "wb");
+    if (!file) {
+        TraceLog(LOG_WARNING, "TELEMETRY: não foi possível criar %s", path);
+        return 0;
+    }
+    uint32_t header[2] = { TELEMETRY_VERSION, sizeof(TelemetryRecord) };
+    fwrite(TELEMETRY_MAGIC, 1, 4, file);
+    fwrite(header, sizeof(header), 1, file);
+
+    startTime = TimeNow();
+    atomic_store(&stopping, 0);
+    if (pthread_create(&flusher, NULL, TelemetryThread, NULL) != 0) {
+        fclose(file);
+        file = NULL;
+        return 0;
+    }
+    atomic_store(&active, 1);
+    TraceLog(LOG_INFO, "TELEMETRY: gravando em %s", path);
+    return 1;
+}
+
+void TelemetryStop(void) {
+    if (!file) return;
+    atomic_store(&active, 0);
+    atomic_store(&stopping, 1);
+    pthread_join(flusher, NULL);
+    FlushBatch();
+    fclose(file);
+    file = NULL;
+
+    long raw = recordsWritten * (long)sizeof(TelemetryRecord);
+    TraceLog(LOG_INFO, "TELEMETRY: %ld registros em %ld blocos, %ld bytes (%.1fx), %ld descartados",
+             recordsWritten, blocksWritten, bytesWritten, bytesWritten > 0 ? (double)raw / bytesWritten : 0.0, droppedSeen);
+}
@@ -0,0 +1,44 @@
+#ifndef TELEMETRY_H
+#define TELEMETRY_H
+#include <stdint.h>
+
+// Telemetria de jogo e de desempenho (--telemetry ARQUIVO): registros de
+// tamanho fixo vão para um anel sem trava da thread que os gerou (um
+// produtor, um consumidor), e uma thread de fundo junta os anéis em lotes,
+// comprime e grava. Quem emite nunca espera: com o anel cheio o registro é
+// descartado e contado. Sem TelemetryStart, TelemetryEmit só testa um flag.
+//
+// Arquivo: "HTEL" | u32 versão | u32 tamanho do registro, e então blocos
+// u32 registros | u32 bytes comprimidos | DEFLATE (CompressData da raylib).
+// teledecode.c lê o arquivo de volta.
+#define TELEMETRY_MAGIC "HTEL"
+#define TELEMETRY_VERSION 1
+#define TELEMETRY_RING_SIZE 4096        // Registros por thread (potência de 2)
+#define TELEMETRY_MAX_THREADS 8
+#define TELEMETRY_FLUSH_MS 250
+
+typedef enum {
+    TELEMETRY_HIT,              // arg = AttackType (ATK_COUNT = obstáculo ou laser), aux = dano, value = vida que sobrou
+    TELEMETRY_DEATH,            // arg = nível, value = pontuação
+    TELEMETRY_LEVEL_START,      // arg = nível, value = pontuação
+    TELEMETRY_FRAME,            // arg = nível de qualidade, aux = desenho em us, value = frame em us
+    TELEMETRY_SPAWN_DROPPED,    // arg = AttackType, aux = limite do pool, value = projéteis perdidos
+    TELEMETRY_LOST,             // Gravado pela thread de fundo: value = registros descartados
+    TELEMETRY_TYPE_COUNT
+} TelemetryType;
+
+typedef struct {
+    uint32_t timeMs;            // Desde TelemetryStart
+    uint8_t type;               // TelemetryType
+    uint8_t arg;
+    int16_t x, y;               // Posição em pixels (coração), se houver
+    uint16_t aux;               // Satura em 65535
+    int32_t value;
+} TelemetryRecord;
+
+int TelemetryStart(const char *path);
+void TelemetryEmit(TelemetryType type, int arg, int x, int y, int aux, int value);
+void TelemetryMute(int muted);      // Só nesta thread (fantasma e ressimulação da rede)
+void TelemetryStop(void);           // Grava o que falta e fecha
+
+#endif
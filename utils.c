@@ -1,12 +1,174 @@
+#define _POSIX_C_SOURCE 200809L
 #include "utils.h"
 #include <stdlib.h>
+#include <time.h>
 
 
 void TimerStart(Timer *t, int frames) { t->frames = frames; t->active = 1; }
 int TimerTick(Timer *t) { if (!t->active) return 0; if (--t->frames <= 0) { t->active = 0; return 1; } return 0; }
 
+static int EventBefore(ScheduledEvent a, ScheduledEvent b) {
+    return a.frame < b.frame || (a.frame == b.frame && a.type < b.type);
+}
+
+void EventQueueClear(EventQueue *q) { q->count = 0; }
+
+// Agenda um evento para o frame indicado (0 se a fila estiver cheia)
+int EventQueuePush(EventQueue *q, int frame, int type) {
+    if (q->count >= MAX_SCHEDULED_EVENTS) return 0;
+    int i = q->count++;
+    ScheduledEvent ev = { frame, type };
+    while (i > 0 && EventBefore(ev, q->heap[(i - 1) / 2])) {
+        q->heap[i] = q->heap[(i - 1) / 2];
+        i = (i - 1) / 2;
+    }
+    q->heap[i] = ev;
+    return 1;
+}
+
+// Retira o próximo evento com frame <= now (0 se nenhum estiver vencido)
+int EventQueuePop(EventQueue *q, int now, ScheduledEvent *out) {
+    if (q->count == 0 || q->heap[0].frame > now) return 0;
+    *out = q->heap[0];
+    ScheduledEvent last = q->heap[--q->count];
+    int i = 0;
+    for (;;) {
+        int child = 2 * i + 1;
+        if (child >= q->count) break;
+        if (child + 1 < q->count && EventBefore(q->heap[child + 1], q->heap[child])) child++;
+        if (!EventBefore(q->heap[child], last)) break;
+        q->heap[i] = q->heap[child];
+        i = child;
+    }
+    q->heap[i] = last;
+    return 1;
+}
+
+void TimerWheelInit(TimerWheel *w) {
+    w->now = 0;
+    w->active = 0;
+    for (int i = 0; i < TIMER_WHEEL_SLOTS + TIMER_WHEEL_OUTER_SLOTS; i++) w->heads[i] = -1;
+    for (int i = 0; i < TIMER_WHEEL_CAPACITY; i++) {
+        w->nodes[i].list = -1;
+        w->nodes[i].next = (short)(i + 1 < TIMER_WHEEL_CAPACITY ? i + 1 : -1);
+    }
+    w->freeHead = 0;
+}
+
+// Coloca o nó no slot certo de acordo com a distância até o disparo
+static void TimerWheelLink(TimerWheel *w, int n) {
+    TimerNode *node = &w->nodes[n];
+    int delta = node->expire - w->now;
+    int list;
+    if (delta < TIMER_WHEEL_SLOTS) {
+        list = node->expire & (TIMER_WHEEL_SLOTS - 1);
+    } else if (delta < TIMER_WHEEL_SLOTS * TIMER_WHEEL_OUTER_SLOTS) {
+        list = TIMER_WHEEL_SLOTS + ((node->expire >> TIMER_WHEEL_BITS) & (TIMER_WHEEL_OUTER_SLOTS - 1));
+    } else {
+        // Prazo além do alcance: último slot externo, reavaliado na cascata
+        list = TIMER_WHEEL_SLOTS + (((w->now >> TIMER_WHEEL_BITS) + TIMER_WHEEL_OUTER_SLOTS - 1) & (TIMER_WHEEL_OUTER_SLOTS - 1));
+    }
+    node->list = (short)list;
+    node->prev = -1;
+    node->next = w->heads[list];
+    if (node->next >= 0) w->nodes[node->next].prev = (short)n;
+    w->heads[list] = (short)n;
+}
+
+static void TimerWheelUnlink(TimerWheel *w, int n) {
+    TimerNode *node = &w->nodes[n];
+    if (node->prev >= 0) w->nodes[node->prev].next = node->next;
+    else w->heads[node->list] = node->next;
+    if (node->next >= 0) w->nodes[node->next].prev = node->prev;
+}
+
+// Agenda um disparo daqui a "delay" ticks (mínimo 1); devolve o handle ou -1
+int TimerWheelSchedule(TimerWheel *w, int delay, int data) {
+    if (w->freeHead < 0) return -1;
+    int n = w->freeHead;
+    w->freeHead = w->nodes[n].next;
+    w->nodes[n].expire = w->now + (delay < 1 ? 1 : delay);
+    w->nodes[n].data = data;
+    TimerWheelLink(w, n);
+    w->active++;
+    return n;
+}
+
+void TimerWheelCancel(TimerWheel *w, int handle) {
+    if (handle < 0 || w->nodes[handle].list < 0) return;
+    TimerWheelUnlink(w, handle);
+    w->nodes[handle].list = -1;
+    w->nodes[handle].next = w->freeHead;
+    w->freeHead = (short)handle;
+    w->active--;
+}
+
+// Ticks que faltam para o disparo (0 se o handle não estiver ativo)
+int TimerWheelRemaining(const TimerWheel *w, int handle) {
+    if (handle < 0 || w->nodes[handle].list < 0) return 0;
+    return w->nodes[handle].expire - w->now;
+}
+
+// Avança um tick e chama fn para cada timer vencido. O callback pode agendar
+// e cancelar timers à vontade.
+void TimerWheelAdvance(TimerWheel *w, TimerWheelFn fn, void *ctx) {
+    w->now++;
+    int slot = w->now & (TIMER_WHEEL_SLOTS - 1);
+    
+    // Início de uma volta: descer os timers do slot externo correspondente
+    if (slot == 0) {
+        int outer = TIMER_WHEEL_SLOTS + ((w->now >> TIMER_WHEEL_BITS) & (TIMER_WHEEL_OUTER_SLOTS - 1));
+        int n = w->heads[outer];
+        w->heads[outer] = -1;
+        while (n >= 0) {
+            int next = w->nodes[n].next;
+            TimerWheelLink(w, n);
+            n = next;
+        }
+    }
+    
+    // Todo nó do slot atual vence agora. Retira sempre a cabeça da lista, assim
+    // o callback pode cancelar outros timers do mesmo slot com segurança.
+    while (w->heads[slot] >= 0) {
+        int n = w->heads[slot];
+        int data = w->nodes[n].data;
+        TimerWheelCancel(w, n);
+        fn(ctx, data);
+    }
+}
+
 int RandRange(int min, int max) { return min + rand() % (max-min+1); }
 
+unsigned int RandNext(unsigned int *state) {
+    unsigned int x = *state;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    *state = x;
+    return x;
+}
+
+unsigned int HashBytes(unsigned int hash, const void *data, int size) {
+    const unsigned char *bytes = data;
+    for (int i = 0; i < size; i++) {
+        hash ^= bytes[i];
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
 int RectsOverlap(Rectangle a, Rectangle b) {
     return (a.x < b.x + b.width && a.x + a.width > b.x && a.y < b.y + b.height && a.y + a.height > b.y);
 }
+
+double TimeNow(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+double ThreadCpuNow(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
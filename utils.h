@@ -7,10 +7,67 @@ typedef struct { int frames, active; } Timer;
 void TimerStart(Timer *t, int frames);
 int TimerTick(Timer *t);
 
+// Fila de eventos agendados por frame (heap mínimo; empate desempata pelo tipo)
+#define MAX_SCHEDULED_EVENTS 32
+typedef struct { int frame, type; } ScheduledEvent;
+typedef struct {
+    ScheduledEvent heap[MAX_SCHEDULED_EVENTS];
+    int count;
+} EventQueue;
+void EventQueueClear(EventQueue *q);
+int EventQueuePush(EventQueue *q, int frame, int type);
+int EventQueuePop(EventQueue *q, int now, ScheduledEvent *out);
+
+// Roda de temporização hierárquica: agendar, cancelar e disparar custam O(1),
+// e timers parados não custam nada por tick. O nível interno tem um slot por
+// tick (256 ticks); o externo tem um slot por volta do interno (64 voltas).
+// Prazos mais longos ficam no último slot externo e são reavaliados.
+#define TIMER_WHEEL_BITS 8
+#define TIMER_WHEEL_SLOTS (1 << TIMER_WHEEL_BITS)
+#define TIMER_WHEEL_OUTER_SLOTS 64
+#ifndef TIMER_WHEEL_CAPACITY
+#define TIMER_WHEEL_CAPACITY 1024
+#endif
+
+typedef struct {
+    int expire;        // Tick absoluto de disparo
+    int data;          // Valor devolvido ao disparar
+    short next, prev;  // Lista duplamente ligada do slot (-1 = fim)
+    short list;        // Slot onde está (-1 = nó livre)
+} TimerNode;
+
+typedef struct {
+    int now;
+    short heads[TIMER_WHEEL_SLOTS + TIMER_WHEEL_OUTER_SLOTS];
+    TimerNode nodes[TIMER_WHEEL_CAPACITY];
+    short freeHead;
+    int active;
+} TimerWheel;
+
+typedef void (*TimerWheelFn)(void *ctx, int data);
+void TimerWheelInit(TimerWheel *w);
+int TimerWheelSchedule(TimerWheel *w, int delay, int data);
+void TimerWheelCancel(TimerWheel *w, int handle);
+int TimerWheelRemaining(const TimerWheel *w, int handle);
+void TimerWheelAdvance(TimerWheel *w, TimerWheelFn fn, void *ctx);
+
 // Random helper
 int RandRange(int min, int max);
+// Gerador pseudoaleatório com estado explícito (xorshift32): o estado vive
+// na partida, então snapshots e reinícios repetem a mesma sequência
+#define RAND_DEFAULT_SEED 0x2545F491u
+unsigned int RandNext(unsigned int *state);
+
+// Hash FNV-1a para comparar estados (não é criptográfico)
+#define HASH_SEED 2166136261u
+unsigned int HashBytes(unsigned int hash, const void *data, int size);
 
 // Colisão
 int RectsOverlap(Rectangle a, Rectangle b);
 
+// Relógio monotônico em segundos (independe da janela; seguro em qualquer thread)
+double TimeNow(void);
+// Tempo de CPU gasto pela thread que chama, em segundos (não conta preempção)
+double ThreadCpuNow(void);
+
 #endif